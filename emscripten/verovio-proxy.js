@@ -15,12 +15,18 @@ verovio.vrvToolkit.destructor = Module.cwrap('vrvToolkit_destructor', null, ['nu
 // bool edit(Toolkit *ic, const char *editorAction) 
 verovio.vrvToolkit.edit = Module.cwrap('vrvToolkit_edit', 'number', ['number', 'string']);
 
+// char *getEditInfo(Toolkit *ic)
+verovio.vrvToolkit.getEditInfo = Module.cwrap('vrvToolkit_getEditInfo', 'string', ['number']);
+
 // char *getElementsAtTime(Toolkit *ic, int time )
 verovio.vrvToolkit.getElementsAtTime = Module.cwrap('vrvToolkit_getElementsAtTime', 'string', ['number', 'number']);
 
 // char *getElementAttr(Toolkit *ic, const char *xmlId )
 verovio.vrvToolkit.getElementAttr = Module.cwrap('vrvToolkit_getElementAttr', 'string', ['number', 'string']);
 
+// char *getLayoutBreaks(Toolkit *ic, const char *pageWidths)
+verovio.vrvToolkit.getLayoutBreaks = Module.cwrap('vrvToolkit_getLayoutBreaks', 'string', ['number', 'string']);
+
 // char *getLog(Toolkit *ic)
 verovio.vrvToolkit.getLog = Module.cwrap('vrvToolkit_getLog', 'string', ['number']);
 
@@ -30,6 +36,9 @@ verovio.vrvToolkit.getMEI = Module.cwrap('vrvToolkit_getMEI', 'string', ['number
 // char *getHumdrum(Toolkit *ic)
 verovio.vrvToolkit.getHumdrum = Module.cwrap('vrvToolkit_getHumdrum', 'string');
 
+// char *getProfileReport(Toolkit *ic)
+verovio.vrvToolkit.getProfileReport = Module.cwrap('vrvToolkit_getProfileReport', 'string', ['number']);
+
 // int getPageCount(Toolkit *ic)
 verovio.vrvToolkit.getPageCount = Module.cwrap('vrvToolkit_getPageCount', 'number', ['number']);
 
@@ -57,9 +66,21 @@ verovio.vrvToolkit.renderData = Module.cwrap('vrvToolkit_renderData', 'string',
 // char *renderPage(Toolkit *ic, int pageNo, const char *rendering_options )
 verovio.vrvToolkit.renderPage = Module.cwrap('vrvToolkit_renderPage', 'string', ['number', 'number', 'string']);
 
+// char *renderPageRange(Toolkit *ic, int pageNo, int x1, int x2, const char *rendering_options )
+verovio.vrvToolkit.renderPageRange = Module.cwrap('vrvToolkit_renderPageRange', 'string', ['number', 'number', 'number', 'number', 'string']);
+
+// char *renderMeasures(Toolkit *ic, const char *startId, const char *endId, const char *rendering_options )
+verovio.vrvToolkit.renderMeasures = Module.cwrap('vrvToolkit_renderMeasures', 'string', ['number', 'string', 'string', 'string']);
+
 // char *renderToMidi(Toolkit *ic, const char *rendering_options )
 verovio.vrvToolkit.renderToMidi = Module.cwrap('vrvToolkit_renderToMidi', 'string', ['number', 'string']);
 
+// char *renderToMidiData(Toolkit *ic, const char *rendering_options )
+verovio.vrvToolkit.renderToMidiData = Module.cwrap('vrvToolkit_renderToMidiData', 'number', ['number', 'string']);
+
+// size_t getResultLength(Toolkit *ic)
+verovio.vrvToolkit.getResultLength = Module.cwrap('vrvToolkit_getResultLength', 'number', ['number']);
+
 // void setOptions(Toolkit *ic, const char *options) 
 verovio.vrvToolkit.setOptions = Module.cwrap('vrvToolkit_setOptions', null, ['number', 'string']);
 
@@ -96,10 +117,18 @@ verovio.toolkit.prototype.edit = function (editorAction) {
 	
 };
 
+verovio.toolkit.prototype.getEditInfo = function () {
+	return JSON.parse(verovio.vrvToolkit.getEditInfo(this.ptr));
+};
+
 verovio.toolkit.prototype.getElementsAtTime = function (millisec) {
 	return JSON.parse(verovio.vrvToolkit.getElementsAtTime(this.ptr, millisec));
 };
 
+verovio.toolkit.prototype.getLayoutBreaks = function (pageWidths) {
+	return JSON.parse(verovio.vrvToolkit.getLayoutBreaks(this.ptr, JSON.stringify(pageWidths)));
+};
+
 verovio.toolkit.prototype.getLog = function () {
 	return verovio.vrvToolkit.getLog(this.ptr);
 };
@@ -112,6 +141,10 @@ verovio.toolkit.prototype.getHumdrum = function () {
 	return verovio.vrvToolkit.getHumdrum(this.ptr);
 };
 
+verovio.toolkit.prototype.getProfileReport = function () {
+	return JSON.parse(verovio.vrvToolkit.getProfileReport(this.ptr));
+};
+
 verovio.toolkit.prototype.getPageCount = function () {
 	return verovio.vrvToolkit.getPageCount(this.ptr);
 };
@@ -156,6 +189,14 @@ verovio.toolkit.prototype.renderPage = function (pageNo, options) {
 	return verovio.vrvToolkit.renderPage(this.ptr, pageNo, JSON.stringify(options));
 };
 
+verovio.toolkit.prototype.renderPageRange = function (pageNo, x1, x2, options) {
+	return verovio.vrvToolkit.renderPageRange(this.ptr, pageNo, x1, x2, JSON.stringify(options));
+};
+
+verovio.toolkit.prototype.renderMeasures = function (startId, endId, options) {
+	return verovio.vrvToolkit.renderMeasures(this.ptr, startId, endId, JSON.stringify(options));
+};
+
 verovio.toolkit.prototype.renderToMidi = function (options) {
 	if (typeof options === 'string') {
 		console.warn("DEPRECATION WARNING: Passing a String to renderToMidi will be removed in next version of Verovio. Pass a JSON Object instead.");
@@ -164,6 +205,13 @@ verovio.toolkit.prototype.renderToMidi = function (options) {
 	return verovio.vrvToolkit.renderToMidi(this.ptr, JSON.stringify(options));
 };
 
+verovio.toolkit.prototype.renderToMidiData = function (options) {
+	// the raw MIDI bytes are copied out of the toolkit buffer without going through base64
+	var ptr = verovio.vrvToolkit.renderToMidiData(this.ptr, JSON.stringify(options));
+	var length = verovio.vrvToolkit.getResultLength(this.ptr);
+	return Module.HEAPU8.slice(ptr, ptr + length);
+};
+
 verovio.toolkit.prototype.setOptions = function (options) {
 	if (typeof options === 'string') {
 		console.warn("DEPRECATION WARNING: Passing a String to setOptions will be removed in next version of Verovio. Pass a JSON Object instead.");
@@ -49,6 +49,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <iostream>
 #include <locale>
 #include <map>
+#include <mutex>
 #include <regex>
 #include <set>
 #include <sstream>
@@ -105,14 +106,25 @@ class HumParameter : public string {
 		HumdrumToken* origin;
 };
 
-typedef map<string, map<string, map<string, HumParameter> > > MapNNKV;
-typedef map<string, map<string, HumParameter> > MapNKV;
-typedef map<string, HumParameter> MapKV;
+// A parameter stored in a HumHash: the namespaces and key point to interned
+// strings (see HumHash::internKey), which are shared by all of the entries
+// and never move, so they can be read without locking.
+class HumHashEntry {
+	public:
+		const string* ns1;
+		const string* ns2;
+		const string* key;
+		HumParameter  value;
+};
+
+typedef vector<HumHashEntry> HumHashEntries;
 
 class HumHash {
 	public:
 		               HumHash             (void);
+		               HumHash             (const HumHash& hash);
 		              ~HumHash             ();
+		HumHash&       operator=           (const HumHash& hash);
 
 		string         getValue            (const string& key) const;
 		string         getValue            (const string& ns2,
@@ -234,10 +246,23 @@ class HumHash {
 	protected:
 		void           initializeParameters(void);
 		vector<string> getKeyList          (const string& keys) const;
+		HumParameter*  findParameter       (const string& ns1,
+		                                    const string& ns2,
+		                                    const string& key) const;
+		void           setParameter        (const string& ns1,
+		                                    const string& ns2,
+		                                    const string& key,
+		                                    const string& value);
+		vector<const HumHashEntry*> getSortedEntries(void) const;
+
+		static const string* internKey     (const string& key);
 
 	private:
-		MapNNKV* parameters;
-		string   prefix;
+		HumHashEntries* parameters;
+		string          prefix;
+
+		static set<string> keyset;
+		static std::mutex  keymutex;
 
 	friend ostream& operator<<(ostream& out, const HumHash& hash);
 };
@@ -8,6 +8,10 @@
 #ifndef __VRV_ATT_COMPARISON_H__
 #define __VRV_ATT_COMPARISON_H__
 
+#include <set>
+
+//----------------------------------------------------------------------------
+
 #include "artic.h"
 #include "atts_shared.h"
 #include "durationinterface.h"
@@ -241,6 +245,31 @@ private:
     double m_time;
 };
 
+//----------------------------------------------------------------------------
+// IsInListComparison
+//----------------------------------------------------------------------------
+
+/**
+ * This class evaluates if the object is of a certain ClassId and is one of the objects of a list.
+ */
+class IsInListComparison : public AttComparison {
+
+public:
+    IsInListComparison(ClassId AttClassId, const ArrayOfObjects &objects) : AttComparison(AttClassId)
+    {
+        m_objects.insert(objects.begin(), objects.end());
+    }
+
+    virtual bool operator()(Object *object)
+    {
+        if (!MatchesType(object)) return false;
+        return (m_objects.count(object) > 0);
+    }
+
+private:
+    std::set<Object *> m_objects;
+};
+
 } // namespace vrv
 
 #endif
@@ -32,8 +32,8 @@ class Object;
  * The drawing primitives do not draw anything but update the bounding box values of the
  * layout objects currently drawn. The layout objects store their own bounding box and a
  * bounding box of their content. The own bouding box is updated only for the object being
- * drawn (the top one on the stack). The content bounding box is updated for all objects
- * on the stack
+ * drawn (the top one on the stack). The content bounding box is accumulated for the top object
+ * and merged into the object and into its parent on the stack when the graphic ends.
  */
 class BBoxDeviceContext : public DeviceContext {
 public:
@@ -149,12 +149,29 @@ private:
      */
     std::vector<Object *> m_objects;
 
+    /**
+     * The content bounding box accumulated in logical coordinates for each object in m_objects.
+     * Values are (-)VRV_UNSET when nothing was drawn.
+     */
+    struct ContentBB {
+        int m_x1, m_x2, m_y1, m_y2;
+    };
+    std::vector<ContentBB> m_contentBBs;
+
     /**
      * The view are calling from - used to flip back the Y coordinates
      */
     View *m_view;
 
     void UpdateBB(int x1, int y1, int x2, int y2, wchar_t glyph = 0);
+
+    /**
+     * @name Push a new content bounding box, or pop the top one and merge it into its object and into the parent one.
+     */
+    ///@{
+    void PushContentBB();
+    void PopContentBB();
+    ///@}
 };
 
 } // namespace vrv
@@ -167,10 +167,18 @@ public:
     static Point CalcPositionAfterRotation(Point point, float rot_alpha, Point center);
 
     /**
-     * Calculate the position of a point after a rotation of rot_alpha around the center
+     * Calculate the y position of a bezier at the x position.
+     * The x position is mapped linearly to the parameter of the curve, which is evaluated with De Casteljau.
+     * No state is shared between calls, so it can be used from several threads.
      */
     static int CalcBezierAtPosition(const Point bezier[4], int x);
 
+    /**
+     * Calculate the y positions of a bezier at count x positions, with the coefficients of the curve calculated once.
+     * The result for each is the same as with CalcBezierAtPosition. The xs and ys can be the same array.
+     */
+    static void CalcBezierAtPositions(const Point bezier[4], const int *xs, int *ys, int count);
+
     /**
      * Calculate the position of the bezier above and below for a thick bezier
      */
@@ -178,7 +186,9 @@ public:
         const Point bezier[4], int thickness, float angle, Point *topBezier, Point *bottomBezier);
 
     /**
-     * Approximate the bounding box of a bezier taking into accound the height and the width.
+     * Calculate the bounding box of a bezier taking into accound the height and the width.
+     * The extrema are calculated exactly from the roots of the derivative of the curve.
+     * The minYPos and maxYPos are the horizontal distance from the start of the extrema in y.
      */
     static void ApproximateBezierBoundingBox(
         const Point bezier[4], Point &pos, int &width, int &height, int &minYPos, int &maxYPos);
@@ -216,6 +226,12 @@ private:
      */
     bool GetGlyph1PointRectangles(const SMuFLGlyphAnchor &anchor, Glyph *glyph, Point rect[2][2], Doc *doc) const;
 
+    /**
+     * Calculate the roots of the derivative of a cubic bezier coordinate within the curve (0 < t < 1).
+     * Return the number of roots (0 to 2).
+     */
+    static int CalcBezierDerivativeRoots(int p0, int p1, int p2, int p3, double roots[2]);
+
 public:
     //
 protected:
@@ -255,11 +271,58 @@ private:
      * The font size for the smufl glyph used for calculating the bounding box rectangles.
      */
     int m_smuflGlyphFontSize;
+};
+
+//----------------------------------------------------------------------------
+// HorizontalContentExtents
+//----------------------------------------------------------------------------
 
+/**
+ * This class stores the horizontal content extents of a list of bounding boxes in two contiguous arrays.
+ * It is used for looking for the boxes overlapping a given one without going through the BoundingBox of each of them.
+ * The positions are read when the boxes are added and are not updated if the boxes move afterwards.
+ */
+class HorizontalContentExtents {
+public:
     /**
-     * Buffer for De-Casteljau algorithm
+     * @name Constructors, destructors, and other standard methods
      */
-    static int s_deCasteljau[4][4];
+    ///@{
+    HorizontalContentExtents() {}
+    virtual ~HorizontalContentExtents() {}
+    void Clear();
+    ///@}
+
+    /**
+     * @name Add one box or a list of boxes, in the order of the list.
+     * A box without content bounding box is added as one never overlapping.
+     */
+    ///@{
+    void Add(const BoundingBox *box);
+    void Add(const std::vector<BoundingBox *> &boxes);
+    ///@}
+
+    int GetCount() const { return (int)m_lefts.size(); }
+
+    /**
+     * Return the index of the first box from the start index that overlaps horizontally with the given one, or
+     * GetCount() if there is none.
+     * This gives the same result as box->HorizontalContentOverlap() called on each of them.
+     */
+    int FindHorizontalContentOverlap(const BoundingBox *box, int start = 0, int margin = 0) const;
+
+private:
+    //
+public:
+    //
+private:
+    /**
+     * The left and right positions of the content bounding boxes
+     */
+    ///@{
+    std::vector<int> m_lefts;
+    std::vector<int> m_rights;
+    ///@}
 };
 
 } // namespace vrv
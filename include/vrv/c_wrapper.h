@@ -0,0 +1,97 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        c_wrapper.h
+// Author:      Rodolfo Zitellini
+// Created:     05/11/2013
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VRV_C_WRAPPER_H__
+#define __VRV_C_WRAPPER_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+//----------------------------------------------------------------------------
+// C interface of the Toolkit
+//----------------------------------------------------------------------------
+
+/**
+ * The functions for using the Toolkit class from C, i.e., from js (Emscripten) or from any other FFI host.
+ * The toolkit is passed as an opaque pointer created by vrvToolkit_constructor.
+ * The strings returned are owned by the toolkit and remain valid until the next call returning a string (see
+ * Toolkit::SetCString). vrvToolkit_getResultLength gives the size of the last one, which can contain null bytes.
+ * The functions ending with ToBuffer write their result into a buffer owned by the caller instead.
+ * The methods working with JSON (options, editor actions, etc.) are available only in the builds with JSON support.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A buffer owned by the caller, into which the ToBuffer functions write their result.
+ * It has to be initialized with all its members set to zero and is grown with realloc when the result does not fit,
+ * so the same buffer can be reused by several calls. The data is followed by a null byte, which is not counted in the
+ * length. It is released with vrvBuffer_free.
+ */
+typedef struct vrvBuffer {
+    char *data;
+    size_t length;
+    size_t capacity;
+} vrvBuffer;
+
+void vrvBuffer_free(vrvBuffer *buffer);
+
+/**
+ * @name Constructors and destructor
+ * vrvToolkit_constructor uses the resources in /data with Emscripten and the default resource path otherwise.
+ * vrvToolkit_constructorResourcePath uses the resource path for this toolkit only (see Toolkit::SetResourcePath).
+ */
+///@{
+void *vrvToolkit_constructor();
+void *vrvToolkit_constructorResourcePath(const char *resourcePath);
+void vrvToolkit_destructor(void *tkPtr);
+///@}
+
+bool vrvToolkit_edit(void *tkPtr, const char *editorAction);
+const char *vrvToolkit_getEditInfo(void *tkPtr);
+const char *vrvToolkit_getElementAttr(void *tkPtr, const char *xmlId);
+const char *vrvToolkit_getElementsAtTime(void *tkPtr, int millisec);
+const char *vrvToolkit_getHumdrum(void *tkPtr);
+const char *vrvToolkit_getLayoutBreaks(void *tkPtr, const char *pageWidths);
+const char *vrvToolkit_getLog(void *tkPtr);
+const char *vrvToolkit_getMEI(void *tkPtr, int page_no, bool score_based);
+int vrvToolkit_getPageCount(void *tkPtr);
+int vrvToolkit_getPageWithElement(void *tkPtr, const char *xmlId);
+const char *vrvToolkit_getProfileReport(void *tkPtr);
+size_t vrvToolkit_getResultLength(void *tkPtr);
+double vrvToolkit_getTimeForElement(void *tkPtr, const char *xmlId);
+const char *vrvToolkit_getVersion(void *tkPtr);
+bool vrvToolkit_loadData(void *tkPtr, const char *data);
+void vrvToolkit_redoLayout(void *tkPtr);
+void vrvToolkit_redoPagePitchPosLayout(void *tkPtr);
+const char *vrvToolkit_renderData(void *tkPtr, const char *data, const char *options);
+const char *vrvToolkit_renderMeasures(void *tkPtr, const char *startId, const char *endId, const char *c_options);
+const char *vrvToolkit_renderPage(void *tkPtr, int page_no, const char *c_options);
+const char *vrvToolkit_renderPageRange(void *tkPtr, int page_no, int x1, int x2, const char *c_options);
+const char *vrvToolkit_renderToMidi(void *tkPtr, const char *c_options);
+const char *vrvToolkit_renderToMidiData(void *tkPtr, const char *c_options);
+void vrvToolkit_setOptions(void *tkPtr, const char *options);
+
+/**
+ * @name Functions writing their result into a buffer owned by the caller
+ * They return false if the buffer could not be grown, in which case it is left unchanged.
+ * vrvToolkit_renderToMidiDataToBuffer writes the binary MIDI file.
+ */
+///@{
+bool vrvToolkit_getHumdrumToBuffer(void *tkPtr, vrvBuffer *buffer);
+bool vrvToolkit_getMEIToBuffer(void *tkPtr, int page_no, bool score_based, vrvBuffer *buffer);
+bool vrvToolkit_renderPageToBuffer(void *tkPtr, int page_no, const char *c_options, vrvBuffer *buffer);
+bool vrvToolkit_renderToMidiDataToBuffer(void *tkPtr, const char *c_options, vrvBuffer *buffer);
+///@}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif
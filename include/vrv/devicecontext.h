@@ -48,6 +48,7 @@ public:
         m_drawingBoundingBoxes = false;
         m_isDeactivatedX = false;
         m_isDeactivatedY = false;
+        m_textExtentCache = NULL;
     }
     virtual ~DeviceContext(){};
     virtual ClassId GetClassId() const;
@@ -80,6 +81,13 @@ public:
     virtual void GetTextExtent(const std::string &string, TextExtend *extend);
     virtual void GetTextExtent(const std::wstring &string, TextExtend *extend);
     virtual void GetSmuflTextExtent(const std::wstring &string, TextExtend *extend);
+    ///@}
+
+    /**
+     * Set the cache used for memoizing the text extends (NULL for none).
+     * The cache is owned by the Doc and remains valid as long as the text font does not change.
+     */
+    void SetTextExtentCache(TextExtentCache *cache) { m_textExtentCache = cache; }
 
     /**
      * @name Getters
@@ -217,6 +225,9 @@ protected:
     /** flag for indicating if the graphic is deactivated */
     bool m_isDeactivatedX;
     bool m_isDeactivatedY;
+
+    /** The cache for text extends (not owned) */
+    TextExtentCache *m_textExtentCache;
 };
 
 } // namespace vrv
@@ -8,6 +8,7 @@
 #ifndef __VRV_DC_BASE_H__
 #define __VRV_DC_BASE_H__
 
+#include <map>
 #include <string>
 
 //----------------------------------------------------------------------------
@@ -197,6 +198,11 @@ public:
     // no copy ctor or assignment operator - the defaults are ok
 };
 
+/**
+ * Text extends memoized by point size and string (see DeviceContext::GetTextExtent)
+ */
+typedef std::map<std::pair<int, std::wstring>, TextExtend> TextExtentCache;
+
 } // namespace vrv
 
 #endif // __AX_DC_BASE_H__
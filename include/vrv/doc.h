@@ -136,6 +136,13 @@ public:
     FontInfo *GetDrawingLyricFont(int staffSize);
     ///@}
 
+    /**
+     * Return the cache of text extends for the device contexts drawing the document.
+     * It is cleared when the fonts changed since it was filled (see Resources::GetFontGeneration), including when
+     * they were changed by another toolkit.
+     */
+    TextExtentCache *GetTextExtentCache();
+
     /**
      * @name Setters for the page dimensions and margins
      */
@@ -201,6 +208,26 @@ public:
     bool GetEvenSpacing() const { return m_drawingEvenSpacing; }
     ///@}
 
+    /*
+     * @name Setter and getter for the flag for reusing the cast-off layout.
+     * When enabled, the horizontal alignment of the measures done by CastOffDoc is kept and reused when laying out
+     * the pages. The duration-based spacing is then based on the longest duration of the whole document.
+     */
+    ///@{
+    void SetReuseLayout(bool drawingReuseLayout) { m_drawingReuseLayout = drawingReuseLayout; }
+    bool GetReuseLayout() const { return m_drawingReuseLayout; }
+    ///@}
+
+    /*
+     * @name Setter and getter for the flag indicating that only an excerpt of the score was loaded.
+     * In an excerpt, the time spanning elements crossing its boundaries are attached to its first or last element
+     * in PrepareDrawing.
+     */
+    ///@{
+    void SetExcerpt(bool isExcerpt) { m_isExcerpt = isExcerpt; }
+    bool IsExcerpt() const { return m_isExcerpt; }
+    ///@}
+
     /*
      * @name Setter and getter for linear and non-linear spacing parameters
      */
@@ -235,9 +262,19 @@ public:
     /**
      * Casts off the entire document.
      * Starting from a single system, create and fill pages and systems.
+     * The measure widths of the previous cast-off are reused if they are still valid.
+     * Only the measures whose alignment was changed by the layout of a page are then aligned again.
      */
     void CastOffDoc();
 
+    /**
+     * Invalidate the measure widths stored by the previous cast-off.
+     * This needs to be done when the horizontal layout of the content changes (e.g., after editing or changing the
+     * font) and the next cast-off needs to lay out the content horizontally again. The measures laid out on a page
+     * since the cast-off do not invalidate them and are only aligned again (see Page::LayOut).
+     */
+    void ResetCastOffWidths() { m_castOffWidthsDone = false; }
+
     /**
      * Undo the cast off of the entire document.
      * The document will then contain one single page with one single system.
@@ -250,6 +287,13 @@ public:
      */
     void CastOffEncodingDoc();
 
+    /**
+     * Cast off of the entire document with the number of elements of each system given by page.
+     * This is the cast-off of a document loaded from a layout snapshot (see Toolkit::SetLayoutCache).
+     * Returns false without modifying the document if the numbers do not match the content.
+     */
+    bool CastOffSnapshotDoc(const std::vector<std::vector<int> > &pageSystemSizes);
+
     /**
      * Convert the doc from score-based to page-based MEI.
      * Containers will be converted to boundaryStart / boundaryEnd.
@@ -311,6 +355,12 @@ private:
      */
     int CalcMusicFontSize();
 
+    /**
+     * Attach the time spanning elements with an unmatched start or end to the first or last element of the excerpt
+     * on the same staff. The elements attached are removed from the array.
+     */
+    void AttachExcerptTimeSpanning(ArrayOfSpanningInterClassIdPairs &timeSpanningInterfaces);
+
 public:
     /**
      * A copy of the header tree stored as pugi::xml_document
@@ -341,6 +391,10 @@ public:
     bool m_drawingJustifyX;
     /** flag for disabling spacing by duration */
     bool m_drawingEvenSpacing;
+    /** flag for reusing the cast-off layout */
+    bool m_drawingReuseLayout;
+    /** flag indicating that only an excerpt of the score was loaded */
+    bool m_isExcerpt;
     /** value of the linear spacing factor */
     double m_drawingSpacingLinear;
     /** value of the non linear spacing factor */
@@ -398,6 +452,10 @@ private:
     FontInfo m_drawingSmuflFont;
     /** Current lyric font */
     FontInfo m_drawingLyricFont;
+    /** Text extends memoized across the layout and rendering passes (cleared when the font changes) */
+    TextExtentCache m_textExtentCache;
+    /** The font generation of the text extents */
+    int m_textExtentFontGeneration;
 
     /**
      * A flag to indicate whether the currentScoreDef has been set or not.
@@ -412,6 +470,24 @@ private:
      */
     bool m_drawingPreparationDone;
 
+    /**
+     * A flag to indicate if the measure widths of the cast-off have been stored.
+     * If yes, CastOffDoc will not redo the horizontal layout of the content, unless the fonts changed since then.
+     */
+    bool m_castOffWidthsDone;
+    /** The font generation of the measure widths of the cast-off */
+    int m_castOffFontGeneration;
+
+    /**
+     * @name The values of the content page of the cast-off stored with the measure widths
+     */
+    ///@{
+    int m_castOffLabelsWidth;
+    int m_castOffAbbrLabelsWidth;
+    int m_castOffScoreDefWidth;
+    int m_castOffLongestActualDur;
+    ///@}
+
     /**
      * A flag to indicate if the MIDI export has been done.
      * This is necessary for retrieving notes being played at a certain time.
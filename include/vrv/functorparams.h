@@ -643,6 +643,7 @@ public:
  * member 4: the system width
  * member 5: the current scoreDef width
  * member 6: the current pending objects (ScoreDef, Endings, etc.) to be place at the beginning of a system
+ * member 7: a flag indicating if the measure widths of the previous cast-off are reused
 **/
 
 class CastOffSystemsParams : public FunctorParams {
@@ -655,6 +656,7 @@ public:
         m_shift = 0;
         m_systemWidth = 0;
         m_currentScoreDefWidth = 0;
+        m_reuseWidths = false;
     }
     System *m_contentSystem;
     Page *m_page;
@@ -663,6 +665,7 @@ public:
     int m_systemWidth;
     int m_currentScoreDefWidth;
     ArrayOfObjects m_pendingObjects;
+    bool m_reuseWidths;
 };
 
 //----------------------------------------------------------------------------
@@ -0,0 +1,6 @@
+////////////////////////////////////////////////////////
+/// Git commit version file generated at compilation ///
+////////////////////////////////////////////////////////
+
+#define GIT_COMMIT "bc88834-dirty"
+
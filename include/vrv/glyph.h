@@ -79,7 +79,7 @@ public:
     bool HasAnchor(SMuFLGlyphAnchor anchor);
 
     /**
-     * Return the SMuFL anchor for the glyph.
+     * Return the SMuFL anchor for the glyph (NULL if the glyph does not have it).
      */
     const Point *GetAnchor(SMuFLGlyphAnchor anchor);
 
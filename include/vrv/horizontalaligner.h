@@ -92,6 +92,11 @@ public:
     int GetXRel() const { return m_xRel; }
     ///@}
 
+    /**
+     * Return the drawing X generation of the parent HorizontalAligner.
+     */
+    unsigned long long GetDrawingXGeneration() const;
+
     /**
      * @name Set and get the time value of the alignment
      */
@@ -344,6 +349,17 @@ public:
 
     int GetAlignmentCount() const { return (int)m_children.size(); }
 
+    /**
+     * @name Get and increment the generation of the drawing X positions of the aligner.
+     * The generation is incremented when one of its alignments, the measure or the system is moved.
+     * LayerElement and Measure store it along with their cached drawing X and recompute it only when it has changed.
+     * Values are taken from a global counter and are never reused by another aligner.
+     */
+    ///@{
+    unsigned long long GetDrawingXGeneration() const { return m_drawingXGeneration; }
+    void IncrementDrawingXGeneration();
+    ///@}
+
     //----------//
     // Functors //
     //----------//
@@ -352,6 +368,7 @@ protected:
     /**
      * Search if an alignment of the type is already there at the time.
      * If not, return in idx the position where it needs to be inserted (-1 if it is the end)
+     * The alignments are kept ordered by time and type, which makes the search logarithmic.
      */
     Alignment *SearchAlignmentAtTime(double time, AlignmentType type, int &idx);
 
@@ -365,6 +382,10 @@ private:
 public:
     //
 private:
+    /**
+     * The current generation of the drawing X positions
+     */
+    unsigned long long m_drawingXGeneration;
 };
 
 //----------------------------------------------------------------------------
@@ -430,6 +451,12 @@ public:
     Alignment *GetRightAlignment() const { return m_rightAlignment; }
     Alignment *GetRightBarLineAlignment() const { return m_rightBarLineAlignment; }
 
+    /**
+     * Return the index of the right barline Alignment.
+     * This is faster than GetIdx because the alignment is searched from the end.
+     */
+    int GetRightBarLineAlignmentIdx() const;
+
     /**
      * Adjust the spacing of the measure looking at each tuple of start / end alignment and a distance.
      * The distance is an expansion value (positive) of compression (negative).
@@ -74,6 +74,12 @@ public:
     // read
     virtual bool ImportFile() { return true; }
     virtual bool ImportString(std::string const &data) { return true; }
+    /**
+     * Import data from a buffer that can be modified, e.g., by parsing it in place.
+     * The buffer is not used anymore once the method returns.
+     * By default it is copied and passed to ImportString.
+     */
+    virtual bool ImportBuffer(char *data, size_t length) { return ImportString(std::string(data, length)); }
 
     /**
      * Getter for layoutInformation flag that is set to true during import
@@ -96,6 +102,15 @@ public:
      */
     virtual void SetMdivXPathQuery(std::string &xPathQuery) {}
 
+    /**
+     * Set the range of measures (@n of the first and last) and the staves (@n) to be loaded (MEI only)
+     * The default implementations warn that they are ignored.
+     */
+    ///@{
+    virtual void SetMeasureRange(int first, int last);
+    virtual void SetStaffSelection(const std::vector<int> &staffNs);
+    ///@}
+
     /**
      * Set Humdrum import type option (Humdrum only)
      */
@@ -8,6 +8,7 @@
 #ifndef __VRV_IOMEI_H__
 #define __VRV_IOMEI_H__
 
+#include <set>
 #include <sstream>
 
 //----------------------------------------------------------------------------
@@ -107,6 +108,9 @@ class Tuplet;
 class Unclear;
 class Verse;
 
+/** The position of the reading in the measure range (see MeiInput::SetMeasureRange) */
+enum { MEASURE_RANGE_BEFORE = 0, MEASURE_RANGE_IN, MEASURE_RANGE_AFTER };
+
 //----------------------------------------------------------------------------
 // MeiOutput
 //----------------------------------------------------------------------------
@@ -152,6 +156,20 @@ public:
 private:
     bool WriteMeiDoc(Doc *doc);
 
+    /**
+     * @name Methods for writing the document to the output stream during the traversal
+     * FlushNode writes a complete node with everything that precedes it and removes it from the document. The
+     * ancestors are written as start tags and are kept open until a node outside of them is flushed. The output is
+     * the same as the one of pugixml for the entire document.
+     */
+    ///@{
+    void FlushNode(pugi::xml_node node);
+    void WriteNode(pugi::xml_node node, int depth);
+    void WritePrecedingNodes(pugi::xml_node node, int depth);
+    void WriteStartTag(pugi::xml_node node, int depth);
+    void CloseNode(pugi::xml_node node, int depth);
+    ///@}
+
     /**
      * Write the @xml:id to the currentNode
      */
@@ -320,6 +338,10 @@ private:
     std::string m_filename;
     std::ostringstream m_streamStringOutput;
     bool m_writeToStreamString;
+    /** The stream being written by ExportFile */
+    std::ostream *m_outputStream;
+    /** The elements written as start tags and not closed yet, from the top */
+    std::vector<pugi::xml_node> m_openNodes;
     int m_page;
     bool m_scoreBasedMEI;
     pugi::xml_node m_mei;
@@ -345,6 +367,7 @@ public:
 
     virtual bool ImportFile();
     virtual bool ImportString(std::string const &mei);
+    virtual bool ImportBuffer(char *data, size_t length);
 
     /**
      * Set the xPath queries for selecting specific <rdg>.
@@ -367,9 +390,37 @@ public:
      */
     virtual void SetMdivXPathQuery(std::string &xPathQuery) { m_mdivXPathQuery = xPathQuery; }
 
+    /**
+     * Set the range of measures to be loaded, with the @n of the first and the last measure.
+     * The measures before the range are skipped, but the clef changes they contain are passed on with a <scoreDef>
+     * preceding the first measure, and the control elements with an @endid not reached yet are moved to it.
+     * Reading stops after the last measure.
+     */
+    virtual void SetMeasureRange(int first, int last)
+    {
+        m_measureRangeFirst = first;
+        m_measureRangeLast = last;
+    }
+
+    /**
+     * Set the staves to be loaded, with their @n. Other <staffDef> and <staff> are skipped, as well as the
+     * control elements with a @staff referring only to them or, without @staff, starting in them.
+     * Reading fails if one of the staves is not found.
+     */
+    virtual void SetStaffSelection(const std::vector<int> &staffNs) { m_staffSelection = staffNs; }
+
 private:
     bool ReadMei(pugi::xml_node root);
 
+    /**
+     * Return the next sibling of a node that was read and remove the node if it is a measure or a staff.
+     * This is not incremental parsing: pugixml parses the whole document into a tree before anything is read, so the
+     * peak memory still includes the full XML tree. Removing the nodes only gives their memory back while the objects
+     * are created. The nodes are kept when xpath queries are given for <app> or <choice> since these can refer to any
+     * node of the tree.
+     */
+    pugi::xml_node ReleaseNode(pugi::xml_node node);
+
     /**
      * @name Methods for reading MEI score-based elements
      */
@@ -382,6 +433,17 @@ private:
     bool ReadMeiSb(Object *parent, pugi::xml_node sb);
     ///@}
 
+    /**
+     * @name Methods for the measure range and the staff selection (see MeiInput::SetMeasureRange)
+     */
+    ///@{
+    bool IsInMeasureRange(pugi::xml_node measure);
+    bool IsInStaffSelection(pugi::xml_node element);
+    void StoreSkippedClefs(pugi::xml_node measure);
+    void ForgetSkippedClefs(pugi::xml_node scoreDef);
+    void StoreSkippedTimeSpanning(pugi::xml_node measure);
+    ///@}
+
     /**
      * @name Methods for reading  MEI containers (measures, staff, etc) scoreDef and related.
      * For each container (page, system, measure, staff and layer) there is one method for
@@ -586,6 +648,33 @@ private:
      */
     std::string m_mdivXPathQuery;
 
+    /**
+     * The @n of the first and last measures to be loaded (VRV_UNSET for all) and the position of the reading
+     */
+    ///@{
+    int m_measureRangeFirst;
+    int m_measureRangeLast;
+    int m_measureRangePosition;
+    ///@}
+
+    /**
+     * The last clef of each staff in the measures skipped before the range, as a <scoreDef> to be read
+     */
+    pugi::xml_document m_skippedClefs;
+
+    /**
+     * The control elements of the measures skipped before the range with an @endid not reached yet
+     */
+    pugi::xml_document m_skippedTimeSpanning;
+
+    /**
+     * @name The @n of the staves to be loaded (all if empty) and of the ones read, which have to be all of them
+     */
+    ///@{
+    std::vector<int> m_staffSelection;
+    std::set<int> m_staffSelectionRead;
+    ///@}
+
     /**
      * A flag indicating wheather we are reading page-based or score-based MEI
      */
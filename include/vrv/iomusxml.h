@@ -101,6 +101,7 @@ public:
 
     virtual bool ImportFile();
     virtual bool ImportString(std::string const &musicxml);
+    virtual bool ImportBuffer(char *data, size_t length);
 
 private:
     /*
@@ -195,6 +196,16 @@ private:
     std::string GetContentOfChild(pugi::xml_node node, std::string child);
     ///@}
 
+    /**
+     * @name Helper methods for retrieving child elements without evaluating XPath expressions.
+     * GetChildWithAttribute returns the first child element that has the attribute.
+     * GetChildWithNumber returns the first child element with the @number (or the element at the path within it).
+     */
+    ///@{
+    pugi::xml_node GetChildWithAttribute(pugi::xml_node node, std::string child, std::string attribute);
+    pugi::xml_node GetChildWithNumber(pugi::xml_node node, std::string child, int number, std::string path = "");
+    ///@}
+
     /*
      * @name Methods for opening and closing ties and slurs.
      * Opened ties and slurs are stacked together with musicxml::OpenTie
@@ -214,7 +225,7 @@ private:
      */
     ///@{
     ///@}
-    void TextRendition(pugi::xpath_node_set words, ControlElement *element);
+    void TextRendition(const std::vector<pugi::xml_node> &words, ControlElement *element);
     void PrintMetronome(pugi::xml_node metronome, Tempo *tempo);
 
     /*
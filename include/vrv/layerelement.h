@@ -308,6 +308,11 @@ private:
      * This also stores the negative values for identifying cross-staff
      */
     int m_alignmentLayerN;
+    /**
+     * The generation of the aligner(s) when m_cachedDrawingX was calculated.
+     * See HorizontalAligner::GetDrawingXGeneration
+     */
+    mutable unsigned long long m_cachedDrawingXGeneration;
 };
 
 } // namespace vrv
@@ -142,6 +142,27 @@ public:
      */
     int GetInnerWidth() const;
 
+    /**
+     * @name Getters for the position and the width of the measure in the content system of the cast-off.
+     * They are stored by CastOffSystems and used for casting off the document again without redoing the horizontal
+     * layout (see Doc::CastOffDoc).
+     */
+    ///@{
+    int GetCastOffXRel() const { return m_castOffXRel; }
+    int GetCastOffWidth() const { return m_castOffWidth; }
+    ///@}
+
+    /**
+     * @name Setter and getter for the flag indicating that the alignment of the measure was changed by the layout of
+     * its page since the cast-off (see Page::LayOut).
+     * The position and the width stored by CastOffSystems are kept and only the alignment of the measure is redone by
+     * the next cast-off.
+     */
+    ///@{
+    void SetCastOffAlignmentChanged(bool changed) { m_castOffAlignmentChanged = changed; }
+    bool HasCastOffAlignmentChanged() const { return m_castOffAlignmentChanged; }
+    ///@}
+
     /**
      * Return the center x of the inner of the measure
      */
@@ -346,6 +367,22 @@ protected:
 private:
     bool m_measuredMusic;
 
+    /**
+     * The generation of the measure aligner when m_cachedDrawingX was calculated.
+     * See HorizontalAligner::GetDrawingXGeneration
+     */
+    mutable unsigned long long m_cachedDrawingXGeneration;
+
+    /**
+     * @name The position and the width of the measure in the content system of the last cast-off
+     */
+    ///@{
+    int m_castOffXRel;
+    int m_castOffWidth;
+    ///@}
+    /** The flag indicating that the alignment was changed by the layout of the page since the last cast-off */
+    bool m_castOffAlignmentChanged;
+
     /**
      * @name The measure barlines (left and right) used when drawing
      */
@@ -8,6 +8,7 @@
 #ifndef __VRV_OBJECT_H__
 #define __VRV_OBJECT_H__
 
+#include <atomic>
 #include <cstdlib>
 #include <ctime>
 #include <iterator>
@@ -30,6 +31,7 @@ class Functor;
 class FunctorParams;
 class PitchInterface;
 class PositionInterface;
+class ProcessFrame;
 class ScoreDefInterface;
 class StemmedDrawingInterface;
 class TextDirInterface;
@@ -429,8 +431,9 @@ public:
      * This is the generic way for parsing the tree, e.g., for extracting one single staff or layer.
      * Deepness specifies how many child levels should be processed. UNLIMITED_DEPTH means no
      * limit (EditorialElement objects do not count).
+     * The tree is processed iteratively with an explicit stack of ProcessFrame objects.
      */
-    virtual void Process(Functor *functor, FunctorParams *functorParams, Functor *endFunctor = NULL,
+    void Process(Functor *functor, FunctorParams *functorParams, Functor *endFunctor = NULL,
         ArrayOfAttComparisons *filters = NULL, int deepness = UNLIMITED_DEPTH, bool direction = FORWARD);
 
     //----------//
@@ -929,6 +932,12 @@ private:
      */
     void Init(std::string);
 
+    /**
+     * Call the functor on the object when it is reached by Object::Process.
+     * Return true if the children have to be processed, in which case the frame is ready to be stacked.
+     */
+    bool ProcessEnter(Functor *functor, FunctorParams *functorParams, ProcessFrame &frame);
+
 public:
     /**
      * Keep an array of unsupported attributes as pairs.
@@ -1004,9 +1013,9 @@ private:
     bool m_isAttribute;
 
     /**
-     * A static counter for uuid generation.
+     * A static counter for uuid generation (atomic since the objects can be created by several threads).
      */
-    static unsigned long s_objectCounter;
+    static std::atomic<unsigned long> s_objectCounter;
 };
 
 //----------------------------------------------------------------------------
@@ -1129,8 +1138,8 @@ public:
     Functor(int (Object::*_obj_fpt)(FunctorParams *));
     virtual ~Functor(){};
 
-    // override function "Call"
-    virtual void Call(Object *ptr, FunctorParams *functorParams);
+    // we should have return codes (not just bool) for avoiding to go further down the tree in some cases
+    void Call(Object *ptr, FunctorParams *functorParams) { m_returnCode = (*ptr.*obj_fpt)(functorParams); }
 
 private:
     //
@@ -1151,6 +1160,36 @@ public:
 private:
 };
 
+//----------------------------------------------------------------------------
+// ProcessFrame
+//----------------------------------------------------------------------------
+
+/**
+ * This class holds the state of one level of the tree processed by Object::Process.
+ * It replaces the recursive calls with an explicit stack.
+ * member 0: the Object whose children are processed
+ * member 1: the deepness left for the children
+ * member 2: the direction of the processing
+ * member 3: the index of the next child to process
+ * member 4: a flag indicating if the children have to be processed (e.g., not for hidden editorial elements)
+ */
+class ProcessFrame {
+public:
+    ProcessFrame(Object *object, int deepness, bool direction)
+    {
+        m_object = object;
+        m_deepness = deepness;
+        m_direction = direction;
+        m_next = 0;
+        m_processChildren = true;
+    }
+    Object *m_object;
+    int m_deepness;
+    bool m_direction;
+    int m_next;
+    bool m_processChildren;
+};
+
 //----------------------------------------------------------------------------
 // ObjectComparison
 //----------------------------------------------------------------------------
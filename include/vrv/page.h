@@ -85,9 +85,29 @@ public:
     void LayOutTranscription(bool force = false);
 
     /**
-     * Lay out the content of the page (measures and their content) horizontally
+     * Lay out the content of the page (measures and their content) horizontally.
+     * With reuseCastOff, the alignment of the measures done by Doc::CastOffDoc is kept and only the first and the
+     * last measure of each system (which get the system and the cautionary scoreDef) and the measures with a
+     * scoreDef or staffDef change are aligned again, as well as the measures whose alignment was changed by the layout
+     * of a page since then (see Measure::HasCastOffAlignmentChanged).
      */
-    void LayOutHorizontally();
+    void LayOutHorizontally(bool reuseCastOff = false);
+
+    /**
+     * Mark the page as containing measures aligned by Doc::CastOffDoc with the given longest duration.
+     * The alignment is reused by the next (not forced) LayOut of the page.
+     */
+    void SetCastOffAlignment(int longestActualDur) { m_castOffLongestActualDur = longestActualDur; }
+
+    /**
+     * Return true if the alignment of one of the measures was changed by the layout of a page since the cast-off.
+     */
+    bool HasCastOffAlignmentChanged() const;
+
+    /**
+     * Return the longest duration used for the spacing by the last horizontal layout of the page.
+     */
+    int GetLongestActualDur() const { return m_longestActualDur; }
 
     /**
      * Justifiy the content of the page (measures and their content) horizontally
@@ -142,7 +162,8 @@ private:
     /**
      * Adjust the horizontal postition of the syl processing verse by verse
      */
-    void AdjustSylSpacingByVerse(PrepareProcessingListsParams &listsParams, Doc *doc);
+    void AdjustSylSpacingByVerse(
+        PrepareProcessingListsParams &listsParams, Doc *doc, ArrayOfAttComparisons *measureFilters = NULL);
 
     //
 public:
@@ -178,6 +199,17 @@ private:
      */
     bool m_layoutDone;
 
+    /**
+     * The longest duration used by Doc::CastOffDoc when aligning the measures of the page.
+     * VRV_UNSET when the alignment is not to be reused, and reset once the page has been laid out.
+     */
+    int m_castOffLongestActualDur;
+
+    /**
+     * The longest duration used for the spacing by the last horizontal layout
+     */
+    int m_longestActualDur;
+
     /**
      *
      */
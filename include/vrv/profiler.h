@@ -0,0 +1,213 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        profiler.h
+// Author:      Verovio contributors
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VRV_PROFILER_H__
+#define __VRV_PROFILER_H__
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace vrv {
+
+//----------------------------------------------------------------------------
+// ProfilerPhase
+//----------------------------------------------------------------------------
+
+/**
+ * This class holds the accumulated values of a phase of the processing.
+ * Phases are nested and identified by their name within their parent phase.
+ * A phase started several times (e.g., the layout of each page) is accumulated.
+ */
+class ProfilerPhase {
+public:
+    ProfilerPhase(const std::string &name, ProfilerPhase *parent);
+    virtual ~ProfilerPhase();
+
+    /**
+     * Return the child phase with the name, creating it if necessary.
+     */
+    ProfilerPhase *GetChild(const std::string &name);
+
+    /**
+     * Return the number of nodes visited in the phase and its children.
+     */
+    long GetTotalNodes() const;
+
+    /**
+     * Return the accumulated time (in seconds) of the phases with the name within the phase.
+     * The time of a phase is not counted twice when its name is also used by one of its children.
+     */
+    double GetTimeOf(const std::string &name) const;
+
+    /**
+     * Return the number of nodes visited in the phases with the name within the phase, including their children.
+     */
+    long GetNodesOf(const std::string &name) const;
+
+    /**
+     * Write the phase and its children as a JSON object.
+     */
+    void WriteJSON(std::string &output, int indent) const;
+
+public:
+    std::string m_name;
+    ProfilerPhase *m_parent;
+    std::vector<ProfilerPhase *> m_children;
+    /** The number of times the phase was started */
+    int m_calls;
+    /** The accumulated time of the phase (in seconds) */
+    double m_time;
+    /** The number of nodes visited by the functors processed directly within the phase */
+    long m_nodes;
+    /** The time at which the phase was last started */
+    std::chrono::steady_clock::time_point m_start;
+};
+
+//----------------------------------------------------------------------------
+// Profiler
+//----------------------------------------------------------------------------
+
+/**
+ * This class collects the values of the processing phases.
+ * A profiler is owned by each Toolkit and is disabled by default.
+ * The processing code opens and closes phases with the static Start and End methods, which need to be balanced. They
+ * are passed to the profiler bound to the current thread (see ProfilerScope) and return immediately if there is none
+ * or if it is disabled. The values of a toolkit are therefore never mixed with the ones of another toolkit or of
+ * another thread.
+ *
+ * Ex:
+ *
+ * Profiler::Start("AlignHorizontally");
+ * ... Do something
+ * Profiler::End();
+ */
+class Profiler {
+public:
+    Profiler();
+    virtual ~Profiler();
+
+    /**
+     * @name Enable or disable the profiler.
+     * Enabling it resets the values previously collected.
+     */
+    ///@{
+    void Enable(bool enable);
+    bool IsEnabled() const { return m_enabled; }
+    ///@}
+
+    /**
+     * Reset the values previously collected.
+     */
+    void Reset();
+
+    /**
+     * Return the report of the collected values as a JSON string.
+     * Time values are given in milliseconds.
+     */
+    std::string GetJSON() const;
+
+    /**
+     * Return the accumulated time (in milliseconds) of all the phases with the name.
+     * Return 0.0 if no phase with the name was profiled.
+     */
+    double GetTime(const std::string &name) const { return m_root.GetTimeOf(name) * 1000.0; }
+
+    /**
+     * Return the number of nodes visited in all the phases with the name.
+     * Return 0 if no phase with the name was profiled.
+     */
+    long GetNodes(const std::string &name) const { return m_root.GetNodesOf(name); }
+
+    /**
+     * @name Get and set the profiler bound to the current thread (NULL if none).
+     * Setting it returns the one previously bound.
+     */
+    ///@{
+    static Profiler *GetCurrent() { return s_current; }
+    static Profiler *SetCurrent(Profiler *profiler);
+    ///@}
+
+    /**
+     * @name Start and end a phase nested in the current one of the profiler bound to the current thread
+     */
+    ///@{
+    static void Start(const char *name)
+    {
+        Profiler *profiler = s_current;
+        if (profiler && profiler->m_enabled) profiler->StartPhase(name);
+    }
+    static void End()
+    {
+        Profiler *profiler = s_current;
+        if (profiler && profiler->m_enabled) profiler->EndPhase();
+    }
+    ///@}
+
+    /**
+     * Add nodes visited by a functor to the current phase of the profiler bound to the current thread.
+     * Called by Object::Process.
+     */
+    static void AddVisitedNodes(long nodes)
+    {
+        Profiler *profiler = s_current;
+        if (profiler && profiler->m_enabled) profiler->m_currentPhase->m_nodes += nodes;
+    }
+
+private:
+    void StartPhase(const char *name);
+    void EndPhase();
+
+public:
+    //
+private:
+    bool m_enabled;
+    ProfilerPhase m_root;
+    ProfilerPhase *m_currentPhase;
+
+    /** The profiler bound to the current thread */
+    static thread_local Profiler *s_current;
+};
+
+//----------------------------------------------------------------------------
+// ProfilerScope
+//----------------------------------------------------------------------------
+
+/**
+ * This class starts a phase and ends it when going out of scope.
+ * To be used in methods with several return points.
+ * When a profiler is given, it is bound to the current thread for the scope. This is done by the Toolkit methods so
+ * that the phases processed within them are collected by the profiler of the toolkit.
+ */
+class ProfilerScope {
+public:
+    ProfilerScope(const char *name)
+    {
+        m_bound = false;
+        m_previous = NULL;
+        Profiler::Start(name);
+    }
+    ProfilerScope(Profiler *profiler, const char *name)
+    {
+        m_bound = true;
+        m_previous = Profiler::SetCurrent(profiler);
+        Profiler::Start(name);
+    }
+    ~ProfilerScope()
+    {
+        Profiler::End();
+        if (m_bound) Profiler::SetCurrent(m_previous);
+    }
+
+private:
+    bool m_bound;
+    Profiler *m_previous;
+};
+
+} // namespace vrv
+
+#endif
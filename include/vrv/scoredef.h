@@ -141,6 +141,7 @@ public:
 
     /**
      * Get the staffDef with number n (NULL if not found).
+     * The staffDefs are looked up in an index by @n rebuilt with the list when the content is modified.
      */
     StaffDef *GetStaffDef(int n);
 
@@ -196,6 +197,7 @@ protected:
     /**
      * Filter the list for a specific class.
      * For example, keep staffGrp for fast access.
+     * This also fills the staffDef index by @n.
      */
     virtual void FilterList(ListOfObjects *childList);
 
@@ -209,6 +211,8 @@ private:
     bool m_drawLabels;
     /** Store the drawing width (clef and key sig) of the scoreDef */
     int m_drawingWidth;
+    /** The staffDefs by @n (the first one for duplicated values), filled by FilterList */
+    std::map<int, StaffDef *> m_staffDefIndex;
 };
 
 //----------------------------------------------------------------------------
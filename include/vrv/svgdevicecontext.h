@@ -56,6 +56,8 @@ public:
     virtual void SetTextBackground(int colour);
     virtual void SetLogicalOrigin(int x, int y);
     virtual void SetUserScale(double xScale, double yScale);
+    /** Set the left of the viewBox for rendering only a horizontal range of the page (0 by default) */
+    void SetViewBoxX(int x) { m_viewBoxX = x; }
     ///@}
 
     /**
@@ -189,6 +191,7 @@ private:
 
     bool m_committed; // did we flushed the file?
     int m_width, m_height;
+    int m_viewBoxX;
     int m_originX, m_originY;
     double m_userScaleX, m_userScaleY;
 
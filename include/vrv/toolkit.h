@@ -8,12 +8,15 @@
 #ifndef __VRV_TOOLKIT_H__
 #define __VRV_TOOLKIT_H__
 
+#include <set>
 #include <string>
 
 //----------------------------------------------------------------------------
 
 #include "doc.h"
+#include "profiler.h"
 #include "view.h"
+#include "vrv.h"
 
 //----------------------------------------------------------------------------
 
@@ -26,6 +29,8 @@
 
 namespace vrv {
 
+class FileInputStream;
+
 enum FileFormat { UNKNOWN = 0, AUTO, MEI, HUMDRUM, PAE, DARMS, MUSICXML, MUSICXMLHUM, MIDI };
 
 //----------------------------------------------------------------------------
@@ -38,14 +43,15 @@ public:
      * @name Constructors and destructors
      */
     ///@{
-    /** If initFont is set to false, Resources::InitFonts will have to be called explicitely */
+    /** If initFont is set to false, Resources::InitFonts or SetResourcePath will have to be called explicitely */
     Toolkit(bool initFont = true);
     virtual ~Toolkit();
     ///@}
 
     /**
-     * Set the resource path. To be called if the constructor had initFont=false.
-     * This needs refactoring.
+     * Set the resource path of the toolkit and load its fonts from it.
+     * The path and the fonts are the ones of the toolkit only (see ResourceSet), other toolkits keep using theirs
+     * or the ones of the process.
      */
     bool SetResourcePath(const std::string &path);
 
@@ -59,6 +65,13 @@ public:
      */
     bool LoadData(const std::string &data);
 
+    /**
+     * Load data from a buffer of the given length.
+     * MEI and MusicXML data is parsed in place without being copied, which means that the content of the buffer is
+     * modified. The buffer is not used anymore once the method returns.
+     */
+    bool LoadData(char *data, size_t length);
+
     /**
      * Save an MEI file.
      */
@@ -72,10 +85,21 @@ public:
 
     /**
      * Parse the editor actions passed as JSON string.
+     * The string is either one action object or an array of them. An array is performed as one batch with a
+     * single PrepareDrawing and a single layout at the end, and the pages changed are given by GetEditInfo.
+     * A batch is performed entirely or not at all: when one of its actions fails, the document is restored as it was
+     * before the batch (see BeginEditBatch).
      * Only available for Emscripten-based compiles
      **/
     bool Edit(const std::string &json_editorAction);
 
+    /**
+     * Return the pages changed by the last array of editor actions and the page count as a JSON string, for
+     * example {"changedPages": [2, 3], "pageCount": 5}. The pages are numbered from 1.
+     * Only available for Emscripten-based compiles
+     **/
+    std::string GetEditInfo();
+
     /**
      * Concatenates the vrv::logBuffer into a string an returns it.
      * This is used only for Emscripten-based compilation.
@@ -101,12 +125,33 @@ public:
      */
     std::string RenderToSvg(int pageNo = 1, bool xml_declaration = false);
 
+    /**
+     * Render only the horizontal range [x1, x2] of the page in SVG and return it as a string.
+     * The range is in page units, i.e., as the width of the page returned by RenderToSvg before scaling.
+     * Only the measures intersecting the range and the spanning elements crossing into it are drawn,
+     * which is mostly useful for scrolling through a document rendered with noLayout.
+     * Page number is 1-based
+     */
+    std::string RenderToSvgRange(int pageNo, int x1, int x2, bool xml_declaration = false);
+
+    /**
+     * Render the measures from startId to endId (on the same page) in SVG and return it as a string.
+     * Unlike with Toolkit::RenderToSvgRange, the neighbouring measures are not drawn even if their content sticks out
+     * into the range.
+     */
+    std::string RenderMeasuresToSvg(const std::string &startId, const std::string &endId, bool xml_declaration = false);
+
     /**
      * Render the page in SVG and save it to the file.
      * Page number is 1-based.
      */
     bool RenderToSvgFile(const std::string &filename, int pageNo = 1);
 
+    /**
+     * Render all the pages in SVG and return them in one call.
+     */
+    std::vector<std::string> RenderAllToSvg(bool xml_declaration = false);
+
     /**
      * Creates a midi file, opens it, and writes to it.
      * currently generates a dummy midi file.
@@ -118,6 +163,11 @@ public:
      */
     std::string RenderToMidi();
 
+    /**
+     * Creates a midi file and returns its binary content without encoding it.
+     */
+    std::string RenderToMidiData();
+
     const char *GetHumdrumBuffer();
     void SetHumdrumBuffer(const char *contents);
 
@@ -145,9 +195,20 @@ public:
      * Redo the layout of the loaded data.
      * This can be called once the rendering option were changed,
      * For example with a new page (sceen) height or a new zoom level.
+     * The horizontal layout of the measures is reused unless the content or the font was changed. Only the measures of
+     * the pages rendered since the previous layout are aligned again.
      */
     void RedoLayout();
 
+    /**
+     * Return the system and page breaks of the loaded data for a list of page widths as a JSON string.
+     * The page widths are given as a JSON array, for example [1500, 2100].
+     * For each width, the pages are given with the id of the first measure of each system.
+     * The horizontal layout of the measures is done only once and shared by all the widths.
+     * The layout for the current page width is restored afterwards.
+     */
+    std::string GetLayoutBreaks(const std::string &json_pageWidths);
+
     /**
      * Redo the layout of the pitch postitions of the current drawing page.
      * Only the note vertical positions are recalculated with this method.
@@ -172,11 +233,15 @@ public:
     /**
     * @name Set and get a std::string into a char * buffer.
     * This is used for returning a string buffer to emscripten.
-    * The buffer is freed when reset or in MusController destructor.
+    * The string is kept by the Toolkit, which takes it over without copying it when it is moved in (e.g., the
+    * return value of RenderToSvg), and only the last one is held.
+    * It remains valid until the next call to SetCString or the Toolkit destructor.
+    * GetCStringLength returns the size of the data, which can contain null bytes (e.g., binary MIDI).
     */
     ///@{
-    void SetCString(const std::string &data);
+    void SetCString(std::string data);
     const char *GetCString();
+    size_t GetCStringLength();
     ///@}
 
     /**
@@ -279,6 +344,25 @@ public:
     int GetEvenNoteSpacing() { return m_evenNoteSpacing; }
     ///@}
 
+    /**
+     * @name Reuse the horizontal layout of the measures calculated for the cast-off when rendering the pages
+     */
+    ///@{
+    void SetReuseLayout(bool r) { m_reuseLayout = r; }
+    int GetReuseLayout() { return m_reuseLayout; }
+    ///@}
+
+    /**
+     * @name Directory where the laid-out documents are cached
+     * When set, a snapshot of the document is saved after the layout and is loaded instead of the data when the same
+     * data is loaded again with the same layout options. An empty path disables the cache. The cache is not used
+     * without layout, when the layout of the cast-off is reused, or for the Humdrum output.
+     */
+    ///@{
+    void SetLayoutCache(std::string const &path) { m_layoutCache = path; }
+    std::string GetLayoutCache() { return m_layoutCache; }
+    ///@}
+
     /**
      * @name Do not justify the system (for debugging purposes)
      */
@@ -295,6 +379,26 @@ public:
     int GetShowBoundingBoxes() { return m_showBoundingBoxes; }
     ///@}
 
+    /**
+     * @name Collect the time spent and the number of nodes visited in each processing phase
+     * Enabling it resets the values previously collected.
+     */
+    ///@{
+    void SetProfile(bool p) { m_profiler.Enable(p); }
+    int GetProfile() { return m_profiler.IsEnabled(); }
+    ///@}
+
+    /**
+     * Return the profiling report as a JSON string.
+     * The report contains the values collected since the profiling was enabled.
+     */
+    std::string GetProfileReport() { return m_profiler.GetJSON(); }
+
+    /**
+     * Return the profiler of the toolkit, for example for getting the time of a phase.
+     */
+    Profiler *GetProfiler() { return &m_profiler; }
+
     /**
      * @name Get the input file format (defined as FileFormat)
      * The SetFormat with FileFormat does not perform any validation
@@ -346,6 +450,27 @@ public:
     std::string GetMdivXPathQuery() { return m_mdivXPathQuery; };
     ///@}
 
+    /**
+     * @name Set and get the range of measures to load (MEI only)
+     * The range is given as "N1-N2" or "N" with the @n of the first and last measure.
+     * Only the measures in the range are loaded and laid out.
+     * Humdrum input is converted to MEI and is supported. The range is ignored with a warning for the other formats.
+     */
+    ///@{
+    bool SetMeasureRange(std::string const &range);
+    std::string GetMeasureRange();
+    ///@}
+
+    /**
+     * @name Set and get the staves to load (MEI only)
+     * The staves are given as a comma-separated list of @n, e.g., "1,3".
+     * As for the measure range, the selection is ignored with a warning for the formats not converted to MEI.
+     */
+    ///@{
+    bool SetStaffSelection(std::string const &staves);
+    std::string GetStaffSelection();
+    ///@}
+
     /**
      * @name Set and get the xPath query for selecting <app> (if any)
      */
@@ -356,6 +481,7 @@ public:
 
     /**
      * @name Set a specific font
+     * The font is changed for this toolkit only. The loaded fonts are shared by the toolkits (see Resources).
      */
     ///@{
     bool SetFont(std::string const &font);
@@ -378,10 +504,54 @@ public:
     bool Set(std::string elementId, std::string attrType, std::string attrValue);
     ///@}
 
+    /**
+     * @name Perform several editor actions as one batch
+     * BeginEditBatch keeps the content and the layout of the document as a score-based MEI snapshot. EndEditBatch
+     * prepares the drawing and redoes the layout once for all the actions, or restores the document from the snapshot
+     * when one of them failed, since an action cannot always be undone (e.g., an attribute that was not set before).
+     */
+    ///@{
+    void BeginEditBatch();
+    void EndEditBatch(bool restore);
+    ///@}
+
 private:
     bool IsUTF16(const std::string &filename);
     bool LoadUTF16File(const std::string &filename);
 
+    /**
+     * Render the page (0-based) in SVG, restricted to the range [x1, x2] unless x1 is VRV_UNSET
+     */
+    std::string RenderPageToSvg(int pageIdx, int x1, int x2, bool xml_declaration);
+
+    /**
+     * Render the page set in the view in SVG, restricted to the range [x1, x2] unless x1 is VRV_UNSET
+     */
+    std::string RenderCurrentPageToSvg(int x1, int x2, bool xml_declaration);
+
+    /**
+     * Import the data with the input and lay out the document. The input is deleted.
+     * The data is imported from the buffer if one is given and from the string otherwise.
+     * The document is cast off with the system sizes if given, which is the case for a layout snapshot.
+     */
+    bool ImportInput(FileInputStream *input, const std::string &data, char *buffer = NULL, size_t length = 0,
+        const std::vector<std::vector<int> > *snapshotSystemSizes = NULL);
+
+    /**
+     * @name Methods for the layout cache
+     * The key is a hash of the data and of the options affecting the layout. The snapshot is the score-based MEI of
+     * the document preceded by the number of elements of each system by page and by the Humdrum buffer (if the data
+     * was imported from Humdrum). Loading it skips the conversion of the data and the layout of the systems, and fails
+     * if the snapshot does not exist, was written by another version or is truncated or corrupted. A snapshot that
+     * cannot be loaded is removed so the next load writes it again.
+     */
+    ///@{
+    std::string GetSnapshotKey(const char *data, size_t length);
+    std::string GetSnapshotFilename(const std::string &key);
+    bool LoadSnapshot(const std::string &key);
+    bool SaveSnapshot(const std::string &key, bool withHumdrumBuffer);
+    ///@}
+
 protected:
 #ifdef USE_EMSCRIPTEN
     /**
@@ -391,9 +561,26 @@ protected:
     bool ParseDragAction(jsonxx::Object param, std::string *elementId, int *x, int *y);
     bool ParseInsertAction(jsonxx::Object param, std::string *elementType, std::string *startid, std::string *endid);
     bool ParseSetAction(jsonxx::Object param, std::string *elementId, std::string *attrType, std::string *attrValue);
+    bool EditAction(jsonxx::Object action);
+    bool EditBatch(jsonxx::Array actions);
 ///@}
 #endif
 
+    /**
+     * Keep the measure of an element modified by an editor action performed within a batch
+     */
+    void AddEditedElement(Object *element);
+
+    /**
+     * Return the first measure of each system and the last measure of each page, for comparing layouts
+     */
+    std::vector<std::vector<Object *> > GetLayoutMeasures();
+
+    /**
+     * Return the number of elements of each system by page, for casting off a snapshot of the document
+     */
+    std::vector<std::vector<int> > GetSystemSizes();
+
 public:
     //
 private:
@@ -417,16 +604,41 @@ private:
     std::vector<std::string> m_appXPathQueries;
     std::vector<std::string> m_choiceXPathQueries;
     std::string m_mdivXPathQuery;
+    int m_measureRangeFirst;
+    int m_measureRangeLast;
+    std::vector<int> m_staffSelection;
     bool m_scoreBasedMei;
     bool m_evenNoteSpacing;
+    bool m_reuseLayout;
+    std::string m_layoutCache;
     float m_spacingLinear;
     float m_spacingNonLinear;
     // for debugging
     bool m_noJustification;
     bool m_showBoundingBoxes;
 
-    static char *m_humdrumBuffer;
-    char *m_cString;
+    std::string m_humdrumBuffer;
+    std::string m_cString;
+
+    /**
+     * The state of the batch of editor actions being performed and the JSON info of the last one
+     */
+    ///@{
+    bool m_editBatch;
+    bool m_editPrepareDrawing;
+    std::set<Object *> m_editedMeasures;
+    std::vector<std::vector<Object *> > m_editPreviousLayout;
+    std::string m_editSnapshot;
+    std::vector<std::vector<int> > m_editSnapshotSystemSizes;
+    int m_editSnapshotPageIdx;
+    std::string m_editInfo;
+    ///@}
+
+    /** The resource path and the fonts of the toolkit, bound to the thread within its methods */
+    ResourceSet m_resources;
+
+    /** The profiler bound to the thread within the methods of the toolkit */
+    Profiler m_profiler;
 };
 
 } // namespace vrv
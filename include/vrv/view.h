@@ -143,6 +143,19 @@ public:
      */
     double GetPPUFactor() const;
 
+    /**
+     * @name Restrict the drawing to the measures intersecting the horizontal range [x1, x2] (logical coordinates).
+     * Time spanning elements crossing into the range from the left are also drawn.
+     * With barLines, the range is given by the bar lines of measures and only the measures within it are drawn,
+     * whatever their content sticking out.
+     * Defined in view_page.cpp
+     */
+    ///@{
+    void SetDrawingClipX(int x1, int x2, bool barLines = false);
+    void ResetDrawingClipX();
+    bool HasDrawingClipX() const { return (m_drawingClipX1 != VRV_UNSET); }
+    ///@}
+
     /**
      * @name Methods for calculating drawing positions
      * Defined in view_element.cpp
@@ -179,6 +192,17 @@ protected:
     void DrawLayerList(DeviceContext *dc, Layer *layer, Staff *staff, Measure *measure, const ClassId classId);
     ///@}
 
+    /**
+     * @name Methods for the clipped drawing (see View::SetDrawingClipX)
+     * Defined in view_page.cpp
+     */
+    ///@{
+    bool IsInDrawingClipX(Measure *measure);
+    void DrawClippedMeasureSpanning(DeviceContext *dc, Measure *measure, System *system);
+    /** Tie attributes and lyric connectors, only looked for in the measure preceding the range */
+    void DrawClippedMeasureConnectors(DeviceContext *dc, Measure *measure, System *system);
+    ///@}
+
     /**
      * @name Methods for drawing children
      * Defined in view_page.cpp
@@ -448,6 +472,8 @@ private:
         Point *p1, Point *p2, Point *c1, Point *c2, curvature_CURVEDIR curveDir, int height, int staffSize);
     void GetSpanningPointPositions(ArrayOfLayerElementPointPairs *spanningPoints, Point p1, float angle,
         curvature_CURVEDIR curveDir, int staffSize);
+    void CalcBezierAtSpanningPoints(
+        const Point bezier[4], ArrayOfLayerElementPointPairs *spanningPoints, std::vector<int> &curveYs);
     ///@}
 
     /**
@@ -494,11 +520,25 @@ protected:
      */
     ScoreDef m_drawingScoreDef;
 
+    /**
+     * The horizontal range to which the drawing is restricted (VRV_UNSET for none)
+     */
+    ///@{
+    int m_drawingClipX1;
+    int m_drawingClipX2;
+    bool m_drawingClipBarLines;
+    ///@}
+
+    /**
+     * The y positions of a slur curve at its spanning points, reused from one slur to the other
+     */
+    std::vector<int> m_slurCurveYs;
+
 private:
-    /** @name Internal values for storing temporary values for ligatures */
+    /** @name Internal values for storing temporary values for ligatures (for each thread since they are static) */
     ///@{
-    static int s_drawingLigX[2], s_drawingLigY[2];
-    static bool s_drawingLigObliqua;
+    static thread_local int s_drawingLigX[2], s_drawingLigY[2];
+    static thread_local bool s_drawingLigObliqua;
     ///@}
 };
 
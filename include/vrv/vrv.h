@@ -8,8 +8,10 @@
 #ifndef __VRV_H__
 #define __VRV_H__
 
+#include <atomic>
 #include <cstring>
 #include <map>
+#include <mutex>
 #include <stdarg.h>
 #include <stdio.h>
 #include <string>
@@ -25,6 +27,7 @@ namespace vrv {
 
 class Glyph;
 class Object;
+class ResourceSet;
 
 /**
  * The following functions are helpers for formatting, conversion, or logging.
@@ -42,7 +45,8 @@ void DisableLog();
  */
 #ifdef EMSCRIPTEN
 enum consoleLogLevel { CONSOLE_LOG = 0, CONSOLE_INFO, CONSOLE_WARN, CONSOLE_ERROR };
-extern std::vector<std::string> logBuffer;
+// The log buffer is for each thread so that the messages of a toolkit are not mixed with the ones of another thread
+extern thread_local std::vector<std::string> logBuffer;
 bool LogBufferContains(std::string s);
 void AppendLogBuffer(bool checkDuplicate, std::string message, consoleLogLevel level);
 #endif
@@ -119,39 +123,126 @@ bool Check(Object *object);
 /**
  * This class provides static resource values.
  * The default values can be changed by setters.
+ * The fonts are shared by all the toolkits of the process and can be used from several threads. A font is loaded
+ * once for a resource path and is not modified afterwards. Changing the font (or the path) changes the font for all
+ * toolkits, but the glyphs returned before remain valid.
  */
 
 class Resources {
 public:
+    struct LoadedFont;
+
     /**
      * @name Setters and getters for static environment variables
+     * They are the ones of the ResourceSet bound to the thread (see ResourcesScope), if any, and otherwise the ones
+     * of the process.
      */
     ///@{
     /** Resource path */
-    static std::string GetPath() { return m_path; }
-    static void SetPath(std::string path) { m_path = path; }
+    static std::string GetPath();
+    static void SetPath(std::string path);
     /** Init the SMufL music and text fonts */
     static bool InitFonts();
-    /** Init the text font (bounding boxes and ASCII only) */
+    /** Init the text font (bounding boxes and ASCII / Latin-1 only) */
     static bool InitTextFont();
     /** Select a particular font */
     static bool SetFont(std::string fontName);
+    /** The name of the current font */
+    static std::string GetFontName();
     /** Returns the glyph (if exists) for the current SMuFL font */
     static Glyph *GetGlyph(wchar_t smuflCode);
-    /** Returns the glyph (if exists) for the text font (bounding box and ASCII only) */
+    /** Returns the glyph (if exists) for the text font (bounding box and ASCII / Latin-1 only) */
     static Glyph *GetTextGlyph(wchar_t code);
     ///@}
 
+    /**
+     * Return a number increased each time a font of the process or of a ResourceSet is changed.
+     * The values calculated with the fonts (e.g., text extents) store it and are recalculated when it changed.
+     */
+    static int GetFontGeneration() { return m_fontGeneration; }
+
+    /**
+     * @name Init the fonts and select a font of a ResourceSet
+     * They are loaded from the path of the set, or from the path of the process if it has none.
+     */
+    ///@{
+    static bool InitFonts(ResourceSet *resources);
+    static bool SetFont(ResourceSet *resources, std::string fontName);
+    ///@}
+
+    /**
+     * Bind the ResourceSet to the thread (NULL for the ones of the process) and return the previous one.
+     * See ResourcesScope.
+     */
+    static const ResourceSet *SetCurrent(const ResourceSet *resources);
+
 private:
-    static bool LoadFont(std::string fontName);
+    /**
+     * @name Return the fonts loaded from a path, loading them the first time
+     * The caller has to lock the mutex.
+     */
+    ///@{
+    static LoadedFont *GetDefaultFont(const std::string &path);
+    static LoadedFont *GetFont(const std::string &path, const std::string &fontName);
+    static LoadedFont *GetTextFont(const std::string &path);
+    ///@}
+
+    static bool LoadFont(const std::string &path, std::string fontName, LoadedFont *font);
 
 private:
     /** The path to the resources directory (e.g., for the svg/ subdirectory with fonts as XML */
     static std::string m_path;
-    /** The loaded SMuFL font */
-    static std::map<wchar_t, Glyph> m_font;
+    /** The fonts loaded by path and name - they are never modified or removed once loaded */
+    static std::map<std::string, LoadedFont *> m_loadedFonts;
+    /** The current SMuFL font */
+    static std::atomic<LoadedFont *> m_font;
     /** A text font used for bounding box calculations */
-    static std::map<wchar_t, Glyph> m_textFont;
+    static std::atomic<LoadedFont *> m_textFont;
+    /** The mutex for the path and the loading of the fonts */
+    static std::recursive_mutex m_mutex;
+    /** See GetFontGeneration */
+    static std::atomic<int> m_fontGeneration;
+    /** The resources bound to the thread */
+    static thread_local const ResourceSet *s_current;
+};
+
+//----------------------------------------------------------------------------
+// ResourceSet
+//----------------------------------------------------------------------------
+
+/**
+ * This class holds the resources of a toolkit, i.e., a resource path and the fonts loaded from it.
+ * They are used instead of the ones of the process within the methods of the toolkit, so that toolkits with
+ * different paths or fonts can be used at the same time. A path that is empty or a font that is not set falls back
+ * on the one of the process.
+ */
+class ResourceSet {
+public:
+    ResourceSet()
+    {
+        m_font = NULL;
+        m_textFont = NULL;
+    }
+
+    std::string m_path;
+    Resources::LoadedFont *m_font;
+    Resources::LoadedFont *m_textFont;
+};
+
+//----------------------------------------------------------------------------
+// ResourcesScope
+//----------------------------------------------------------------------------
+
+/**
+ * This class binds a ResourceSet to the thread for its lifetime and restores the previous one afterwards.
+ */
+class ResourcesScope {
+public:
+    ResourcesScope(const ResourceSet *resources) { m_previous = Resources::SetCurrent(resources); }
+    ~ResourcesScope() { Resources::SetCurrent(m_previous); }
+
+private:
+    const ResourceSet *m_previous;
 };
 
 //----------------------------------------------------------------------------
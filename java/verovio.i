@@ -13,14 +13,21 @@
 // Method to ignore
 %ignore vrv::Toolkit::GetShowBoundingBoxes( );
 %ignore vrv::Toolkit::GetCString( );
+%ignore vrv::Toolkit::GetCStringLength( );
 %ignore vrv::Toolkit::GetLogString( );
+%ignore vrv::Toolkit::LoadData( char *, size_t );
 %ignore vrv::Toolkit::ParseOptions( const std::string & );
+%ignore vrv::Toolkit::RenderToMidiData( );
 %ignore vrv::Toolkit::ResetLogBuffer( );
 %ignore vrv::Toolkit::SetShowBoundingBoxes( bool );
 %ignore vrv::Toolkit::SetCString( const std::string & );
 
 %module verovio
 %include "std_string.i"
+%include "std_vector.i"
+
+%template(StringVector) std::vector<std::string>;
+
 %include "../include/vrv/toolkit.h"
 
 
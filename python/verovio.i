@@ -11,14 +11,29 @@
 // Method to ignore
 %ignore vrv::Toolkit::GetShowBoundingBoxes( );
 %ignore vrv::Toolkit::GetCString( );
+%ignore vrv::Toolkit::GetCStringLength( );
 %ignore vrv::Toolkit::GetLogString( );
+%ignore vrv::Toolkit::LoadData( char *, size_t );
 //%ignore vrv::Toolkit::ParseOptions( const std::string & );
 %ignore vrv::Toolkit::ResetLogBuffer( );
 %ignore vrv::Toolkit::SetShowBoundingBoxes( bool );
 %ignore vrv::Toolkit::SetCString( const std::string & );
 
-%module verovio
+// Release the GIL in the wrapped methods so toolkits can be used from several threads in parallel
+// The state shared by the toolkits is thread-safe: the fonts (see vrv::Resources) are loaded once and not modified
+// afterwards, and the profiler and the log buffer (Emscripten only) are for each thread.
+%module(threads="1") verovio
 %include "std_string.i"
+%include "std_vector.i"
+
+%template(StringVector) std::vector<std::string>;
+
+// Return the MIDI data as bytes
+%typemap(out) std::string RenderToMidiData
+%{
+    $result = PyBytes_FromStringAndSize($1.data(), $1.size());
+%}
+
 %include "../include/vrv/toolkit.h"
 
 
@@ -52,17 +52,20 @@ void BBoxDeviceContext::StartGraphic(Object *object, std::string gClass, std::st
     // add the object object
     object->BoundingBox::ResetBoundingBox();
     m_objects.push_back(object);
+    PushContentBB();
 }
 
 void BBoxDeviceContext::ResumeGraphic(Object *object, std::string gId)
 {
     m_objects.push_back(object);
+    PushContentBB();
 }
 
 void BBoxDeviceContext::EndGraphic(Object *object, View *view)
 {
     // detach the object
     assert(m_objects.back() == object);
+    PopContentBB();
     m_objects.pop_back();
 }
 
@@ -70,6 +73,7 @@ void BBoxDeviceContext::EndResumedGraphic(Object *object, View *view)
 {
     // detach the object
     assert(m_objects.back() == object);
+    PopContentBB();
     m_objects.pop_back();
 }
 
@@ -322,20 +326,66 @@ void BBoxDeviceContext::UpdateBB(int x1, int y1, int x2, int y2, wchar_t glyph)
 
     // we need to store logical coordinates in the objects, we need to convert them back (this is why we need a View
     // object)
+    x1 = m_view->ToLogicalX(x1);
+    x2 = m_view->ToLogicalX(x2);
+    y1 = m_view->ToLogicalY(y1);
+    y2 = m_view->ToLogicalY(y2);
+
     if (!m_isDeactivatedX) {
-        (m_objects.back())->UpdateSelfBBoxX(m_view->ToLogicalX(x1), m_view->ToLogicalX(x2));
+        (m_objects.back())->UpdateSelfBBoxX(x1, x2);
         if (glyph != 0) (m_objects.back())->SetBoundingBoxGlyph(glyph, m_fontStack.top()->GetPointSize());
     }
     if (!m_isDeactivatedY) {
-        (m_objects.back())->UpdateSelfBBoxY(m_view->ToLogicalY(y1), m_view->ToLogicalY(y2));
+        (m_objects.back())->UpdateSelfBBoxY(y1, y2);
         if (glyph != 0) (m_objects.back())->SetBoundingBoxGlyph(glyph, m_fontStack.top()->GetPointSize());
     }
 
-    int i;
-    // Stretch the content BB of the other objects
-    for (i = 0; i < (int)m_objects.size(); i++) {
-        if (!m_isDeactivatedX) (m_objects.at(i))->UpdateContentBBoxX(m_view->ToLogicalX(x1), m_view->ToLogicalX(x2));
-        if (!m_isDeactivatedY) (m_objects.at(i))->UpdateContentBBoxY(m_view->ToLogicalY(y1), m_view->ToLogicalY(y2));
+    // Stretch the content BB of the object - it will be merged into the parent objects when the graphic ends
+    ContentBB &contentBB = m_contentBBs.back();
+    if (!m_isDeactivatedX) {
+        contentBB.m_x1 = std::min(contentBB.m_x1, std::min(x1, x2));
+        contentBB.m_x2 = std::max(contentBB.m_x2, std::max(x1, x2));
+    }
+    if (!m_isDeactivatedY) {
+        contentBB.m_y1 = std::min(contentBB.m_y1, std::min(y1, y2));
+        contentBB.m_y2 = std::max(contentBB.m_y2, std::max(y1, y2));
+    }
+}
+
+void BBoxDeviceContext::PushContentBB()
+{
+    ContentBB contentBB;
+    contentBB.m_x1 = -VRV_UNSET;
+    contentBB.m_x2 = VRV_UNSET;
+    contentBB.m_y1 = -VRV_UNSET;
+    contentBB.m_y2 = VRV_UNSET;
+    m_contentBBs.push_back(contentBB);
+}
+
+void BBoxDeviceContext::PopContentBB()
+{
+    assert(!m_contentBBs.empty());
+    assert(m_contentBBs.size() == m_objects.size());
+
+    ContentBB contentBB = m_contentBBs.back();
+    m_contentBBs.pop_back();
+
+    // Update the content BB of the object once with everything drawn since the graphic was started or resumed
+    bool hasX = (contentBB.m_x1 <= contentBB.m_x2);
+    bool hasY = (contentBB.m_y1 <= contentBB.m_y2);
+    if (hasX) (m_objects.back())->UpdateContentBBoxX(contentBB.m_x1, contentBB.m_x2);
+    if (hasY) (m_objects.back())->UpdateContentBBoxY(contentBB.m_y1, contentBB.m_y2);
+
+    // And stretch the one of the parent object
+    if (m_contentBBs.empty()) return;
+    ContentBB &parentBB = m_contentBBs.back();
+    if (hasX) {
+        parentBB.m_x1 = std::min(parentBB.m_x1, contentBB.m_x1);
+        parentBB.m_x2 = std::max(parentBB.m_x2, contentBB.m_x2);
+    }
+    if (hasY) {
+        parentBB.m_y1 = std::min(parentBB.m_y1, contentBB.m_y1);
+        parentBB.m_y2 = std::max(parentBB.m_y2, contentBB.m_y2);
     }
 }
 
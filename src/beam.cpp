@@ -574,7 +574,7 @@ BeamElementCoord::~BeamElementCoord()
 
 int Beam::CalcStem(FunctorParams *functorParams)
 {
-    CalcStemParams *params = dynamic_cast<CalcStemParams *>(functorParams);
+    CalcStemParams *params = static_cast<CalcStemParams *>(functorParams);
     assert(params);
 
     ListOfObjects *beamChildren = this->GetList(this);
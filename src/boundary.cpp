@@ -86,7 +86,7 @@ void BoundaryStartInterface::ConvertToPageBasedBoundary(Object *object, Object *
 
 int BoundaryEnd::PrepareBoundaries(FunctorParams *functorParams)
 {
-    PrepareBoundariesParams *params = dynamic_cast<PrepareBoundariesParams *>(functorParams);
+    PrepareBoundariesParams *params = static_cast<PrepareBoundariesParams *>(functorParams);
     assert(params);
 
     // We set its pointer to the last measure we have encountered - this can be NULL in case no measure exists before
@@ -116,7 +116,7 @@ int BoundaryEnd::ResetDrawing(FunctorParams *functorParams)
 
 int BoundaryEnd::CastOffSystems(FunctorParams *functorParams)
 {
-    CastOffSystemsParams *params = dynamic_cast<CastOffSystemsParams *>(functorParams);
+    CastOffSystemsParams *params = static_cast<CastOffSystemsParams *>(functorParams);
     assert(params);
 
     // Since the functor returns FUNCTOR_SIBLINGS we should never go lower than the system children
@@ -139,7 +139,7 @@ int BoundaryEnd::CastOffSystems(FunctorParams *functorParams)
 
 int BoundaryEnd::PrepareFloatingGrps(FunctorParams *functorParams)
 {
-    PrepareFloatingGrpsParams *params = dynamic_cast<PrepareFloatingGrpsParams *>(functorParams);
+    PrepareFloatingGrpsParams *params = static_cast<PrepareFloatingGrpsParams *>(functorParams);
     assert(params);
 
     assert(this->GetStart());
@@ -160,7 +160,7 @@ int BoundaryEnd::PrepareFloatingGrps(FunctorParams *functorParams)
 
 int BoundaryStartInterface::InterfacePrepareBoundaries(FunctorParams *functorParams)
 {
-    PrepareBoundariesParams *params = dynamic_cast<PrepareBoundariesParams *>(functorParams);
+    PrepareBoundariesParams *params = static_cast<PrepareBoundariesParams *>(functorParams);
     assert(params);
 
     // We have to be in a boundary start element
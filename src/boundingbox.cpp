@@ -10,8 +10,17 @@
 //----------------------------------------------------------------------------
 
 #include <assert.h>
+#include <climits>
 #include <math.h>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define VRV_EXTENTS_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define VRV_EXTENTS_SSE2
+#endif
+
 //----------------------------------------------------------------------------
 
 #include "devicecontextbase.h"
@@ -20,12 +29,8 @@
 #include "glyph.h"
 #include "vrv.h"
 
-#define BEZIER_APPROXIMATION 50.0
-
 namespace vrv {
 
-int BoundingBox::s_deCasteljau[4][4];
-
 //----------------------------------------------------------------------------
 // BoundingBox
 //----------------------------------------------------------------------------
@@ -695,39 +700,37 @@ Point BoundingBox::CalcPositionAfterRotation(Point point, float rot_alpha, Point
     return point;
 }
 
-/*
-int BoundingBox::CalcBezierAtPosition(const Point bezier[4], int x) {
-
-    Point P;
-    double t = 0.0;
-    // avoid division by 0
-    if (bezier[3].x != bezier[0].x) t = (double)(x - bezier[0].x) / (double)(bezier[3].x - bezier[0].x);
-    t = std::min(1.0, std::max(0.0, t));
-
-    P.y = pow((1 - t), 3) * bezier[0].y + 3 * t * pow((1 -t), 2) * bezier[1].y + 3 * (1-t) * pow(t, 2)* bezier[2].y +
-pow (t, 3)* bezier[3].y;
-    LogDebug("%f - %d - %d", t, x, P.y);
-    return P.y;
-}
-*/
-
 int BoundingBox::CalcBezierAtPosition(const Point bezier[4], int x)
 {
-    int i, j;
-    double t = 0.0;
-    // avoid division by 0
-    if (bezier[3].x != bezier[0].x) t = (double)(x - bezier[0].x) / (double)(bezier[3].x - bezier[0].x);
-    t = std::min(1.0, std::max(0.0, t));
-    int n = 4;
-
-    for (i = 0; i < n; i++) BoundingBox::s_deCasteljau[0][i] = bezier[i].y;
-    for (j = 1; j < n; j++) {
-        for (int i = 0; i < 4 - j; i++) {
-            BoundingBox::s_deCasteljau[j][i]
-                = BoundingBox::s_deCasteljau[j - 1][i] * (1 - t) + BoundingBox::s_deCasteljau[j - 1][i + 1] * t;
-        }
+    int y;
+    BoundingBox::CalcBezierAtPositions(bezier, &x, &y, 1);
+    return y;
+}
+
+void BoundingBox::CalcBezierAtPositions(const Point bezier[4], const int *xs, int *ys, int count)
+{
+    const int y0 = bezier[0].y;
+    const int y1 = bezier[1].y;
+    const int y2 = bezier[2].y;
+    const int y3 = bezier[3].y;
+
+    const int x0 = bezier[0].x;
+    const double width = bezier[3].x - bezier[0].x;
+
+    for (int i = 0; i < count; ++i) {
+        double t = 0.0;
+        // avoid division by 0
+        if (width != 0.0) t = (double)(xs[i] - x0) / width;
+        t = std::min(1.0, std::max(0.0, t));
+        double mt = 1.0 - t;
+        // De Casteljau with each level of the interpolation kept as int
+        int q0 = y0 * mt + y1 * t;
+        int q1 = y1 * mt + y2 * t;
+        int q2 = y2 * mt + y3 * t;
+        int r0 = q0 * mt + q1 * t;
+        int r1 = q1 * mt + q2 * t;
+        ys[i] = r0 * mt + r1 * t;
     }
-    return BoundingBox::s_deCasteljau[n - 1][0];
 }
 
 void BoundingBox::CalcThickBezier(
@@ -770,61 +773,41 @@ void BoundingBox::CalcThickBezier(
 void BoundingBox::ApproximateBezierBoundingBox(
     const Point bezier[4], Point &pos, int &width, int &height, int &minYPos, int &maxYPos)
 {
-    int ax = bezier[0].x;
-    int ay = bezier[0].y;
-    int bx = bezier[1].x;
-    int by = bezier[1].y;
-    int cx = bezier[2].x;
-    int cy = bezier[2].y;
-    int dx = bezier[3].x;
-    int dy = bezier[3].y;
-
-    double px, py, qx, qy, rx, ry, sx, sy, tx, ty, tobx, toby, tocx, tocy, todx, tody, toqx, toqy, torx, tory, totx,
-        toty;
-    int x, y, minx, miny, maxx, maxy;
+    // The extrema are at the ends or at the roots of the derivative in x or in y within the curve
+    double params[6];
+    int count = 0;
+    params[count++] = 0.0;
+    count += BoundingBox::CalcBezierDerivativeRoots(bezier[0].x, bezier[1].x, bezier[2].x, bezier[3].x, params + count);
+    count += BoundingBox::CalcBezierDerivativeRoots(bezier[0].y, bezier[1].y, bezier[2].y, bezier[3].y, params + count);
+    params[count++] = 1.0;
+    // In the order of the curve for the positions of the extrema in y
+    for (int i = 2; i < count - 1; ++i) {
+        for (int j = i; (j > 1) && (params[j - 1] > params[j]); --j) std::swap(params[j - 1], params[j]);
+    }
 
+    int minx, miny, maxx, maxy;
     minx = miny = -VRV_UNSET;
     maxx = maxy = VRV_UNSET;
 
-    tobx = bx - ax;
-    toby = by - ay; // directions
-    tocx = cx - bx;
-    tocy = cy - by;
-    todx = dx - cx;
-    tody = dy - cy;
-    double step = 1.0 / BEZIER_APPROXIMATION;
-    int i;
-    for (i = 0; i < (int)(BEZIER_APPROXIMATION + 1.0); i++) {
-        double d = i * step;
-        px = ax + d * tobx;
-        py = ay + d * toby;
-        qx = bx + d * tocx;
-        qy = by + d * tocy;
-        rx = cx + d * todx;
-        ry = cy + d * tody;
-        toqx = qx - px;
-        toqy = qy - py;
-        torx = rx - qx;
-        tory = ry - qy;
-
-        sx = px + d * toqx;
-        sy = py + d * toqy;
-        tx = qx + d * torx;
-        ty = qy + d * tory;
-        totx = tx - sx;
-        toty = ty - sy;
-
-        x = sx + d * totx;
-        y = sy + d * toty;
+    for (int i = 0; i < count; ++i) {
+        double t = params[i];
+        double mt = 1.0 - t;
+        // Bernstein weights
+        double w0 = mt * mt * mt;
+        double w1 = 3.0 * mt * mt * t;
+        double w2 = 3.0 * mt * t * t;
+        double w3 = t * t * t;
+        int x = w0 * bezier[0].x + w1 * bezier[1].x + w2 * bezier[2].x + w3 * bezier[3].x;
+        int y = w0 * bezier[0].y + w1 * bezier[1].y + w2 * bezier[2].y + w3 * bezier[3].y;
         minx = std::min(minx, x);
         if (miny > y) {
             miny = y;
-            minYPos = (bezier[3].x - bezier[0].x) * d;
+            minYPos = (bezier[3].x - bezier[0].x) * t;
         }
         maxx = std::max(maxx, x);
         if (maxy < y) {
             maxy = y;
-            maxYPos = (bezier[3].x - bezier[0].x) * d;
+            maxYPos = (bezier[3].x - bezier[0].x) * t;
         }
     }
     pos.x = minx;
@@ -833,6 +816,35 @@ void BoundingBox::ApproximateBezierBoundingBox(
     height = maxy - miny;
 }
 
+int BoundingBox::CalcBezierDerivativeRoots(int p0, int p1, int p2, int p3, double roots[2])
+{
+    // The derivative is 3 * (qa * t^2 + qb * t + qc)
+    const double qa = -p0 + 3.0 * p1 - 3.0 * p2 + p3;
+    const double qb = 2.0 * (p0 - 2.0 * p1 + p2);
+    const double qc = p1 - p0;
+
+    double candidates[2];
+    int count = 0;
+    if (qa == 0.0) {
+        if (qb != 0.0) candidates[count++] = -qc / qb;
+    }
+    else {
+        double discriminant = qb * qb - 4.0 * qa * qc;
+        if (discriminant >= 0.0) {
+            double root = sqrt(discriminant);
+            candidates[count++] = (-qb + root) / (2.0 * qa);
+            candidates[count++] = (-qb - root) / (2.0 * qa);
+        }
+    }
+
+    // Only the roots within the curve
+    int inside = 0;
+    for (int i = 0; i < count; ++i) {
+        if ((candidates[i] > 0.0) && (candidates[i] < 1.0)) roots[inside++] = candidates[i];
+    }
+    return inside;
+}
+
 int BoundingBox::RectLeftOverlap(const Point rect1[2], const Point rect2[2], int margin, int vMargin)
 {
     if ((rect1[0].y < rect2[1].y - vMargin) || (rect1[1].y > rect2[0].y + vMargin)) return 0;
@@ -857,4 +869,88 @@ int BoundingBox::RectBottomOverlap(const Point rect1[2], const Point rect2[2], i
     return std::max(0, rect2[1].y - rect1[0].y + margin);
 }
 
+//----------------------------------------------------------------------------
+// HorizontalContentExtents
+//----------------------------------------------------------------------------
+
+void HorizontalContentExtents::Clear()
+{
+    m_lefts.clear();
+    m_rights.clear();
+}
+
+void HorizontalContentExtents::Add(const BoundingBox *box)
+{
+    assert(box);
+
+    if (box->HasContentBB()) {
+        m_lefts.push_back(box->GetContentLeft());
+        m_rights.push_back(box->GetContentRight());
+    }
+    // An empty extent, for which the overlap tests always fail
+    else {
+        m_lefts.push_back(INT_MAX);
+        m_rights.push_back(INT_MIN);
+    }
+}
+
+void HorizontalContentExtents::Add(const std::vector<BoundingBox *> &boxes)
+{
+    m_lefts.reserve(m_lefts.size() + boxes.size());
+    m_rights.reserve(m_rights.size() + boxes.size());
+    for (auto box : boxes) this->Add(box);
+}
+
+int HorizontalContentExtents::FindHorizontalContentOverlap(const BoundingBox *box, int start, int margin) const
+{
+    assert(box);
+
+    const int count = this->GetCount();
+    if (!box->HasContentBB()) return count;
+
+    // The box overlaps the extent i if right > m_lefts[i] and left < m_rights[i]
+    const int right = box->GetContentRight() + margin;
+    const int left = box->GetContentLeft() - margin;
+    const int *lefts = m_lefts.data();
+    const int *rights = m_rights.data();
+
+    int i = std::max(start, 0);
+    int mask = 0;
+#if defined(VRV_EXTENTS_AVX2)
+    const __m256i right8 = _mm256_set1_epi32(right);
+    const __m256i left8 = _mm256_set1_epi32(left);
+    for (; i + 8 <= count; i += 8) {
+        __m256i l = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lefts + i));
+        __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rights + i));
+        __m256i overlap = _mm256_and_si256(_mm256_cmpgt_epi32(right8, l), _mm256_cmpgt_epi32(r, left8));
+        mask = _mm256_movemask_ps(_mm256_castsi256_ps(overlap));
+        if (mask) break;
+    }
+#elif defined(VRV_EXTENTS_SSE2)
+    const __m128i right4 = _mm_set1_epi32(right);
+    const __m128i left4 = _mm_set1_epi32(left);
+    for (; i + 4 <= count; i += 4) {
+        __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lefts + i));
+        __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rights + i));
+        __m128i overlap = _mm_and_si128(_mm_cmpgt_epi32(right4, l), _mm_cmpgt_epi32(r, left4));
+        mask = _mm_movemask_ps(_mm_castsi128_ps(overlap));
+        if (mask) break;
+    }
+#endif
+    // The first bit set in the mask of the block found
+    if (mask) {
+        while (!(mask & 1)) {
+            mask >>= 1;
+            i++;
+        }
+        return i;
+    }
+
+    // Scalar version and remaining extents
+    for (; i < count; i++) {
+        if ((right > lefts[i]) && (left < rights[i])) return i;
+    }
+    return count;
+}
+
 } // namespace vrv
@@ -0,0 +1,281 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        c_wrapper.cpp
+// Author:      Rodolfo Zitellini
+// Created:     05/11/2013
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "c_wrapper.h"
+
+//----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <stdlib.h>
+#include <string.h>
+
+//----------------------------------------------------------------------------
+
+#include "toolkit.h"
+#include "vrv.h"
+
+//----------------------------------------------------------------------------
+
+using namespace vrv;
+
+/**
+ * Write the data into the buffer of the caller, growing it if necessary.
+ */
+static bool WriteToBuffer(const std::string &data, vrvBuffer *buffer)
+{
+    if (!buffer) return false;
+
+    if (data.size() + 1 > buffer->capacity) {
+        size_t capacity = std::max(data.size() + 1, buffer->capacity * 2);
+        char *grown = (char *)realloc(buffer->data, capacity);
+        // the buffer is left as it was, which the caller still owns
+        if (!grown) return false;
+        buffer->data = grown;
+        buffer->capacity = capacity;
+    }
+
+    // copy with the known length, which also preserves embedded null bytes (e.g., binary MIDI)
+    memcpy(buffer->data, data.data(), data.size());
+    buffer->data[data.size()] = '\0';
+    buffer->length = data.size();
+    return true;
+}
+
+extern "C" {
+
+void vrvBuffer_free(vrvBuffer *buffer)
+{
+    if (!buffer) return;
+    free(buffer->data);
+    buffer->data = NULL;
+    buffer->length = 0;
+    buffer->capacity = 0;
+}
+
+void *vrvToolkit_constructor()
+{
+#ifdef USE_EMSCRIPTEN
+    // set the resource path in the js blob
+    Resources::SetPath("/data");
+#endif
+
+    return new Toolkit();
+}
+
+void *vrvToolkit_constructorResourcePath(const char *resourcePath)
+{
+    Toolkit *tk = new Toolkit(false);
+    tk->SetResourcePath(resourcePath);
+
+    return tk;
+}
+
+void vrvToolkit_destructor(void *tkPtr)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    delete tk;
+}
+
+const char *vrvToolkit_getLog(void *tkPtr)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCString(tk->GetLogString());
+    return tk->GetCString();
+}
+
+const char *vrvToolkit_getVersion(void *tkPtr)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCString(tk->GetVersion());
+    return tk->GetCString();
+}
+
+int vrvToolkit_getPageCount(void *tkPtr)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    return tk->GetPageCount();
+}
+
+int vrvToolkit_getPageWithElement(void *tkPtr, const char *xmlId)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    return tk->GetPageWithElement(xmlId);
+}
+
+double vrvToolkit_getTimeForElement(void *tkPtr, const char *xmlId)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    return tk->GetTimeForElement(xmlId);
+}
+
+bool vrvToolkit_loadData(void *tkPtr, const char *data)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->ResetLogBuffer();
+    return tk->LoadData(data);
+}
+
+const char *vrvToolkit_getMEI(void *tkPtr, int page_no, bool score_based)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCString(tk->GetMEI(page_no, score_based));
+    return tk->GetCString();
+}
+
+const char *vrvToolkit_getHumdrum(void *tkPtr)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCString(tk->GetHumdrum());
+    return tk->GetCString();
+}
+
+const char *vrvToolkit_renderPage(void *tkPtr, int page_no, const char *c_options)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->ResetLogBuffer();
+    tk->SetCString(tk->RenderToSvg(page_no, false));
+    return tk->GetCString();
+}
+
+const char *vrvToolkit_renderPageRange(void *tkPtr, int page_no, int x1, int x2, const char *c_options)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->ResetLogBuffer();
+    tk->SetCString(tk->RenderToSvgRange(page_no, x1, x2, false));
+    return tk->GetCString();
+}
+
+const char *vrvToolkit_renderMeasures(void *tkPtr, const char *startId, const char *endId, const char *c_options)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->ResetLogBuffer();
+    tk->SetCString(tk->RenderMeasuresToSvg(startId, endId, false));
+    return tk->GetCString();
+}
+
+const char *vrvToolkit_renderToMidi(void *tkPtr, const char *c_options)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->ResetLogBuffer();
+    tk->SetCString(tk->RenderToMidi());
+    return tk->GetCString();
+}
+
+const char *vrvToolkit_renderToMidiData(void *tkPtr, const char *c_options)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->ResetLogBuffer();
+    tk->SetCString(tk->RenderToMidiData());
+    return tk->GetCString();
+}
+
+size_t vrvToolkit_getResultLength(void *tkPtr)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    return tk->GetCStringLength();
+}
+
+const char *vrvToolkit_getElementsAtTime(void *tkPtr, int millisec)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCString(tk->GetElementsAtTime(millisec));
+    return tk->GetCString();
+}
+
+void vrvToolkit_setOptions(void *tkPtr, const char *options)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    if (!tk->ParseOptions(options)) {
+        vrv::LogError("Could not load JSON options.");
+    }
+}
+
+void vrvToolkit_redoLayout(void *tkPtr)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->RedoLayout();
+}
+
+const char *vrvToolkit_getLayoutBreaks(void *tkPtr, const char *pageWidths)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCString(tk->GetLayoutBreaks(pageWidths));
+    return tk->GetCString();
+}
+
+void vrvToolkit_redoPagePitchPosLayout(void *tkPtr)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->RedoPagePitchPosLayout();
+}
+
+const char *vrvToolkit_renderData(void *tkPtr, const char *data, const char *options)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->ResetLogBuffer();
+    vrvToolkit_setOptions(tkPtr, options);
+    vrvToolkit_loadData(tkPtr, data);
+
+    return vrvToolkit_renderPage(tkPtr, 1, options);
+}
+
+bool vrvToolkit_edit(void *tkPtr, const char *editorAction)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    if (!tk->Edit(editorAction)) {
+        vrv::LogError("Could not perform editor action.");
+        return false;
+    }
+    return true;
+}
+
+const char *vrvToolkit_getEditInfo(void *tkPtr)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCString(tk->GetEditInfo());
+    return tk->GetCString();
+}
+
+const char *vrvToolkit_getElementAttr(void *tkPtr, const char *xmlId)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCString(tk->GetElementAttr(xmlId));
+    return tk->GetCString();
+}
+
+const char *vrvToolkit_getProfileReport(void *tkPtr)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCString(tk->GetProfileReport());
+    return tk->GetCString();
+}
+bool vrvToolkit_getHumdrumToBuffer(void *tkPtr, vrvBuffer *buffer)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    return WriteToBuffer(tk->GetHumdrum(), buffer);
+}
+
+bool vrvToolkit_getMEIToBuffer(void *tkPtr, int page_no, bool score_based, vrvBuffer *buffer)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    return WriteToBuffer(tk->GetMEI(page_no, score_based), buffer);
+}
+
+bool vrvToolkit_renderPageToBuffer(void *tkPtr, int page_no, const char *c_options, vrvBuffer *buffer)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->ResetLogBuffer();
+    return WriteToBuffer(tk->RenderToSvg(page_no, false), buffer);
+}
+
+bool vrvToolkit_renderToMidiDataToBuffer(void *tkPtr, const char *c_options, vrvBuffer *buffer)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->ResetLogBuffer();
+    return WriteToBuffer(tk->RenderToMidiData(), buffer);
+}
+} // extern "C"
@@ -318,7 +318,7 @@ Point Chord::GetStemDownNW(Doc *doc, int staffSize, bool graceSize)
 
 int Chord::CalcStem(FunctorParams *functorParams)
 {
-    CalcStemParams *params = dynamic_cast<CalcStemParams *>(functorParams);
+    CalcStemParams *params = static_cast<CalcStemParams *>(functorParams);
     assert(params);
 
     // Set them to NULL in any case
@@ -389,7 +389,7 @@ int Chord::CalcStem(FunctorParams *functorParams)
 
 int Chord::CalcDots(FunctorParams *functorParams)
 {
-    CalcDotsParams *params = dynamic_cast<CalcDotsParams *>(functorParams);
+    CalcDotsParams *params = static_cast<CalcDotsParams *>(functorParams);
     assert(params);
 
     if (!this->HasDots()) {
@@ -541,7 +541,7 @@ int Chord::PrepareLayerElementParts(FunctorParams *functorParams)
 
 int Chord::PrepareTieAttr(FunctorParams *functorParams)
 {
-    PrepareTieAttrParams *params = dynamic_cast<PrepareTieAttrParams *>(functorParams);
+    PrepareTieAttrParams *params = static_cast<PrepareTieAttrParams *>(functorParams);
     assert(params);
 
     assert(!params->m_currentChord);
@@ -552,7 +552,7 @@ int Chord::PrepareTieAttr(FunctorParams *functorParams)
 
 int Chord::PrepareTieAttrEnd(FunctorParams *functorParams)
 {
-    PrepareTieAttrParams *params = dynamic_cast<PrepareTieAttrParams *>(functorParams);
+    PrepareTieAttrParams *params = static_cast<PrepareTieAttrParams *>(functorParams);
     assert(params);
 
     assert(params->m_currentChord);
@@ -15,6 +15,7 @@
 
 //----------------------------------------------------------------------------
 
+#include "checked.h"
 #include "glyph.h"
 #include "vrv.h"
 
@@ -112,8 +113,14 @@ void DeviceContext::ReactivateGraphic()
 
 void DeviceContext::GetTextExtent(const std::string &string, TextExtend *extend)
 {
-    std::wstring wtext(string.begin(), string.end());
-    GetTextExtent(wtext, extend);
+    // Decode UTF-8 so that non-ASCII characters are not measured byte by byte
+    if (utf8::is_valid(string.begin(), string.end())) {
+        GetTextExtent(UTF8to16(string), extend);
+    }
+    else {
+        std::wstring wtext(string.begin(), string.end());
+        GetTextExtent(wtext, extend);
+    }
 }
 
 void DeviceContext::GetTextExtent(const std::wstring &string, TextExtend *extend)
@@ -121,6 +128,16 @@ void DeviceContext::GetTextExtent(const std::wstring &string, TextExtend *extend
     assert(m_fontStack.top());
     assert(extend);
 
+    std::pair<int, std::wstring> key;
+    if (m_textExtentCache) {
+        key = std::make_pair(m_fontStack.top()->GetPointSize(), string);
+        TextExtentCache::iterator iter = m_textExtentCache->find(key);
+        if (iter != m_textExtentCache->end()) {
+            (*extend) = iter->second;
+            return;
+        }
+    }
+
     extend->m_width = 0;
     extend->m_height = 0;
 
@@ -137,6 +154,8 @@ void DeviceContext::GetTextExtent(const std::wstring &string, TextExtend *extend
         }
         AddGlyphToTextExtend(glyph, extend);
     }
+
+    if (m_textExtentCache) m_textExtentCache->insert(std::make_pair(key, *extend));
 }
 
 void DeviceContext::GetSmuflTextExtent(const std::wstring &string, TextExtend *extend)
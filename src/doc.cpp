@@ -28,6 +28,7 @@
 #include "multirest.h"
 #include "note.h"
 #include "page.h"
+#include "profiler.h"
 #include "rpt.h"
 #include "score.h"
 #include "slur.h"
@@ -85,9 +86,19 @@ void Doc::Reset()
     m_drawingPage = NULL;
     m_drawingJustifyX = true;
     m_drawingEvenSpacing = false;
+    m_drawingReuseLayout = false;
+    m_isExcerpt = false;
     m_currentScoreDefDone = false;
     m_drawingPreparationDone = false;
+    m_castOffWidthsDone = false;
+    m_castOffFontGeneration = 0;
+    m_castOffLabelsWidth = 0;
+    m_castOffAbbrLabelsWidth = 0;
+    m_castOffScoreDefWidth = 0;
+    m_castOffLongestActualDur = VRV_UNSET;
     m_midiExportDone = false;
+    m_textExtentCache.clear();
+    m_textExtentFontGeneration = Resources::GetFontGeneration();
 
     m_scoreDef.Reset();
     if (m_scoreBuffer) {
@@ -176,11 +187,15 @@ bool Doc::GenerateDocumentScoreDef()
 
 void Doc::ExportMIDI(MidiFile *midiFile)
 {
+    ProfilerScope profilerScope("ExportMIDI");
+
     CalcMaxMeasureDurationParams calcMaxMeasureDurationParams;
 
     // We first calculate the maximum duration of each measure
     Functor calcMaxMeasureDuration(&Object::CalcMaxMeasureDuration);
+    Profiler::Start("CalcMaxMeasureDuration");
     this->Process(&calcMaxMeasureDuration, &calcMaxMeasureDurationParams);
+    Profiler::End();
 
     // We need to populate processing lists for processing the document by Layer (by Verse will not be used)
     PrepareProcessingListsParams prepareProcessingListsParams;
@@ -190,7 +205,9 @@ void Doc::ExportMIDI(MidiFile *midiFile)
 
     // We first fill a tree of int with [staff/layer] and [staff/layer/verse] numbers (@n) to be process
     Functor prepareProcessingLists(&Object::PrepareProcessingLists);
+    Profiler::Start("PrepareProcessingLists");
     this->Process(&prepareProcessingLists, &prepareProcessingListsParams);
+    Profiler::End();
 
     // The tree is used to process each staff/layer/verse separatly
     // For this, we use a array of AttCommmonNComparison that looks for each object if it is of the type
@@ -236,7 +253,9 @@ void Doc::ExportMIDI(MidiFile *midiFile)
             Functor generateMIDIEnd(&Object::GenerateMIDIEnd);
 
             // LogDebug("Exporting track %d ----------------", midiTrack);
+            Profiler::Start("GenerateMIDI");
             this->Process(&generateMIDI, &generateMIDIParams, &generateMIDIEnd, &filters);
+            Profiler::End();
         }
     }
 
@@ -245,17 +264,23 @@ void Doc::ExportMIDI(MidiFile *midiFile)
 
 void Doc::PrepareDrawing()
 {
+    ProfilerScope profilerScope("PrepareDrawing");
+
     if (m_drawingPreparationDone) {
         Functor resetDrawing(&Object::ResetDrawing);
+        Profiler::Start("ResetDrawing");
         this->Process(&resetDrawing, NULL);
+        Profiler::End();
     }
 
     // Try to match all spanning elements (slur, tie, etc) by processing backwards
     PrepareTimeSpanningParams prepareTimeSpanningParams;
     Functor prepareTimeSpanning(&Object::PrepareTimeSpanning);
     Functor prepareTimeSpanningEnd(&Object::PrepareTimeSpanningEnd);
+    Profiler::Start("PrepareTimeSpanning");
     this->Process(
         &prepareTimeSpanning, &prepareTimeSpanningParams, &prepareTimeSpanningEnd, NULL, UNLIMITED_DEPTH, BACKWARD);
+    Profiler::End();
 
     // First we try backwards because normally the spanning elements are at the end of
     // the measure. However, in some case, one (or both) end points will appear afterwards
@@ -264,22 +289,31 @@ void Doc::PrepareDrawing()
     // but this time without filling the list (that is only will the remaining elements)
     if (!prepareTimeSpanningParams.m_timeSpanningInterfaces.empty()) {
         prepareTimeSpanningParams.m_fillList = false;
+        Profiler::Start("PrepareTimeSpanning");
         this->Process(&prepareTimeSpanning, &prepareTimeSpanningParams);
+        Profiler::End();
     }
 
     // Try to match all time pointing elements (tempo, fermata, etc) by processing backwards
     PrepareTimePointingParams prepareTimePointingParams;
     Functor prepareTimePointing(&Object::PrepareTimePointing);
     Functor prepareTimePointingEnd(&Object::PrepareTimePointingEnd);
+    Profiler::Start("PrepareTimePointing");
     this->Process(
         &prepareTimePointing, &prepareTimePointingParams, &prepareTimePointingEnd, NULL, UNLIMITED_DEPTH, BACKWARD);
+    Profiler::End();
 
     // Now try to match the @tstamp and @tstamp2 attributes.
     PrepareTimestampsParams prepareTimestampsParams;
     prepareTimestampsParams.m_timeSpanningInterfaces = prepareTimeSpanningParams.m_timeSpanningInterfaces;
     Functor prepareTimestamps(&Object::PrepareTimestamps);
     Functor prepareTimestampsEnd(&Object::PrepareTimestampsEnd);
+    Profiler::Start("PrepareTimestamps");
     this->Process(&prepareTimestamps, &prepareTimestampsParams, &prepareTimestampsEnd);
+    Profiler::End();
+
+    // In an excerpt, the remaining ones are probably crossing its boundaries
+    if (m_isExcerpt) this->AttachExcerptTimeSpanning(prepareTimestampsParams.m_timeSpanningInterfaces);
 
     // If some are still there, then it is probably an issue in the encoding
     if (!prepareTimestampsParams.m_timeSpanningInterfaces.empty()) {
@@ -291,7 +325,9 @@ void Doc::PrepareDrawing()
     PrepareCrossStaffParams prepareCrossStaffParams;
     Functor prepareCrossStaff(&Object::PrepareCrossStaff);
     Functor prepareCrossStaffEnd(&Object::PrepareCrossStaffEnd);
+    Profiler::Start("PrepareCrossStaff");
     this->Process(&prepareCrossStaff, &prepareCrossStaffParams, &prepareCrossStaffEnd);
+    Profiler::End();
 
     // We need to populate processing lists for processing the document by Layer (for matching @tie) and
     // by Verse (for matching syllable connectors)
@@ -303,7 +339,9 @@ void Doc::PrepareDrawing()
     // We first fill a tree of ints with [staff/layer] and [staff/layer/verse] numbers (@n) to be processed
     // LogElapsedTimeStart();
     Functor prepareProcessingLists(&Object::PrepareProcessingLists);
+    Profiler::Start("PrepareProcessingLists");
     this->Process(&prepareProcessingLists, &prepareProcessingListsParams);
+    Profiler::End();
 
     // The tree is used to process each staff/layer/verse separately
     // For this, we use an array of AttCommmonNComparison that looks for each object if it is of the type
@@ -329,7 +367,9 @@ void Doc::PrepareDrawing()
             PrepareTieAttrParams prepareTieAttrParams;
             Functor prepareTieAttr(&Object::PrepareTieAttr);
             Functor prepareTieAttrEnd(&Object::PrepareTieAttrEnd);
+            Profiler::Start("PrepareTieAttr");
             this->Process(&prepareTieAttr, &prepareTieAttrParams, &prepareTieAttrEnd, &filters);
+            Profiler::End();
 
             // After having processed one layer, we check if we have open ties - if yes, we
             // must reset them and they will be ignored.
@@ -356,7 +396,9 @@ void Doc::PrepareDrawing()
 
             PreparePointersByLayerParams preparePointersByLayerParams;
             Functor preparePointersByLayer(&Object::PreparePointersByLayer);
+            Profiler::Start("PreparePointersByLayer");
             this->Process(&preparePointersByLayer, &preparePointersByLayerParams, NULL, &filters);
+            Profiler::End();
         }
     }
 
@@ -380,7 +422,9 @@ void Doc::PrepareDrawing()
                 PrepareLyricsParams prepareLyricsParams;
                 Functor prepareLyrics(&Object::PrepareLyrics);
                 Functor prepareLyricsEnd(&Object::PrepareLyricsEnd);
+                Profiler::Start("PrepareLyrics");
                 this->Process(&prepareLyrics, &prepareLyricsParams, &prepareLyricsEnd, &filters);
+                Profiler::End();
             }
         }
     }
@@ -391,7 +435,9 @@ void Doc::PrepareDrawing()
     FillStaffCurrentTimeSpanningParams fillStaffCurrentTimeSpanningParams;
     Functor fillStaffCurrentTimeSpanning(&Object::FillStaffCurrentTimeSpanning);
     Functor fillStaffCurrentTimeSpanningEnd(&Object::FillStaffCurrentTimeSpanningEnd);
+    Profiler::Start("FillStaffCurrentTimeSpanning");
     this->Process(&fillStaffCurrentTimeSpanning, &fillStaffCurrentTimeSpanningParams, &fillStaffCurrentTimeSpanningEnd);
+    Profiler::End();
 
     // Something must be wrong in the encoding because a TimeSpanningInterface was left open
     if (!fillStaffCurrentTimeSpanningParams.m_timeSpanningElements.empty()) {
@@ -413,26 +459,36 @@ void Doc::PrepareDrawing()
             // We set multiNumber to NONE for indicated we need to look at the staffDef when reaching the first staff
             PrepareRptParams prepareRptParams(&m_scoreDef);
             Functor prepareRpt(&Object::PrepareRpt);
+            Profiler::Start("PrepareRpt");
             this->Process(&prepareRpt, &prepareRptParams, NULL, &filters);
+            Profiler::End();
         }
     }
 
     // Prepare the endings (pointers to the measure after and before the boundaries
     PrepareBoundariesParams prepareEndingsParams;
     Functor prepareEndings(&Object::PrepareBoundaries);
+    Profiler::Start("PrepareBoundaries");
     this->Process(&prepareEndings, &prepareEndingsParams);
+    Profiler::End();
 
     // Prepare the floating drawing groups
     PrepareFloatingGrpsParams prepareFloatingGrpsParams;
     Functor prepareFloatingGrps(&Object::PrepareFloatingGrps);
+    Profiler::Start("PrepareFloatingGrps");
     this->Process(&prepareFloatingGrps, &prepareFloatingGrpsParams);
+    Profiler::End();
 
     Functor prepareLayerElementParts(&Object::PrepareLayerElementParts);
+    Profiler::Start("PrepareLayerElementParts");
     this->Process(&prepareLayerElementParts, NULL);
+    Profiler::End();
 
     // Prepare the drawing cue size
     Functor prepareDrawingCueSize(&Object::PrepareDrawingCueSize);
+    Profiler::Start("PrepareDrawingCueSize");
     this->Process(&prepareDrawingCueSize, NULL);
+    Profiler::End();
 
     /*
     // Alternate solution with StaffN_LayerN_VerseN_t
@@ -463,6 +519,7 @@ void Doc::PrepareDrawing()
     // LogElapsedTimeEnd ("Preparing drawing");
 
     m_drawingPreparationDone = true;
+    m_castOffWidthsDone = false;
 }
 
 void Doc::CollectScoreDefs(bool force)
@@ -471,6 +528,8 @@ void Doc::CollectScoreDefs(bool force)
         return;
     }
 
+    ProfilerScope profilerScope("CollectScoreDefs");
+
     if (m_currentScoreDefDone) {
         Functor unsetCurrentScoreDef(&Object::UnsetCurrentScoreDef);
         this->Process(&unsetCurrentScoreDef, NULL);
@@ -493,28 +552,54 @@ void Doc::CollectScoreDefs(bool force)
 
 void Doc::CastOffDoc()
 {
+    ProfilerScope profilerScope("CastOffDoc");
+
     this->CollectScoreDefs();
 
     Page *contentPage = this->SetDrawingPage(0);
     assert(contentPage);
-    contentPage->LayOutHorizontally();
+    // The horizontal layout is not redone when only the page geometry changed since the previous cast-off
+    if (m_castOffFontGeneration != Resources::GetFontGeneration()) m_castOffWidthsDone = false;
+    if (!m_castOffWidthsDone) {
+        contentPage->LayOutHorizontally();
+    }
+    else if (contentPage->HasCastOffAlignmentChanged()) {
+        // Only the measures laid out on a page since the previous cast-off need to be aligned again
+        contentPage->SetCastOffAlignment(m_castOffLongestActualDur);
+        contentPage->LayOutHorizontally(true);
+    }
 
     System *contentSystem = dynamic_cast<System *>(contentPage->DetachChild(0));
     assert(contentSystem);
 
+    if (!m_castOffWidthsDone) {
+        m_castOffFontGeneration = Resources::GetFontGeneration();
+        m_castOffLabelsWidth = contentSystem->GetDrawingLabelsWidth();
+        m_castOffAbbrLabelsWidth = contentSystem->GetDrawingAbbrLabelsWidth();
+        m_castOffScoreDefWidth = contentPage->m_drawingScoreDef.GetDrawingWidth();
+        m_castOffLongestActualDur = contentPage->GetLongestActualDur();
+    }
+    else {
+        // The abbreviated label width is used by the intermediate scoreDefs
+        contentSystem->SetDrawingAbbrLabelsWidth(m_castOffAbbrLabelsWidth);
+    }
+
     System *currentSystem = new System();
     contentPage->AddChild(currentSystem);
     CastOffSystemsParams castOffSystemsParams(contentSystem, contentPage, currentSystem);
     castOffSystemsParams.m_systemWidth = this->m_drawingPageWidth - this->m_drawingPageLeftMar
         - this->m_drawingPageRightMar - currentSystem->m_systemLeftMar - currentSystem->m_systemRightMar;
-    castOffSystemsParams.m_shift = -contentSystem->GetDrawingLabelsWidth();
-    castOffSystemsParams.m_currentScoreDefWidth
-        = contentPage->m_drawingScoreDef.GetDrawingWidth() + contentSystem->GetDrawingAbbrLabelsWidth();
+    castOffSystemsParams.m_shift = -m_castOffLabelsWidth;
+    castOffSystemsParams.m_currentScoreDefWidth = m_castOffScoreDefWidth + m_castOffAbbrLabelsWidth;
+    castOffSystemsParams.m_reuseWidths = m_castOffWidthsDone;
 
     Functor castOffSystems(&Object::CastOffSystems);
     Functor castOffSystemsEnd(&Object::CastOffSystemsEnd);
+    Profiler::Start("CastOffSystems");
     contentSystem->Process(&castOffSystems, &castOffSystemsParams, &castOffSystemsEnd);
+    Profiler::End();
     delete contentSystem;
+    m_castOffWidthsDone = true;
 
     // Reset the scoreDef at the beginning of each system
     this->CollectScoreDefs(true);
@@ -535,11 +620,22 @@ void Doc::CastOffDoc()
     castOffPagesParams.m_pageHeight
         = this->m_drawingPageHeight - this->m_drawingPageTopMar; // obviously we need a bottom margin
     Functor castOffPages(&Object::CastOffPages);
+    Profiler::Start("CastOffPages");
     contentPage->Process(&castOffPages, &castOffPagesParams);
+    Profiler::End();
     delete contentPage;
 
     // LogDebug("Layout: %d pages", this->GetChildCount());
 
+    // Keep the alignment of the measures for the layout of the pages if wanted
+    if (m_drawingReuseLayout) {
+        for (int i = 0; i < this->GetChildCount(); i++) {
+            Page *page = dynamic_cast<Page *>(this->GetChild(i));
+            assert(page);
+            page->SetCastOffAlignment(m_castOffLongestActualDur);
+        }
+    }
+
     // We need to reset the drawing page to NULL
     // because idx will still be 0 but contentPage is dead!
     this->ResetDrawingPage();
@@ -548,6 +644,8 @@ void Doc::CastOffDoc()
 
 void Doc::UnCastOffDoc()
 {
+    ProfilerScope profilerScope("UnCastOffDoc");
+
     Page *contentPage = new Page();
     System *contentSystem = new System();
     contentPage->AddChild(contentSystem);
@@ -571,6 +669,8 @@ void Doc::UnCastOffDoc()
 
 void Doc::CastOffEncodingDoc()
 {
+    ProfilerScope profilerScope("CastOffEncodingDoc");
+
     this->CollectScoreDefs();
 
     Page *contentPage = this->SetDrawingPage(0);
@@ -600,6 +700,57 @@ void Doc::CastOffEncodingDoc()
     this->CollectScoreDefs(true);
 }
 
+bool Doc::CastOffSnapshotDoc(const std::vector<std::vector<int> > &pageSystemSizes)
+{
+    ProfilerScope profilerScope("CastOffSnapshotDoc");
+
+    Page *contentPage = this->SetDrawingPage(0);
+    assert(contentPage);
+
+    System *contentSystem = dynamic_cast<System *>(contentPage->FindChildByType(SYSTEM));
+    assert(contentSystem);
+
+    int elementCount = 0;
+    for (auto const &systemSizes : pageSystemSizes) {
+        if (systemSizes.empty()) return false;
+        for (auto size : systemSizes) {
+            if (size <= 0) return false;
+            elementCount += size;
+        }
+    }
+    if (pageSystemSizes.empty() || (elementCount != contentSystem->GetChildCount())) {
+        return false;
+    }
+
+    this->CollectScoreDefs();
+
+    // Detach the contentPage
+    this->DetachChild(0);
+    assert(contentPage && !contentPage->GetParent());
+
+    // The elements are moved in their order to the systems
+    int idx = 0;
+    for (auto const &systemSizes : pageSystemSizes) {
+        Page *page = new Page();
+        this->AddChild(page);
+        for (auto size : systemSizes) {
+            System *system = new System();
+            page->AddChild(system);
+            for (int i = 0; i < size; ++i, ++idx) {
+                system->AddChild(contentSystem->Relinquish(idx));
+            }
+        }
+    }
+    delete contentPage;
+
+    // We need to reset the drawing page to NULL
+    // because idx will still be 0 but contentPage is dead!
+    this->ResetDrawingPage();
+    this->CollectScoreDefs(true);
+
+    return true;
+}
+
 void Doc::ConvertToPageBasedDoc()
 {
     assert(m_scoreBuffer); // Doc::CreateScoreBuffer needs to be called first;
@@ -828,6 +979,15 @@ FontInfo *Doc::GetDrawingLyricFont(int staffSize)
     return &m_drawingLyricFont;
 }
 
+TextExtentCache *Doc::GetTextExtentCache()
+{
+    if (m_textExtentFontGeneration != Resources::GetFontGeneration()) {
+        m_textExtentCache.clear();
+        m_textExtentFontGeneration = Resources::GetFontGeneration();
+    }
+    return &m_textExtentCache;
+}
+
 char Doc::GetLeftMargin(const ClassId classId) const
 {
     if (classId == ACCID) return m_style->m_leftMarginAccid;
@@ -1030,13 +1190,55 @@ int Doc::GetAdjustedDrawingPageWidth() const
     return (contentWidth + m_drawingPageLeftMar + m_drawingPageRightMar) / DEFINITION_FACTOR;
 }
 
+void Doc::AttachExcerptTimeSpanning(ArrayOfSpanningInterClassIdPairs &timeSpanningInterfaces)
+{
+    Measure *firstMeasure = dynamic_cast<Measure *>(this->FindChildByType(MEASURE));
+    Measure *lastMeasure = dynamic_cast<Measure *>(this->FindChildByType(MEASURE, UNLIMITED_DEPTH, BACKWARD));
+    if (!firstMeasure || !lastMeasure) return;
+
+    std::vector<ClassId> classIds = { NOTE, CHORD, REST };
+    AttComparisonAny isDurationElement(classIds);
+
+    ArrayOfSpanningInterClassIdPairs::iterator iter = timeSpanningInterfaces.begin();
+    while (iter != timeSpanningInterfaces.end()) {
+        TimeSpanningInterface *interface = iter->first;
+        // The staff is the one of the matched element, or the @staff for the ones spanning the whole excerpt
+        LayerElement *element = (interface->GetStart()) ? interface->GetStart() : interface->GetEnd();
+        Staff *staff = (element) ? dynamic_cast<Staff *>(element->GetFirstParent(STAFF)) : NULL;
+        int staffN = (staff) ? staff->GetN() : VRV_UNSET;
+        if (!element && interface->HasStaff()) staffN = interface->GetStaff().front();
+        if (staffN == VRV_UNSET) {
+            iter++;
+            continue;
+        }
+        // Look for the first and last element of the same staff in the excerpt
+        AttCommonNComparison isStaff(STAFF, staffN);
+        Object *firstStaff = firstMeasure->FindChildByAttComparison(&isStaff, 1);
+        Object *lastStaff = lastMeasure->FindChildByAttComparison(&isStaff, 1);
+        LayerElement *first = (firstStaff)
+            ? dynamic_cast<LayerElement *>(firstStaff->FindChildByAttComparison(&isDurationElement))
+            : NULL;
+        LayerElement *last = (lastStaff)
+            ? dynamic_cast<LayerElement *>(
+                  lastStaff->FindChildByAttComparison(&isDurationElement, UNLIMITED_DEPTH, BACKWARD))
+            : NULL;
+        if ((!interface->GetStart() && !first) || (!interface->GetEnd() && !last)) {
+            iter++;
+            continue;
+        }
+        if (!interface->GetStart()) interface->SetStart(first);
+        if (!interface->GetEnd()) interface->SetEnd(last);
+        iter = timeSpanningInterfaces.erase(iter);
+    }
+}
+
 //----------------------------------------------------------------------------
 // Doc functors methods
 //----------------------------------------------------------------------------
 
 int Doc::PrepareLyricsEnd(FunctorParams *functorParams)
 {
-    PrepareLyricsParams *params = dynamic_cast<PrepareLyricsParams *>(functorParams);
+    PrepareLyricsParams *params = static_cast<PrepareLyricsParams *>(functorParams);
     assert(params);
 
     if ((params->m_currentSyl && params->m_lastNote) && (params->m_currentSyl->GetStart() != params->m_lastNote)) {
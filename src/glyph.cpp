@@ -135,7 +135,10 @@ bool Glyph::HasAnchor(SMuFLGlyphAnchor anchor)
 
 const Point *Glyph::GetAnchor(SMuFLGlyphAnchor anchor)
 {
-    return &m_anchors[anchor];
+    // The glyphs are shared by the threads and must not be modified here
+    std::map<SMuFLGlyphAnchor, Point>::const_iterator iter = m_anchors.find(anchor);
+    if (iter == m_anchors.end()) return NULL;
+    return &iter->second;
 }
 
 } // namespace vrv
@@ -77,7 +77,7 @@ void Harm::AddChild(Object *child)
 
 int Harm::PrepareFloatingGrps(FunctorParams *functorParams)
 {
-    // PrepareFloatingGrpsParams *params = dynamic_cast<PrepareFloatingGrpsParams *>(functorParams);
+    // PrepareFloatingGrpsParams *params = static_cast<PrepareFloatingGrpsParams *>(functorParams);
     // assert(params);
 
     this->SetDrawingGrpId(DRAWING_GRP_HARM);
@@ -10,6 +10,7 @@
 //----------------------------------------------------------------------------
 
 #include <assert.h>
+#include <atomic>
 #include <math.h>
 
 //----------------------------------------------------------------------------
@@ -29,6 +30,11 @@
 
 namespace vrv {
 
+/**
+ * The source of the drawing X generations of all the aligners
+ */
+static std::atomic<unsigned long long> s_drawingXGeneration(0);
+
 //----------------------------------------------------------------------------
 // HorizontalAligner
 //----------------------------------------------------------------------------
@@ -45,34 +51,44 @@ HorizontalAligner::~HorizontalAligner()
 void HorizontalAligner::Reset()
 {
     Object::Reset();
+    IncrementDrawingXGeneration();
+}
+
+void HorizontalAligner::IncrementDrawingXGeneration()
+{
+    m_drawingXGeneration = ++s_drawingXGeneration;
 }
 
 Alignment *HorizontalAligner::SearchAlignmentAtTime(double time, AlignmentType type, int &idx)
 {
-    int i;
     idx = -1; // the index if we reach the end.
-    Alignment *alignment = NULL;
-    // First try to see if we already have something at the time position
-    for (i = 0; i < GetAlignmentCount(); i++) {
-        alignment = dynamic_cast<Alignment *>(m_children.at(i));
+    // The alignments are ordered by time and then by type, so we look for the first one that is not before the time
+    // and the type with a binary search
+    int first = 0;
+    int count = GetAlignmentCount();
+    while (count > 0) {
+        int step = count / 2;
+        Alignment *alignment = dynamic_cast<Alignment *>(m_children.at(first + step));
         assert(alignment);
 
-        double alignment_time = alignment->GetTime();
-        if (vrv::AreEqual(alignment_time, time)) {
-            if (alignment->GetType() == type) {
-                return alignment;
-            }
-            else if (alignment->GetType() > type) {
-                idx = i;
-                break;
-            }
+        double alignmentTime = alignment->GetTime();
+        if ((vrv::AreEqual(alignmentTime, time) && (alignment->GetType() >= type)) || (alignmentTime > time)) {
+            count = step;
         }
-        // nothing found, do not go any further but keep the index
-        if (alignment->GetTime() > time) {
-            idx = i;
-            break;
+        else {
+            first += step + 1;
+            count -= step + 1;
         }
     }
+    // nothing found to the end
+    if (first == GetAlignmentCount()) return NULL;
+
+    Alignment *alignment = dynamic_cast<Alignment *>(m_children.at(first));
+    assert(alignment);
+    // we already have an alignment of the type at that time
+    if (vrv::AreEqual(alignment->GetTime(), time) && (alignment->GetType() == type)) return alignment;
+    // nothing found, but keep the index
+    idx = first;
     return NULL;
 }
 
@@ -130,9 +146,8 @@ Alignment *MeasureAligner::GetAlignmentAtTime(double time, AlignmentType type)
     if (idx == -1) {
         if (type != ALIGNMENT_MEASURE_END) {
             // This typically occurs when a tstamp event occurs after the last note of a measure
-            int rightBarlineIdx = m_rightBarLineAlignment->GetIdx();
-            assert(rightBarlineIdx != -1);
-            idx = rightBarlineIdx - 1;
+            // Insert it just before the right barline to keep the alignments ordered by time
+            idx = this->GetRightBarLineAlignmentIdx();
             this->SetMaxTime(time);
         }
         else {
@@ -150,8 +165,7 @@ void MeasureAligner::SetMaxTime(double time)
     assert(m_rightBarLineAlignment);
 
     // it must be found in the aligner
-    int idx = m_rightBarLineAlignment->GetIdx();
-    assert(idx != -1);
+    int idx = this->GetRightBarLineAlignmentIdx();
 
     int i;
     Alignment *alignment = NULL;
@@ -164,6 +178,21 @@ void MeasureAligner::SetMaxTime(double time)
     }
 }
 
+int MeasureAligner::GetRightBarLineAlignmentIdx() const
+{
+    // we have to have a m_rightBarLineAlignment
+    assert(m_rightBarLineAlignment);
+
+    // Look for it from the end since only the right scoreDef alignments come after it
+    int i;
+    for (i = GetAlignmentCount() - 1; i >= 0; i--) {
+        if (m_children.at(i) == m_rightBarLineAlignment) return i;
+    }
+    // it must be found in the aligner
+    assert(false);
+    return -1;
+}
+
 double MeasureAligner::GetMaxTime() const
 {
     // we have to have a m_rightBarLineAlignment
@@ -474,10 +503,25 @@ AlignmentReference *Alignment::GetAlignmentReference(int staffN)
 
 void Alignment::SetXRel(int xRel)
 {
-    ResetCachedDrawingX();
+    if (xRel == m_xRel) return;
+
+    // Invalidate the cached drawing X of all the elements in the aligner without visiting them
+    HorizontalAligner *aligner = dynamic_cast<HorizontalAligner *>(this->GetParent());
+    if (aligner) {
+        aligner->IncrementDrawingXGeneration();
+    }
+    else {
+        ResetCachedDrawingX();
+    }
     m_xRel = xRel;
 }
 
+unsigned long long Alignment::GetDrawingXGeneration() const
+{
+    assert(dynamic_cast<HorizontalAligner *>(this->GetParent()));
+    return static_cast<HorizontalAligner *>(this->GetParent())->GetDrawingXGeneration();
+}
+
 bool Alignment::AddLayerElementRef(LayerElement *element)
 {
     assert(element->IsLayerElement());
@@ -678,25 +722,36 @@ void TimestampAligner::Reset()
 
 TimestampAttr *TimestampAligner::GetTimestampAtTime(double time)
 {
-    int i;
     int idx = -1; // the index if we reach the end.
     // We need to adjust the position since timestamp 0 to 1.0 are before 0 musical time
     time = time - 1.0;
     TimestampAttr *timestampAttr = NULL;
-    // First try to see if we already have something at the time position
-    for (i = 0; i < GetChildCount(); i++) {
-        timestampAttr = dynamic_cast<TimestampAttr *>(m_children.at(i));
+    // The timestamps are ordered by time, so we look for the first one that is not before the time with a binary search
+    int first = 0;
+    int count = GetChildCount();
+    while (count > 0) {
+        int step = count / 2;
+        timestampAttr = dynamic_cast<TimestampAttr *>(m_children.at(first + step));
         assert(timestampAttr);
 
         double alignmentTime = timestampAttr->GetActualDurPos();
-        if (vrv::AreEqual(alignmentTime, time)) {
-            return timestampAttr;
+        if (vrv::AreEqual(alignmentTime, time) || (alignmentTime > time)) {
+            count = step;
         }
-        // nothing found, do not go any further but keep the index
-        if (alignmentTime > time) {
-            idx = i;
-            break;
+        else {
+            first += step + 1;
+            count -= step + 1;
+        }
+    }
+    if (first < GetChildCount()) {
+        timestampAttr = dynamic_cast<TimestampAttr *>(m_children.at(first));
+        assert(timestampAttr);
+        // First try to see if we already have something at the time position
+        if (vrv::AreEqual(timestampAttr->GetActualDurPos(), time)) {
+            return timestampAttr;
         }
+        // nothing found, but keep the index
+        idx = first;
     }
     // nothing found
     timestampAttr = new TimestampAttr();
@@ -717,7 +772,7 @@ TimestampAttr *TimestampAligner::GetTimestampAtTime(double time)
 
 int MeasureAligner::SetAlignmentXPos(FunctorParams *functorParams)
 {
-    SetAlignmentXPosParams *params = dynamic_cast<SetAlignmentXPosParams *>(functorParams);
+    SetAlignmentXPosParams *params = static_cast<SetAlignmentXPosParams *>(functorParams);
     assert(params);
 
     // We start a new MeasureAligner
@@ -730,7 +785,7 @@ int MeasureAligner::SetAlignmentXPos(FunctorParams *functorParams)
 
 int MeasureAligner::JustifyX(FunctorParams *functorParams)
 {
-    JustifyXParams *params = dynamic_cast<JustifyXParams *>(functorParams);
+    JustifyXParams *params = static_cast<JustifyXParams *>(functorParams);
     assert(params);
 
     params->m_leftBarLineX = GetLeftBarLineAlignment()->GetXRel();
@@ -741,7 +796,7 @@ int MeasureAligner::JustifyX(FunctorParams *functorParams)
 
 int Alignment::AdjustGraceXPos(FunctorParams *functorParams)
 {
-    AdjustGraceXPosParams *params = dynamic_cast<AdjustGraceXPosParams *>(functorParams);
+    AdjustGraceXPosParams *params = static_cast<AdjustGraceXPosParams *>(functorParams);
     assert(params);
 
     // We are in a Measure aligner - redirect to the GraceAligner when it is a ALIGNMENT_GRACENOTE
@@ -821,7 +876,7 @@ int Alignment::AdjustGraceXPos(FunctorParams *functorParams)
 
 int Alignment::AdjustGraceXPosEnd(FunctorParams *functorParams)
 {
-    AdjustGraceXPosParams *params = dynamic_cast<AdjustGraceXPosParams *>(functorParams);
+    AdjustGraceXPosParams *params = static_cast<AdjustGraceXPosParams *>(functorParams);
     assert(params);
 
     if (params->m_graceUpcomingMaxPos != -VRV_UNSET) {
@@ -835,7 +890,7 @@ int Alignment::AdjustGraceXPosEnd(FunctorParams *functorParams)
 
 int Alignment::AdjustXPos(FunctorParams *functorParams)
 {
-    AdjustXPosParams *params = dynamic_cast<AdjustXPosParams *>(functorParams);
+    AdjustXPosParams *params = static_cast<AdjustXPosParams *>(functorParams);
     assert(params);
 
     // LogDebug("Alignment type %d", m_type);
@@ -851,7 +906,7 @@ int Alignment::AdjustXPos(FunctorParams *functorParams)
 
 int Alignment::AdjustXPosEnd(FunctorParams *functorParams)
 {
-    AdjustXPosParams *params = dynamic_cast<AdjustXPosParams *>(functorParams);
+    AdjustXPosParams *params = static_cast<AdjustXPosParams *>(functorParams);
     assert(params);
 
     if (params->m_upcomingMinPos != VRV_UNSET) {
@@ -872,7 +927,7 @@ int Alignment::AdjustXPosEnd(FunctorParams *functorParams)
 
 int Alignment::AdjustAccidX(FunctorParams *functorParams)
 {
-    AdjustAccidXParams *params = dynamic_cast<AdjustAccidXParams *>(functorParams);
+    AdjustAccidXParams *params = static_cast<AdjustAccidXParams *>(functorParams);
     assert(params);
 
     if (this->m_graceAligner) this->m_graceAligner->Process(params->m_functor, functorParams);
@@ -893,7 +948,7 @@ int Alignment::HorizontalSpaceForDuration(
 
 int Alignment::SetAlignmentXPos(FunctorParams *functorParams)
 {
-    SetAlignmentXPosParams *params = dynamic_cast<SetAlignmentXPosParams *>(functorParams);
+    SetAlignmentXPosParams *params = static_cast<SetAlignmentXPosParams *>(functorParams);
     assert(params);
 
     // Do not set an x pos for anything before the barline (including it)
@@ -925,7 +980,7 @@ int Alignment::SetAlignmentXPos(FunctorParams *functorParams)
 
 int Alignment::JustifyX(FunctorParams *functorParams)
 {
-    JustifyXParams *params = dynamic_cast<JustifyXParams *>(functorParams);
+    JustifyXParams *params = static_cast<JustifyXParams *>(functorParams);
     assert(params);
 
     if (m_type <= ALIGNMENT_MEASURE_LEFT_BARLINE) {
@@ -939,9 +994,8 @@ int Alignment::JustifyX(FunctorParams *functorParams)
     else {
         //  Now more the right barline and all right scoreDef elements
         int shift = this->m_xRel - params->m_rightBarLineX;
-        this->m_xRel
-            = ceil(((double)params->m_rightBarLineX - (double)params->m_leftBarLineX) * params->m_justifiableRatio)
-            + params->m_leftBarLineX + shift;
+        SetXRel(ceil(((double)params->m_rightBarLineX - (double)params->m_leftBarLineX) * params->m_justifiableRatio)
+            + params->m_leftBarLineX + shift);
     }
 
     // Finally, when reaching the end of the measure, update the measureXRel for the next measure
@@ -954,7 +1008,7 @@ int Alignment::JustifyX(FunctorParams *functorParams)
 
 int AlignmentReference::AdjustLayers(FunctorParams *functorParams)
 {
-    AdjustLayersParams *params = dynamic_cast<AdjustLayersParams *>(functorParams);
+    AdjustLayersParams *params = static_cast<AdjustLayersParams *>(functorParams);
     assert(params);
 
     if (!m_multipleLayer) return FUNCTOR_SIBLINGS;
@@ -970,7 +1024,7 @@ int AlignmentReference::AdjustLayers(FunctorParams *functorParams)
 
 int AlignmentReference::AdjustGraceXPos(FunctorParams *functorParams)
 {
-    AdjustGraceXPosParams *params = dynamic_cast<AdjustGraceXPosParams *>(functorParams);
+    AdjustGraceXPosParams *params = static_cast<AdjustGraceXPosParams *>(functorParams);
     assert(params);
 
     ArrayOfObjects::iterator childrenIter;
@@ -987,7 +1041,7 @@ int AlignmentReference::AdjustGraceXPos(FunctorParams *functorParams)
 
 int AlignmentReference::AdjustAccidX(FunctorParams *functorParams)
 {
-    AdjustAccidXParams *params = dynamic_cast<AdjustAccidXParams *>(functorParams);
+    AdjustAccidXParams *params = static_cast<AdjustAccidXParams *>(functorParams);
     assert(params);
 
     if (m_accidSpace.empty()) return FUNCTOR_SIBLINGS;
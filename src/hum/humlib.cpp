@@ -2303,6 +2303,11 @@ HumParameter::HumParameter(const string& str) : string(str) {
 
 
 
+// declare static variables
+set<string> HumHash::keyset;
+std::mutex  HumHash::keymutex;
+
+
 //////////////////////////////
 //
 // HumHash::HumHash -- HumHash constructor.  The data storage is empty
@@ -2314,6 +2319,15 @@ HumHash::HumHash(void) {
 }
 
 
+HumHash::HumHash(const HumHash& hash) {
+	parameters = NULL;
+	if (hash.parameters != NULL) {
+		parameters = new HumHashEntries(*hash.parameters);
+	}
+	prefix = hash.prefix;
+}
+
+
 
 //////////////////////////////
 //
@@ -2330,6 +2344,29 @@ HumHash::~HumHash() {
 
 
 
+//////////////////////////////
+//
+// HumHash::operator= -- Copy the parameters (and the prefix) of another
+//    HumHash.  The storage is not shared between the two objects.
+//
+
+HumHash& HumHash::operator=(const HumHash& hash) {
+	if (this == &hash) {
+		return *this;
+	}
+	if (parameters != NULL) {
+		delete parameters;
+		parameters = NULL;
+	}
+	if (hash.parameters != NULL) {
+		parameters = new HumHashEntries(*hash.parameters);
+	}
+	prefix = hash.prefix;
+	return *this;
+}
+
+
+
 //////////////////////////////
 //
 // HumHash::getValue -- Returns the value specified by the given key.
@@ -2370,23 +2407,11 @@ string HumHash::getValue(const string& ns2, const string& key) const {
 
 string HumHash::getValue(const string& ns1, const string& ns2,
 		const string& key) const {
-	if (parameters == NULL) {
+	HumParameter* parameter = findParameter(ns1, ns2, key);
+	if (parameter == NULL) {
 		return "";
 	}
-	MapNNKV& p = *parameters;
-	auto it1 = p.find(ns1);
-	if (it1 == p.end()) {
-		return "";
-	}
-	auto it2 = it1->second.find(ns2);
-	if (it2 == it1->second.end()) {
-		return "";
-	}
-	auto it3 = it2->second.find(key);
-	if (it3 == it2->second.end()) {
-		return "";
-	}
-	return it3->second;
+	return *parameter;
 }
 
 
@@ -2403,7 +2428,7 @@ HTp HumHash::getValueHTp(const string& key) const {
 	}
 	vector<string> keys = getKeyList(key);
 	if (keys.size() == 1) {
-		return getValueHTp("", "", keys[2]);
+		return getValueHTp("", "", keys[0]);
 	} else if (keys.size() == 2) {
 		return getValueHTp(keys[0], keys[1]);
 	} else {
@@ -2458,7 +2483,7 @@ int HumHash::getValueInt(const string& key) const {
 	}
 	vector<string> keys = getKeyList(key);
 	if (keys.size() == 1) {
-		return getValueInt("", "", keys[2]);
+		return getValueInt("", "", keys[0]);
 	} else if (keys.size() == 2) {
 		return getValueInt(keys[0], keys[1]);
 	} else {
@@ -2562,7 +2587,7 @@ double HumHash::getValueFloat(const string& key) const {
 	}
 	vector<string> keys = getKeyList(key);
 	if (keys.size() == 1) {
-		return getValueFloat("", "", keys[2]);
+		return getValueFloat("", "", keys[0]);
 	} else if (keys.size() == 2) {
 		return getValueFloat(keys[0], keys[1]);
 	} else {
@@ -2575,7 +2600,7 @@ double HumHash::getValueFloat(const string& ns2, const string& key) const {
 	if (parameters == NULL) {
 		return 0.0;
 	}
-	return getValueInt("", ns2, key);
+	return getValueFloat("", ns2, key);
 }
 
 
@@ -2615,7 +2640,7 @@ double HumHash::getValueFloat(const string& ns1, const string& ns2,
 bool HumHash::getValueBool(const string& key) const {
 	vector<string> keys = getKeyList(key);
 	if (keys.size() == 1) {
-		return getValueBool("", "", keys[2]);
+		return getValueBool("", "", keys[0]);
 	} else if (keys.size() == 2) {
 		return getValueBool(keys[0], keys[1]);
 	} else {
@@ -2631,15 +2656,13 @@ bool HumHash::getValueBool(const string& ns2, const string& key) const {
 
 bool HumHash::getValueBool(const string& ns1, const string& ns2,
 		const string& key) const {
-	if (parameters == NULL) {
-		return false;
-	}
-	if (!isDefined(ns1, ns2, key)) {
+	HumParameter* parameter = findParameter(ns1, ns2, key);
+	if (parameter == NULL) {
 		return false;
 	}
-	if ((*parameters)[ns1][ns2][key] == "false") {
+	if (*parameter == "false") {
 		return false;
-	} else if ((*parameters)[ns1][ns2][key] == "0") {
+	} else if (*parameter == "0") {
 		return false;
 	} else {
 		return true;
@@ -2680,8 +2703,7 @@ void HumHash::setValue(const string& ns2, const string& key,
 
 void HumHash::setValue(const string& ns1, const string& ns2,
 		const string& key, const string& value) {
-	initializeParameters();
-	(*parameters)[ns1][ns2][key] = value;
+	setParameter(ns1, ns2, key, value);
 }
 
 
@@ -2721,10 +2743,9 @@ void HumHash::setValue(const string& ns2, const string& key, int value) {
 
 void HumHash::setValue(const string& ns1, const string& ns2,
 		const string& key, int value) {
-	initializeParameters();
 	stringstream ss;
 	ss << value;
-	(*parameters)[ns1][ns2][key] = ss.str();
+	setParameter(ns1, ns2, key, ss.str());
 }
 
 
@@ -2747,10 +2768,9 @@ void HumHash::setValue(const string& ns2, const string& key, HTp value) {
 
 void HumHash::setValue(const string& ns1, const string& ns2,
 		const string& key, HTp value) {
-	initializeParameters();
 	stringstream ss;
 	ss << "HT_" << ((long long)value);
-	(*parameters)[ns1][ns2][key] = ss.str();
+	setParameter(ns1, ns2, key, ss.str());
 }
 
 
@@ -2773,10 +2793,9 @@ void HumHash::setValue(const string& ns2, const string& key, HumNum value) {
 
 void HumHash::setValue(const string& ns1, const string& ns2,
 		const string& key, HumNum value) {
-	initializeParameters();
 	stringstream ss;
 	ss << value;
-	(*parameters)[ns1][ns2][key] = ss.str();
+	setParameter(ns1, ns2, key, ss.str());
 }
 
 
@@ -2799,10 +2818,9 @@ void HumHash::setValue(const string& ns2, const string& key, double value) {
 
 void HumHash::setValue(const string& ns1, const string& ns2,
 		const string& key, double value) {
-	initializeParameters();
 	stringstream ss;
 	ss << value;
-	(*parameters)[ns1][ns2][key] = ss.str();
+	setParameter(ns1, ns2, key, ss.str());
 }
 
 
@@ -2823,8 +2841,10 @@ vector<string> HumHash::getKeys(const string& ns1, const string& ns2) const {
 	if (parameters == NULL) {
 		return output;
 	}
-	for (auto& it : (*parameters)[ns1][ns2]) {
-		output.push_back(it.first);
+	for (auto entry : getSortedEntries()) {
+		if ((*entry->ns1 == ns1) && (*entry->ns2 == ns2)) {
+			output.push_back(*entry->key);
+		}
 	}
 	return output;
 }
@@ -2842,9 +2862,9 @@ vector<string> HumHash::getKeys(const string& ns) const {
 		return getKeys(ns1, ns2);
 	}
 
-	for (auto& it1 : (*parameters)[ns]) {
-		for (auto& it2 : it1.second) {
-			output.push_back(it1.first + ":" + it2.first);
+	for (auto entry : getSortedEntries()) {
+		if (*entry->ns1 == ns) {
+			output.push_back(*entry->ns2 + ":" + *entry->key);
 		}
 	}
 	return output;
@@ -2856,12 +2876,8 @@ vector<string> HumHash::getKeys(void) const {
 	if (parameters == NULL) {
 		return output;
 	}
-	for (auto& it1 : (*parameters)) {
-		for (auto& it2 : it1.second) {
-			for (auto it3 : it2.second) {
-				output.push_back(it1.first + ":" + it2.first + ":" + it3.first);
-			}
-		}
+	for (auto entry : getSortedEntries()) {
+		output.push_back(*entry->ns1 + ":" + *entry->ns2 + ":" + *entry->key);
 	}
 	return output;
 }
@@ -2879,42 +2895,12 @@ vector<string> HumHash::getKeys(void) const {
 //
 
 bool HumHash::hasParameters(const string& ns1, const string& ns2) const {
-	if (parameters == NULL) {
-		return false;
-	}
-	if (parameters->size() == 0) {
-		return false;
-	}
-	auto it1 = parameters->find(ns1);
-	if (it1 == parameters->end()) {
-		return false;
-	}
-	auto it2 = (*parameters)[ns1].find(ns2);
-	if (it2 == (*parameters)[ns1].end()) {
-		return false;
-	} else {
-		return true;
-	}
+	return getParameterCount(ns1, ns2) > 0;
 }
 
 
 bool HumHash::hasParameters(const string& ns) const {
-	if (parameters == NULL) {
-		return false;
-	}
-	auto loc = ns.find(":");
-	if (loc != string::npos) {
-		string ns1 = ns.substr(0, loc);
-		string ns2 = ns.substr(loc+1);
-		return hasParameters(ns1, ns2);
-	}
-
-	auto it = parameters->find(ns);
-	if (it == parameters->end()) {
-		return false;
-	} else {
-		return true;
-	}
+	return getParameterCount(ns) > 0;
 }
 
 
@@ -2922,19 +2908,7 @@ bool HumHash::hasParameters(void) const {
 	if (parameters == NULL) {
 		return false;
 	}
-	if (parameters->size() == 0) {
-		return false;
-	}
-	for (auto& it1 : *parameters) {
-		for (auto& it2 : it1.second) {
-			if (it2.second.size() == 0) {
-				continue;
-			} else {
-				return true;
-			}
-		}
-	}
-	return false;
+	return !parameters->empty();
 }
 
 
@@ -2954,24 +2928,19 @@ int HumHash::getParameterCount(const string& ns1, const string& ns2) const {
 	if (parameters == NULL) {
 		return 0;
 	}
-	if (parameters->size() == 0) {
-		return 0;
-	}
-	auto it1 = parameters->find(ns1);
-	if (it1 == parameters->end()) {
-		return 0;
-	}
-	auto it2 = it1->second.find(ns2);
-	if (it2 == it1->second.end()) {
-		return 0;
+	int sum = 0;
+	for (auto& entry : *parameters) {
+		if ((*entry.ns1 == ns1) && (*entry.ns2 == ns2)) {
+			sum++;
+		}
 	}
-	return (int)it2->second.size();
+	return sum;
 }
 
 
 int HumHash::getParameterCount(const string& ns) const {
 	if (parameters == NULL) {
-		return false;
+		return 0;
 	}
 	auto loc = ns.find(":");
 	if (loc != string::npos) {
@@ -2980,13 +2949,11 @@ int HumHash::getParameterCount(const string& ns) const {
 		return getParameterCount(ns1, ns2);
 	}
 
-	auto it1 = parameters->find(ns);
-	if (it1 == parameters->end()) {
-		return false;
-	}
 	int sum = 0;
-	for (auto& it2 : it1->second) {
-		sum += it2.second.size();
+	for (auto& entry : *parameters) {
+		if (*entry.ns1 == ns) {
+			sum++;
+		}
 	}
 	return sum;
 }
@@ -2996,16 +2963,7 @@ int HumHash::getParameterCount(void) const {
 	if (parameters == NULL) {
 		return 0;
 	}
-	if (parameters->size() == 0) {
-		return 0;
-	}
-	int sum = 0;
-	for (auto& it1 : (*parameters)) {
-		for (auto& it2 : it1.second) {
-			sum += it2.second.size();
-		}
-	}
-	return sum;
+	return (int)parameters->size();
 }
 
 
@@ -3024,29 +2982,23 @@ bool HumHash::isDefined(const string& key) const {
 	}
 	vector<string> keys = getKeyList(key);
 	if (keys.size() == 1) {
-		return (*parameters)[""][""].count(keys[0]);
+		return isDefined("", "", keys[0]);
 	} else if (keys.size() == 2) {
-		return (*parameters)[""][keys[0]].count(keys[1]);
+		return isDefined("", keys[0], keys[1]);
 	} else {
-		return (*parameters)[keys[0]][keys[1]].count(keys[2]);
+		return isDefined(keys[0], keys[1], keys[2]);
 	}
 }
 
 
 bool HumHash::isDefined(const string& ns2, const string& key) const {
-	if (parameters == NULL) {
-		return false;
-	}
-	return (*parameters)[""][ns2].count(key);
+	return isDefined("", ns2, key);
 }
 
 
 bool HumHash::isDefined(const string& ns1, const string& ns2,
 		const string& key) const {
-	if (parameters == NULL) {
-		return false;
-	}
-	return (*parameters)[ns1][ns2].count(key);
+	return findParameter(ns1, ns2, key) != NULL;
 }
 
 
@@ -3083,39 +3035,136 @@ void HumHash::deleteValue(const string& ns2, const string& key) {
 
 void HumHash::deleteValue(const string& ns1, const string& ns2,
 		const string& key) {
-	if (parameters == NULL) {
+	HumParameter* parameter = findParameter(ns1, ns2, key);
+	if (parameter == NULL) {
 		return;
 	}
-	(*parameters)[ns1][ns2].erase(key);
+	for (auto it = parameters->begin(); it != parameters->end(); it++) {
+		if (&it->value == parameter) {
+			parameters->erase(it);
+			return;
+		}
+	}
+}
 
-	MapNNKV& p = *parameters;
-	auto it1 = p.find(ns1);
-	if (it1 == p.end()) {
-		return;
+
+
+//////////////////////////////
+//
+// HumHash::initializeParameters -- Create the parameter list if it does not
+//     already exist.
+//
+
+void HumHash::initializeParameters(void) {
+	if (parameters == NULL) {
+		parameters = new HumHashEntries;
 	}
-	auto it2 = it1->second.find(ns2);
-	if (it2 == it1->second.end()) {
-		return;
+}
+
+
+
+//////////////////////////////
+//
+// HumHash::findParameter -- Return the parameter stored for the given
+//     namespaces and key, or NULL if it is not defined.  The parameters
+//     are few for each object, so a linear search is faster than a search
+//     in nested maps.  The interned strings are read without locking.
+//
+
+HumParameter* HumHash::findParameter(const string& ns1, const string& ns2,
+		const string& key) const {
+	if ((parameters == NULL) || parameters->empty()) {
+		return NULL;
+	}
+	for (auto& entry : *parameters) {
+		if ((*entry.key == key) && (*entry.ns2 == ns2) && (*entry.ns1 == ns1)) {
+			return &entry.value;
+		}
 	}
-	auto it3 = it2->second.find(key);
-	if (it3 == it2->second.end()) {
+	return NULL;
+}
+
+
+
+//////////////////////////////
+//
+// HumHash::setParameter -- Set the value of the parameter, adding it to
+//     the list if it is not already defined.  The origin of a previously
+//     defined parameter is cleared.
+//
+
+void HumHash::setParameter(const string& ns1, const string& ns2,
+		const string& key, const string& value) {
+	HumParameter* parameter = findParameter(ns1, ns2, key);
+	if (parameter != NULL) {
+		*parameter = HumParameter(value);
 		return;
 	}
-	it2->second.erase(key);
+	initializeParameters();
+	HumHashEntry entry;
+	entry.ns1 = internKey(ns1);
+	entry.ns2 = internKey(ns2);
+	entry.key = internKey(key);
+	entry.value = HumParameter(value);
+	parameters->push_back(entry);
 }
 
 
 
 //////////////////////////////
 //
-// HumHash::initializeParameters -- Create the map structure if it does not
-//     already exist.
+// HumHash::getSortedEntries -- Return the parameters sorted by namespaces
+//     and keys, which is the order in which they are printed.  The strings
+//     are compared only when they are not the same interned string.
 //
 
-void HumHash::initializeParameters(void) {
+vector<const HumHashEntry*> HumHash::getSortedEntries(void) const {
+	vector<const HumHashEntry*> output;
 	if (parameters == NULL) {
-		parameters = new MapNNKV;
+		return output;
+	}
+	output.reserve(parameters->size());
+	for (auto& entry : *parameters) {
+		output.push_back(&entry);
 	}
+	std::sort(output.begin(), output.end(),
+		[](const HumHashEntry* a, const HumHashEntry* b) {
+			if (a->ns1 != b->ns1) {
+				return *a->ns1 < *b->ns1;
+			}
+			if (a->ns2 != b->ns2) {
+				return *a->ns2 < *b->ns2;
+			}
+			return *a->key < *b->key;
+		});
+	return output;
+}
+
+
+
+//////////////////////////////
+//
+// HumHash::internKey -- Return the interned copy of a namespace or key
+//     string, which is shared by all of the HumHash objects.  The nodes of
+//     the set are never moved or removed, so the strings can be read
+//     without locking.  Each thread keeps the keys it has already interned,
+//     so the set is only locked the first time a thread uses a key, and
+//     threads parsing files concurrently do not wait on each other.
+//
+
+const string* HumHash::internKey(const string& key) {
+	thread_local map<string, const string*> threadkeys;
+	auto found = threadkeys.find(key);
+	if (found != threadkeys.end()) {
+		return found->second;
+	}
+	const string* interned;
+	{
+		std::lock_guard<std::mutex> lock(keymutex);
+		interned = &(*keyset.insert(key).first);
+	}
+	threadkeys[key] = interned;
+	return interned;
 }
 
 
@@ -3211,23 +3260,11 @@ void HumHash::setOrigin(const string& ns2, const string& key,
 
 void HumHash::setOrigin(const string& ns1, const string& ns2,
 		const string& key, HumdrumToken* tok) {
-	if (parameters == NULL) {
+	HumParameter* parameter = findParameter(ns1, ns2, key);
+	if (parameter == NULL) {
 		return;
 	}
-	MapNNKV& p = *parameters;
-	auto it1 = p.find(ns1);
-	if (it1 == p.end()) {
-		return;
-	}
-	auto it2 = it1->second.find(ns2);
-	if (it2 == it1->second.end()) {
-		return;
-	}
-	auto it3 = it2->second.find(key);
-	if (it3 == it2->second.end()) {
-		return;
-	}
-	it3->second.origin = tok;
+	parameter->origin = tok;
 }
 
 
@@ -3271,23 +3308,11 @@ HumdrumToken* HumHash::getOrigin(const string& ns2, const string& key) const {
 
 HumdrumToken* HumHash::getOrigin(const string& ns1, const string& ns2,
 		const string& key) const {
-	if (parameters == NULL) {
-		return NULL;
-	}
-	MapNNKV& p = *parameters;
-	auto it1 = p.find(ns1);
-	if (it1 == p.end()) {
+	HumParameter* parameter = findParameter(ns1, ns2, key);
+	if (parameter == NULL) {
 		return NULL;
 	}
-	auto it2 = it1->second.find(ns2);
-	if (it2 == it1->second.end()) {
-		return NULL;
-	}
-	auto it3 = it2->second.find(key);
-	if (it3 == it2->second.end()) {
-		return NULL;
-	}
-	return it3->second.origin;
+	return parameter->origin;
 }
 
 
@@ -3305,51 +3330,52 @@ ostream& HumHash::printXml(ostream& out, int level, const string& indent) {
 	if (parameters->size() == 0) {
 		return out;
 	}
-	
+
 	stringstream str;
-	bool found = 0;
 
 	HumdrumToken* ref = NULL;
 	level++;
-	for (auto& it1 : *(parameters)) {
-		if (it1.second.size() == 0) {
-			continue;
-		}
-		if (!found) {
-			found = 1;
+	vector<const HumHashEntry*> entries = getSortedEntries();
+	for (int i=0; i<(int)entries.size(); i++) {
+		const HumHashEntry* entry = entries[i];
+		bool newns1 = (i == 0) || (entries[i-1]->ns1 != entry->ns1);
+		bool newns2 = newns1 || (entries[i-1]->ns2 != entry->ns2);
+		if (newns1) {
+			str << Convert::repeatString(indent, level++);
+			str << "<namespace n=\"1\" name=\"" << *entry->ns1;
+			str << "\">\n";
 		}
-		str << Convert::repeatString(indent, level++);
-		str << "<namespace n=\"1\" name=\"" << it1.first << "\">\n";
-		for (auto& it2 : it1.second) {
-			if (it2.second.size() == 0) {
-				continue;
-			}
-
+		if (newns2) {
 			str << Convert::repeatString(indent, level++);
-			str << "<namespace n=\"2\" name=\"" << it2.first << "\">\n";
-
-			for (auto& it3 : it2.second) {
-				str << Convert::repeatString(indent, level);
-				str << "<parameter key=\"" << it3.first << "\"";
-				str << " value=\"";
-				str << Convert::encodeXml(it3.second) << "\"";
-				str << " idref=\"";
-				ref = it3.second.origin;
-				if (ref != NULL) {
-					str << ref->getXmlId();
-				}
-				str << "\"";
-				str << "/>\n";
-			}
+			str << "<namespace n=\"2\" name=\"" << *entry->ns2;
+			str << "\">\n";
+		}
+
+		str << Convert::repeatString(indent, level);
+		str << "<parameter key=\"" << *entry->key << "\"";
+		str << " value=\"";
+		str << Convert::encodeXml(entry->value) << "\"";
+		str << " idref=\"";
+		ref = entry->value.origin;
+		if (ref != NULL) {
+			str << ref->getXmlId();
+		}
+		str << "\"";
+		str << "/>\n";
+
+		bool lastns1 = (i == (int)entries.size() - 1) ||
+				(entries[i+1]->ns1 != entry->ns1);
+		bool lastns2 = lastns1 || (entries[i+1]->ns2 != entry->ns2);
+		if (lastns2) {
+			str << Convert::repeatString(indent, --level) << "</namespace>\n";
+		}
+		if (lastns1) {
 			str << Convert::repeatString(indent, --level) << "</namespace>\n";
 		}
-		str << Convert::repeatString(indent, --level) << "</namespace>\n";
-	}
-	if (found) {
-		str << Convert::repeatString(indent, --level) << "</parameters>\n";
-		out << Convert::repeatString(indent, level) << "<parameters>\n";
-		out << str.str();
 	}
+	str << Convert::repeatString(indent, --level) << "</parameters>\n";
+	out << Convert::repeatString(indent, level) << "<parameters>\n";
+	out << str.str();
 
 	return out;
 }
@@ -3371,27 +3397,26 @@ ostream& operator<<(ostream& out, const HumHash& hash) {
 
 	string cleaned;
 
-	for (auto& it1 : *(hash.parameters)) {
-		if (it1.second.size() == 0) {
-			continue;
-		}
-		for (auto& it2 : it1.second) {
-			if (it2.second.size() == 0) {
-				continue;
+	vector<const HumHashEntry*> entries = hash.getSortedEntries();
+	for (int i=0; i<(int)entries.size(); i++) {
+		const HumHashEntry* entry = entries[i];
+		if ((i == 0) || (entries[i-1]->ns1 != entry->ns1) ||
+				(entries[i-1]->ns2 != entry->ns2)) {
+			if (i > 0) {
+				out << endl;
 			}
 			out << hash.prefix;
-			out << it1.first << ":" << it2.first;
-			for (auto& it3 : it2.second) {
-				out << ":" << it3.first;
-				if (it3.second != "true") {
-					cleaned = it3.second;
-					Convert::replaceOccurrences(cleaned, ":", "&colon;");
-					out << "=" << cleaned;
-				}
-			}
-			out << endl;
+			out << *entry->ns1 << ":";
+			out << *entry->ns2;
+		}
+		out << ":" << *entry->key;
+		if (entry->value != "true") {
+			cleaned = entry->value;
+			Convert::replaceOccurrences(cleaned, ":", "&colon;");
+			out << "=" << cleaned;
 		}
 	}
+	out << endl;
 
 	return out;
 }
@@ -5990,7 +6015,7 @@ HumdrumFileBase::HumdrumFileBase(istream& contents) : HumHash() {
 // using the following constructor:
 //
 
-HumdrumFileBase::HumdrumFileBase(HumdrumFileBase& infile) {
+HumdrumFileBase::HumdrumFileBase(HumdrumFileBase& infile) : HumHash(infile) {
 
 	m_filename = infile.m_filename;
 	m_segmentlevel = infile.m_segmentlevel;
@@ -10702,7 +10727,7 @@ HumdrumLine::HumdrumLine(const char* aString) : string(aString) {
 }
 
 
-HumdrumLine::HumdrumLine(HumdrumLine& line) {
+HumdrumLine::HumdrumLine(HumdrumLine& line) : HumHash(line) {
 	m_lineindex           = line.m_lineindex;
 	m_duration            = line.m_duration;
 	m_durationFromStart   = line.m_durationFromStart;
@@ -11,6 +11,10 @@
 
 #include <assert.h>
 
+//----------------------------------------------------------------------------
+
+#include "vrv.h"
+
 namespace vrv {
 
 //----------------------------------------------------------------------------
@@ -66,4 +70,14 @@ FileInputStream::~FileInputStream()
     }
 }
 
+void FileInputStream::SetMeasureRange(int first, int last)
+{
+    LogWarning("The measure range is supported only for MEI input and is ignored");
+}
+
+void FileInputStream::SetStaffSelection(const std::vector<int> &staffNs)
+{
+    LogWarning("The staff selection is supported only for MEI input and is ignored");
+}
+
 } // namespace vrv
@@ -27,6 +27,7 @@
 #include <assert.h>
 #include <cctype>
 #include <cmath>
+#include <mutex>
 #include <regex>
 #include <sstream>
 #include <vector>
@@ -61,6 +62,7 @@
 #include "octave.h"
 #include "page.h"
 #include "pedal.h"
+#include "profiler.h"
 #include "rest.h"
 #include "score.h"
 #include "section.h"
@@ -289,6 +291,8 @@ HumdrumInput::HumdrumInput(Doc *doc, std::string filename) : FileInputStream(doc
 
 #ifndef NO_HUMDRUM_SUPPORT
     m_filename = filename;
+    m_harm = false;
+    m_fb = false;
 #endif /* NO_HUMDRUM_SUPPORT */
 }
 
@@ -381,16 +385,19 @@ bool HumdrumInput::ImportString(std::string const &content)
         }
 
         bool result;
+        Profiler::Start("ReadHumdrum");
         if (comma < tab) {
             result = infile.readString(content);
         }
         else {
             result = infile.readStringCsv(content);
         }
+        Profiler::End();
 
         if (!result) {
             return false;
         }
+        ProfilerScope profilerScope("ConvertHumdrum");
         return convertHumdrum();
     }
     catch (char *str) {
@@ -413,7 +420,7 @@ bool HumdrumInput::ImportString(std::string const &content)
 //////////////////////////////
 //
 // HumdrumInput::GetHumdrumString -- direct Humdrum output before
-//    convesion.
+//    convesion (after the filters in the file have been applied).
 //
 
 string HumdrumInput::GetHumdrumString(void)
@@ -438,12 +445,8 @@ bool HumdrumInput::convertHumdrum(void)
 {
     hum::HumdrumFile &infile = m_infile;
 
-    if (GetOutputFormat() == "humdrum") {
-        // allow for filtering in toolkit.
-        return true;
-    }
-
     // apply Humdrum tools if there are any filters in the file.
+    // This is done only once here and GetHumdrumString returns the filtered data.
     if (infile.hasFilters()) {
         hum::Tool_filter filter;
         filter.run(infile);
@@ -459,6 +462,11 @@ bool HumdrumInput::convertHumdrum(void)
         }
     }
 
+    if (GetOutputFormat() == "humdrum") {
+        // no conversion needed, the filtered data is used as it is.
+        return true;
+    }
+
     m_multirest = analyzeMultiRest(infile);
 
     infile.analyzeKernSlurs();
@@ -6749,6 +6757,7 @@ static const EntityNameEntry StaticEntityNames[] = {
 typedef std::map<std::string, unsigned int> EntityNameMap;
 typedef std::pair<std::string, unsigned int> EntityNamePair;
 static EntityNameMap EntityNames;
+static std::mutex EntityNamesMutex;
 
 //////////////////////////////
 //
@@ -6834,14 +6843,18 @@ void HumdrumInput::UnquoteHTML(std::istream &In, std::ostream &Out)
                     ProcessedChar = true;
                 }
                 else if (ThisCh == ';') {
-                    if (EntityNames.empty()) {
-                        /* first use, load EntityNames from StaticEntityNames */
-                        const EntityNameEntry *ThisEntry;
-                        ThisEntry = StaticEntityNames;
-                        for (;;) {
-                            if (ThisEntry->Name == NULL) break;
-                            EntityNames.insert(EntityNamePair(std::string(ThisEntry->Name), ThisEntry->Value));
-                            ++ThisEntry;
+                    {
+                        /* the map is shared by the threads and is filled once */
+                        std::lock_guard<std::mutex> lock(EntityNamesMutex);
+                        if (EntityNames.empty()) {
+                            /* first use, load EntityNames from StaticEntityNames */
+                            const EntityNameEntry *ThisEntry;
+                            ThisEntry = StaticEntityNames;
+                            for (;;) {
+                                if (ThisEntry->Name == NULL) break;
+                                EntityNames.insert(EntityNamePair(std::string(ThisEntry->Name), ThisEntry->Value));
+                                ++ThisEntry;
+                            }
                         }
                     }
                     const EntityNameMap::const_iterator NameEntry = EntityNames.find(MatchingName);
@@ -10,8 +10,11 @@
 
 //----------------------------------------------------------------------------
 
+#include <algorithm>
 #include <assert.h>
+#include <fstream>
 #include <iostream>
+#include <set>
 
 //----------------------------------------------------------------------------
 
@@ -47,6 +50,7 @@
 #include "octave.h"
 #include "page.h"
 #include "pedal.h"
+#include "profiler.h"
 #include "proport.h"
 #include "rest.h"
 #include "rpt.h"
@@ -81,6 +85,7 @@ MeiOutput::MeiOutput(Doc *doc, std::string filename) : FileOutputStream(doc)
     m_writeToStreamString = false;
     m_page = -1;
     m_scoreBasedMEI = false;
+    m_outputStream = NULL;
 }
 
 MeiOutput::~MeiOutput()
@@ -89,6 +94,25 @@ MeiOutput::~MeiOutput()
 
 bool MeiOutput::ExportFile()
 {
+    // Check the page before opening (and truncating) the output file
+    if ((m_page >= 0) && (m_page >= m_doc->GetPageCount())) {
+        LogError("Page %d does not exist", m_page);
+        return false;
+    }
+
+    // The measures are written to the stream as soon as they are complete (see MeiOutput::FlushNode)
+    std::ofstream fileOutput;
+    if (m_writeToStreamString) {
+        m_outputStream = &m_streamStringOutput;
+    }
+    else {
+        fileOutput.open(m_filename.c_str(), std::ios::out | std::ios::binary);
+        if (!fileOutput.is_open()) {
+            return false;
+        }
+        m_outputStream = &fileOutput;
+    }
+
     try {
         pugi::xml_document meiDoc;
 
@@ -119,12 +143,10 @@ bool MeiOutput::ExportFile()
             m_doc->Save(this);
         }
         else {
-            if (m_page >= m_doc->GetPageCount()) {
-                LogError("Page %d does not exist", m_page);
-                return false;
-            }
             Page *page = dynamic_cast<Page *>(m_doc->GetChild(m_page));
             assert(page);
+            // The declaration pugixml adds when saving a document without one
+            *m_outputStream << "<?xml version=\"1.0\"?>\n";
             if (m_scoreBasedMEI) {
                 m_currentNode = meiDoc.append_child("score");
                 m_currentNode = m_currentNode.append_child("section");
@@ -138,23 +160,105 @@ bool MeiOutput::ExportFile()
 
             page->Save(this);
         }
-        if (m_writeToStreamString) {
-            // meiDoc.save(m_streamStringOutput, "    ", pugi::format_default | pugi::format_no_escapes);
-            meiDoc.save(m_streamStringOutput, "    ");
+
+        // Close the open elements and write what remains in the document
+        while (!m_openNodes.empty()) {
+            this->CloseNode(m_openNodes.back(), (int)m_openNodes.size() - 1);
+            m_openNodes.pop_back();
         }
-        else {
-            // meiDoc.save_file(m_filename.c_str(), "    ", pugi::format_default | pugi::format_no_escapes);
-            meiDoc.save_file(m_filename.c_str(), "    ");
+        while (meiDoc.first_child()) {
+            this->WriteNode(meiDoc.first_child(), 0);
         }
     }
     catch (char *str) {
         LogError("%s", str);
+        m_openNodes.clear();
+        m_outputStream = NULL;
         return false;
     }
 
+    m_outputStream = NULL;
+    if (!m_writeToStreamString) {
+        fileOutput.close();
+        if (fileOutput.fail()) return false;
+    }
+
     return true;
 }
 
+void MeiOutput::FlushNode(pugi::xml_node node)
+{
+    assert(m_outputStream);
+
+    // The ancestor elements from the top
+    std::vector<pugi::xml_node> ancestors;
+    for (pugi::xml_node parent = node.parent(); parent.type() == pugi::node_element; parent = parent.parent()) {
+        ancestors.insert(ancestors.begin(), parent);
+    }
+
+    // The open elements that are not ancestors anymore are complete and can be closed
+    size_t common = 0;
+    while ((common < m_openNodes.size()) && (common < ancestors.size())
+        && (m_openNodes.at(common) == ancestors.at(common))) {
+        ++common;
+    }
+    while (m_openNodes.size() > common) {
+        this->CloseNode(m_openNodes.back(), (int)m_openNodes.size() - 1);
+        m_openNodes.pop_back();
+    }
+
+    // Open the ancestors after what precedes them
+    for (size_t i = common; i < ancestors.size(); ++i) {
+        this->WritePrecedingNodes(ancestors.at(i), (int)i);
+        this->WriteStartTag(ancestors.at(i), (int)i);
+        m_openNodes.push_back(ancestors.at(i));
+    }
+
+    this->WritePrecedingNodes(node, (int)ancestors.size());
+    this->WriteNode(node, (int)ancestors.size());
+}
+
+void MeiOutput::WriteNode(pugi::xml_node node, int depth)
+{
+    node.print(*m_outputStream, "    ", pugi::format_default, pugi::encoding_auto, depth);
+    node.parent().remove_child(node);
+}
+
+void MeiOutput::WritePrecedingNodes(pugi::xml_node node, int depth)
+{
+    pugi::xml_node parent = node.parent();
+    while (parent.first_child() != node) {
+        this->WriteNode(parent.first_child(), depth);
+    }
+}
+
+void MeiOutput::WriteStartTag(pugi::xml_node node, int depth)
+{
+    // Let pugixml write the element without its children for having the same indentation and escaping
+    pugi::xml_document tag;
+    pugi::xml_node element = tag.append_child(node.name());
+    for (pugi::xml_attribute attribute : node.attributes()) {
+        element.append_copy(attribute);
+    }
+    std::ostringstream output;
+    element.print(output, "    ", pugi::format_default, pugi::encoding_auto, depth);
+
+    // Replace the " />\n" of the empty element
+    std::string startTag = output.str();
+    assert(startTag.size() > 4);
+    startTag.replace(startTag.size() - 4, 4, ">\n");
+    *m_outputStream << startTag;
+}
+
+void MeiOutput::CloseNode(pugi::xml_node node, int depth)
+{
+    while (node.first_child()) {
+        this->WriteNode(node.first_child(), depth + 1);
+    }
+    *m_outputStream << std::string(depth * 4, ' ') << "</" << node.name() << ">\n";
+    node.parent().remove_child(node);
+}
+
 std::string MeiOutput::GetOutput(int page)
 {
     m_writeToStreamString = true;
@@ -533,9 +637,15 @@ bool MeiOutput::WriteObjectEnd(Object *object)
     else if (m_scoreBasedMEI && (object->Is(PAGE))) {
         return true;
     }
+    pugi::xml_node node = m_nodeStack.back();
     m_nodeStack.pop_back();
     m_currentNode = m_nodeStack.back();
 
+    // A measure is complete and does not need to be kept in the document
+    if (object->Is(MEASURE)) {
+        this->FlushNode(node);
+    }
+
     return true;
 }
 
@@ -1555,6 +1665,9 @@ MeiInput::MeiInput(Doc *doc, std::string filename) : FileInputStream(doc)
     m_hasScoreDef = false;
     m_readingScoreBased = false;
     m_version = MEI_UNDEFINED;
+    m_measureRangeFirst = VRV_UNSET;
+    m_measureRangeLast = VRV_UNSET;
+    m_measureRangePosition = MEASURE_RANGE_IN;
 }
 
 MeiInput::~MeiInput()
@@ -1584,8 +1697,30 @@ bool MeiInput::ImportString(std::string const &mei)
     try {
         m_doc->SetType(Raw);
         pugi::xml_document doc;
+        Profiler::Start("ParseXml");
         doc.load(mei.c_str(), pugi::parse_default & ~pugi::parse_eol);
+        Profiler::End();
+        pugi::xml_node root = doc.first_child();
+        ProfilerScope profilerScope("ReadMei");
+        return ReadMei(root);
+    }
+    catch (char *str) {
+        LogError("%s", str);
+        return false;
+    }
+}
+
+bool MeiInput::ImportBuffer(char *data, size_t length)
+{
+    try {
+        m_doc->SetType(Raw);
+        pugi::xml_document doc;
+        // Parse the buffer in place without copying it
+        Profiler::Start("ParseXml");
+        doc.load_buffer_inplace(data, length, pugi::parse_default & ~pugi::parse_eol);
+        Profiler::End();
         pugi::xml_node root = doc.first_child();
+        ProfilerScope profilerScope("ReadMei");
         return ReadMei(root);
     }
     catch (char *str) {
@@ -1771,11 +1906,17 @@ bool MeiInput::ReadMei(pugi::xml_node root)
     pugi::xml_node current;
     bool success = true;
     m_readingScoreBased = false;
+    m_measureRangePosition = (m_measureRangeFirst != VRV_UNSET) ? MEASURE_RANGE_BEFORE : MEASURE_RANGE_IN;
+    m_skippedClefs.reset();
+    m_skippedTimeSpanning.reset();
+    m_staffSelectionRead.clear();
 
     if (!root.empty() && (current = root.child("meiHead"))) {
         m_doc->m_header.reset();
         // copy the complete header into the master document
         m_doc->m_header.append_copy(current);
+        // The xpath queries for <app> or <choice> can refer to the header
+        if (m_appXPathQueries.empty() && m_choiceXPathQueries.empty()) root.remove_child(current);
         if (root.attribute("meiversion")) {
             std::string version = std::string(root.attribute("meiversion").value());
             if (version == "2013")
@@ -1847,6 +1988,22 @@ bool MeiInput::ReadMei(pugi::xml_node root)
         }
     }
 
+    if (success && (m_measureRangeFirst != VRV_UNSET)) {
+        if (m_measureRangePosition == MEASURE_RANGE_BEFORE) {
+            LogError("The measure range %d-%d could not be found", m_measureRangeFirst, m_measureRangeLast);
+            return false;
+        }
+        m_doc->SetExcerpt(true);
+    }
+
+    if (success) {
+        for (auto n : m_staffSelection) {
+            if (m_staffSelectionRead.count(n)) continue;
+            LogError("The staff %d of the staff selection could not be found", n);
+            return false;
+        }
+    }
+
     if (success && !m_hasScoreDef) {
         LogMessage("No scoreDef provided, trying to generate one...");
         success = m_doc->GenerateDocumentScoreDef();
@@ -1855,6 +2012,130 @@ bool MeiInput::ReadMei(pugi::xml_node root)
     return success;
 }
 
+bool MeiInput::IsInMeasureRange(pugi::xml_node measure)
+{
+    if (m_measureRangeFirst == VRV_UNSET) return true;
+    if (m_measureRangePosition == MEASURE_RANGE_AFTER) return false;
+
+    int n = (measure.attribute("n")) ? atoi(measure.attribute("n").value()) : VRV_UNSET;
+    if (m_measureRangePosition == MEASURE_RANGE_BEFORE) {
+        if (n != m_measureRangeFirst) {
+            StoreSkippedClefs(measure);
+            StoreSkippedTimeSpanning(measure);
+            return false;
+        }
+        m_measureRangePosition = MEASURE_RANGE_IN;
+    }
+    if (n == m_measureRangeLast) m_measureRangePosition = MEASURE_RANGE_AFTER;
+    return true;
+}
+
+bool MeiInput::IsInStaffSelection(pugi::xml_node element)
+{
+    if (m_staffSelection.empty()) return true;
+
+    // <staff> and <staffDef> have a @n, control elements a @staff with one or more values
+    std::string name = element.name();
+    bool isStaff = ((name == "staff") || (name == "staffDef"));
+    pugi::xml_attribute staffNs = element.attribute((isStaff) ? "n" : "staff");
+
+    // Control elements without @staff (e.g., ties with only a @startid) follow the staff of their start in the
+    // measure. The ones moved to the first measure of the range were already checked in their own measure.
+    if (!staffNs && !isStaff && element.attribute("startid")) {
+        pugi::xml_node measure = element.parent();
+        while (measure && (std::string(measure.name()) != "measure")) measure = measure.parent();
+        std::string xpath = StringFormat(
+            ".//staff[.//*[@xml:id='%s']]", ExtractUuidFragment(element.attribute("startid").value()).c_str());
+        pugi::xpath_node staff = (measure) ? measure.select_node(xpath.c_str()) : pugi::xpath_node();
+        if (staff) staffNs = staff.node().attribute("n");
+    }
+    if (!staffNs) return true;
+
+    std::istringstream iss(staffNs.value());
+    int n;
+    while (iss >> n) {
+        if (std::find(m_staffSelection.begin(), m_staffSelection.end(), n) != m_staffSelection.end()) return true;
+    }
+    return false;
+}
+
+void MeiInput::StoreSkippedClefs(pugi::xml_node measure)
+{
+    pugi::xpath_node_set staves = measure.select_nodes(".//staff[@n]");
+    for (pugi::xpath_node_set::const_iterator iter = staves.begin(); iter != staves.end(); ++iter) {
+        pugi::xml_node staff = iter->node();
+        if (!IsInStaffSelection(staff)) continue;
+        pugi::xpath_node_set clefs = staff.select_nodes(".//clef[@shape]");
+        if (clefs.empty()) continue;
+        pugi::xml_node clef = clefs[clefs.size() - 1].node();
+
+        if (!m_skippedClefs.first_child()) m_skippedClefs.append_child("scoreDef").append_child("staffGrp");
+        pugi::xml_node staffGrp = m_skippedClefs.first_child().first_child();
+        pugi::xml_node staffDef = staffGrp.find_child_by_attribute("staffDef", "n", staff.attribute("n").value());
+        if (staffDef) staffGrp.remove_child(staffDef);
+        staffDef = staffGrp.append_child("staffDef");
+        staffDef.append_attribute("n") = staff.attribute("n").value();
+        staffDef.append_attribute("clef.shape") = clef.attribute("shape").value();
+        if (clef.attribute("line")) staffDef.append_attribute("clef.line") = clef.attribute("line").value();
+        if (clef.attribute("dis")) staffDef.append_attribute("clef.dis") = clef.attribute("dis").value();
+        if (clef.attribute("dis.place"))
+            staffDef.append_attribute("clef.dis.place") = clef.attribute("dis.place").value();
+    }
+}
+
+void MeiInput::ForgetSkippedClefs(pugi::xml_node scoreDef)
+{
+    if (!m_skippedClefs.first_child()) return;
+
+    // A clef given in a <scoreDef> overrides the clefs of the measures skipped before it
+    pugi::xml_node staffGrp = m_skippedClefs.first_child().first_child();
+    pugi::xpath_node_set staffDefs = scoreDef.select_nodes(".//staffDef[@n and @clef.shape]");
+    for (pugi::xpath_node_set::const_iterator iter = staffDefs.begin(); iter != staffDefs.end(); ++iter) {
+        pugi::xml_node staffDef
+            = staffGrp.find_child_by_attribute("staffDef", "n", iter->node().attribute("n").value());
+        if (staffDef) staffGrp.remove_child(staffDef);
+    }
+}
+
+void MeiInput::StoreSkippedTimeSpanning(pugi::xml_node measure)
+{
+    std::set<std::string> ids;
+    pugi::xpath_node_set elements = measure.select_nodes(".//*[@xml:id]");
+    for (pugi::xpath_node_set::const_iterator iter = elements.begin(); iter != elements.end(); ++iter) {
+        ids.insert(iter->node().attribute("xml:id").value());
+    }
+
+    if (!m_skippedTimeSpanning.first_child()) m_skippedTimeSpanning.append_child("measure");
+    pugi::xml_node skipped = m_skippedTimeSpanning.first_child();
+
+    // The ones ending in this measure do not reach the range
+    pugi::xml_node current = skipped.first_child();
+    while (current) {
+        pugi::xml_node next = current.next_sibling();
+        if (ids.count(ExtractUuidFragment(current.attribute("endid").value()))) skipped.remove_child(current);
+        current = next;
+    }
+
+    // The ones not ending in this measure might
+    for (current = measure.first_child(); current; current = current.next_sibling()) {
+        if (!current.attribute("endid") || !IsInStaffSelection(current)) continue;
+        if (ids.count(ExtractUuidFragment(current.attribute("endid").value()))) continue;
+        skipped.append_copy(current);
+    }
+}
+
+pugi::xml_node MeiInput::ReleaseNode(pugi::xml_node node)
+{
+    pugi::xml_node next = node.next_sibling();
+    if (m_appXPathQueries.empty() && m_choiceXPathQueries.empty()) {
+        std::string name = node.name();
+        if ((name == "measure") || (name == "staff")) {
+            node.parent().remove_child(node);
+        }
+    }
+    return next;
+}
+
 bool MeiInput::ReadMeiSection(Object *parent, pugi::xml_node section)
 {
     Section *vrvSection = new Section();
@@ -1878,8 +2159,12 @@ bool MeiInput::ReadMeiSectionChildren(Object *parent, pugi::xml_node parentNode)
     bool success = true;
     pugi::xml_node current;
     Measure *unmeasured = NULL;
-    for (current = parentNode.first_child(); current; current = current.next_sibling()) {
+    for (current = parentNode.first_child(); current; current = ReleaseNode(current)) {
         if (!success) break;
+        // nothing to read after the measure range
+        else if (m_measureRangePosition == MEASURE_RANGE_AFTER) {
+            break;
+        }
         // editorial
         else if (IsEditorialElementName(current.name())) {
             success = ReadMeiEditorialElement(parent, current, EDITORIAL_TOPLEVEL);
@@ -1894,17 +2179,18 @@ bool MeiInput::ReadMeiSectionChildren(Object *parent, pugi::xml_node parentNode)
             success = ReadMeiExpansion(parent, current);
         }
         else if (std::string(current.name()) == "scoreDef") {
+            if (m_measureRangeFirst != VRV_UNSET) ForgetSkippedClefs(current);
             success = ReadMeiScoreDef(parent, current);
         }
         else if (std::string(current.name()) == "section") {
             success = ReadMeiSection(parent, current);
         }
-        // pb and sb
+        // pb and sb (skipped before the measure range)
         else if (std::string(current.name()) == "pb") {
-            success = ReadMeiPb(parent, current);
+            if (m_measureRangePosition == MEASURE_RANGE_IN) success = ReadMeiPb(parent, current);
         }
         else if (std::string(current.name()) == "sb") {
-            success = ReadMeiSb(parent, current);
+            if (m_measureRangePosition == MEASURE_RANGE_IN) success = ReadMeiSb(parent, current);
         }
         // unmeasured music
         else if (std::string(current.name()) == "staff") {
@@ -1926,6 +2212,20 @@ bool MeiInput::ReadMeiSectionChildren(Object *parent, pugi::xml_node parentNode)
             // if (parent->IsEditorialElement()) {
             //    m_hasMeasureWithinEditMarkup = true;
             //}
+            if (!IsInMeasureRange(current)) continue;
+            // the clef changes of the measures skipped before the range
+            if (m_skippedClefs.first_child()) {
+                success = ReadMeiScoreDef(parent, m_skippedClefs.first_child());
+                m_skippedClefs.reset();
+                if (!success) break;
+            }
+            // the time spanning elements started before the range
+            if (m_skippedTimeSpanning.first_child()) {
+                for (pugi::xml_node child : m_skippedTimeSpanning.first_child().children()) {
+                    current.append_copy(child);
+                }
+                m_skippedTimeSpanning.reset();
+            }
             success = ReadMeiMeasure(parent, current);
         }
         else {
@@ -2102,7 +2402,7 @@ bool MeiInput::ReadMeiSystemChildren(Object *parent, pugi::xml_node parentNode)
     bool success = true;
     pugi::xml_node current;
     Measure *unmeasured = NULL;
-    for (current = parentNode.first_child(); current; current = current.next_sibling()) {
+    for (current = parentNode.first_child(); current; current = ReleaseNode(current)) {
         if (!success) break;
         // editorial
         else if (IsEditorialElementName(current.name())) {
@@ -2243,7 +2543,11 @@ bool MeiInput::ReadMeiStaffGrp(Object *parent, pugi::xml_node staffGrp)
     vrvStaffGrp->ReadTyped(staffGrp);
 
     parent->AddChild(vrvStaffGrp);
-    return ReadMeiStaffGrpChildren(vrvStaffGrp, staffGrp);
+    if (!ReadMeiStaffGrpChildren(vrvStaffGrp, staffGrp)) return false;
+
+    // A staffGrp left without staffDef by the staff selection is removed
+    if (!m_staffSelection.empty() && (vrvStaffGrp->GetChildCount() == 0)) parent->DeleteChild(vrvStaffGrp);
+    return true;
 }
 
 bool MeiInput::ReadMeiStaffGrpChildren(Object *parent, pugi::xml_node parentNode)
@@ -2263,7 +2567,7 @@ bool MeiInput::ReadMeiStaffGrpChildren(Object *parent, pugi::xml_node parentNode
             success = ReadMeiStaffGrp(parent, current);
         }
         else if (std::string(current.name()) == "staffDef") {
-            success = ReadMeiStaffDef(parent, current);
+            if (IsInStaffSelection(current)) success = ReadMeiStaffDef(parent, current);
         }
         else {
             LogWarning("Unsupported '<%s>' within <staffGrp>", current.name());
@@ -2329,6 +2633,10 @@ bool MeiInput::ReadMeiMeasureChildren(Object *parent, pugi::xml_node parentNode)
         else if (IsEditorialElementName(current.name())) {
             success = ReadMeiEditorialElement(parent, current, EDITORIAL_MEASURE);
         }
+        // staves and control elements outside the staff selection
+        else if (!IsInStaffSelection(current)) {
+            continue;
+        }
         // content
         else if (std::string(current.name()) == "anchoredText") {
             success = ReadMeiAnchoredText(parent, current);
@@ -2633,6 +2941,9 @@ bool MeiInput::ReadMeiStaff(Object *parent, pugi::xml_node staff)
     if (!vrvStaff->HasN() || (vrvStaff->GetN() == 0)) {
         LogWarning("No @n on <staff> or a value of 0 might yield unpredictable results");
     }
+    else if (!m_staffSelection.empty()) {
+        m_staffSelectionRead.insert(vrvStaff->GetN());
+    }
 
     parent->AddChild(vrvStaff);
     return ReadMeiStaffChildren(vrvStaff, staff);
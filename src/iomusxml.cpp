@@ -31,6 +31,7 @@
 #include "note.h"
 #include "octave.h"
 #include "pedal.h"
+#include "profiler.h"
 #include "rest.h"
 #include "rpt.h"
 #include "score.h"
@@ -86,8 +87,30 @@ bool MusicXmlInput::ImportString(std::string const &musicxml)
     try {
         m_doc->SetType(Raw);
         pugi::xml_document xmlDoc;
+        Profiler::Start("ParseXml");
         xmlDoc.load(musicxml.c_str());
+        Profiler::End();
         pugi::xml_node root = xmlDoc.first_child();
+        ProfilerScope profilerScope("ReadMusicXml");
+        return ReadMusicXml(root);
+    }
+    catch (char *str) {
+        LogError("%s", str);
+        return false;
+    }
+}
+
+bool MusicXmlInput::ImportBuffer(char *data, size_t length)
+{
+    try {
+        m_doc->SetType(Raw);
+        pugi::xml_document xmlDoc;
+        // Parse the buffer in place without copying it
+        Profiler::Start("ParseXml");
+        xmlDoc.load_buffer_inplace(data, length);
+        Profiler::End();
+        pugi::xml_node root = xmlDoc.first_child();
+        ProfilerScope profilerScope("ReadMusicXml");
         return ReadMusicXml(root);
     }
     catch (char *str) {
@@ -158,24 +181,49 @@ std::string MusicXmlInput::GetContent(pugi::xml_node node)
 
 std::string MusicXmlInput::GetContentOfChild(pugi::xml_node node, std::string child)
 {
-    pugi::xpath_node childNode = node.select_single_node(child.c_str());
-    if (childNode && HasContent(childNode.node())) {
-        return GetContent(childNode.node());
+    pugi::xml_node childNode = node.first_element_by_path(child.c_str());
+    if (childNode && HasContent(childNode)) {
+        return GetContent(childNode);
     }
     return "";
 }
 
+pugi::xml_node MusicXmlInput::GetChildWithAttribute(pugi::xml_node node, std::string child, std::string attribute)
+{
+    for (pugi::xml_node childNode = node.child(child.c_str()); childNode;
+         childNode = childNode.next_sibling(child.c_str())) {
+        if (childNode.attribute(attribute.c_str())) return childNode;
+    }
+    return pugi::xml_node();
+}
+
+pugi::xml_node MusicXmlInput::GetChildWithNumber(pugi::xml_node node, std::string child, int number, std::string path)
+{
+    std::string numberStr = std::to_string(number);
+    for (pugi::xml_node childNode = node.child(child.c_str()); childNode;
+         childNode = childNode.next_sibling(child.c_str())) {
+        if (!HasAttributeWithValue(childNode, "number", numberStr)) continue;
+        if (path.empty()) return childNode;
+        pugi::xml_node pathNode = childNode.first_element_by_path(path.c_str());
+        if (pathNode) return pathNode;
+    }
+    return pugi::xml_node();
+}
+
 void MusicXmlInput::AddMeasure(Section *section, Measure *measure, int i)
 {
     assert(section);
     assert(i >= 0);
 
+    // the section contains only measures at this stage, so we do not need to count them by class
+    int measureCount = section->GetChildCount();
+
     // we just need to add a measure
-    if (i == section->GetChildCount(MEASURE)) {
+    if (i == measureCount) {
         section->AddChild(measure);
     }
     // otherwise copy the content to the corresponding existing measure
-    else if (section->GetChildCount(MEASURE) > i) {
+    else if (measureCount > i) {
         Measure *existingMeasure = dynamic_cast<Measure *>(section->GetChild(i));
         assert(existingMeasure);
         Object *current;
@@ -356,10 +404,10 @@ void MusicXmlInput::CloseSlur(Staff *staff, Layer *layer, int number, LayerEleme
 //////////////////////////////////////////////////////////////////////////////
 // Text rendering
 
-void MusicXmlInput::TextRendition(pugi::xpath_node_set words, ControlElement *element)
+void MusicXmlInput::TextRendition(const std::vector<pugi::xml_node> &words, ControlElement *element)
 {
-    for (pugi::xpath_node_set::const_iterator it = words.begin(); it != words.end(); ++it) {
-        pugi::xml_node textNode = it->node();
+    for (std::vector<pugi::xml_node>::const_iterator it = words.begin(); it != words.end(); ++it) {
+        pugi::xml_node textNode = *it;
         std::string textStr = GetContent(textNode);
         std::string textAlign = GetAttributeValue(textNode, "halign");
         std::string textColor = GetAttributeValue(textNode, "color");
@@ -391,16 +439,20 @@ void MusicXmlInput::TextRendition(pugi::xpath_node_set words, ControlElement *el
 void MusicXmlInput::PrintMetronome(pugi::xml_node metronome, Tempo *tempo)
 {
     std::string tempoText = "M.M.";
-    if (metronome.select_single_node("per-minute").node()) {
-        std::string mm = GetContent(metronome.select_single_node("per-minute").node());
+    if (metronome.child("per-minute")) {
+        std::string mm = GetContent(metronome.child("per-minute"));
         if (atoi(mm.c_str())) tempo->SetMm(mm.c_str());
         tempoText = tempoText + StringFormat(" = %s", mm.c_str());
     }
-    if (metronome.select_single_node("beat-unit").node()) {
-        tempo->SetMmUnit(ConvertTypeToDur(GetContent(metronome.select_single_node("beat-unit").node())));
+    if (metronome.child("beat-unit")) {
+        tempo->SetMmUnit(ConvertTypeToDur(GetContent(metronome.child("beat-unit"))));
     }
-    if (metronome.select_single_node("beat-unit-dot")) {
-        tempo->SetMmDots((int)metronome.select_nodes("beat-unit-dot").size());
+    if (metronome.child("beat-unit-dot")) {
+        int dots = 0;
+        for (pugi::xml_node dot = metronome.child("beat-unit-dot"); dot; dot = dot.next_sibling("beat-unit-dot")) {
+            dots++;
+        }
+        tempo->SetMmDots(dots);
     }
     if (GetAttributeValue(metronome, "parentheses") == "yes") tempoText = "(" + tempoText + ")";
     Text *text = new Text();
@@ -430,17 +482,28 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
     int staffOffset = 0;
     m_octDis.push_back(0);
 
-    pugi::xpath_node scoreMidiBpm = root.select_single_node("/score-partwise/part[1]/measure[1]/sound[@tempo][1]");
-    if (scoreMidiBpm) m_doc->m_scoreDef.SetMidiBpm(atoi(GetAttributeValue(scoreMidiBpm.node(), "tempo").c_str()));
+    pugi::xml_node scorePartwise = root.root().child("score-partwise");
+
+    // index the parts by id once instead of looking for each of them with an XPath query
+    std::map<std::string, pugi::xml_node> parts;
+    for (pugi::xml_node part = scorePartwise.child("part"); part; part = part.next_sibling("part")) {
+        // keep the first one if the id is duplicated
+        parts.insert(std::make_pair(std::string(part.attribute("id").as_string()), part));
+    }
+
+    pugi::xml_node scoreMidiBpm
+        = GetChildWithAttribute(scorePartwise.child("part").child("measure"), "sound", "tempo");
+    if (scoreMidiBpm) m_doc->m_scoreDef.SetMidiBpm(atoi(GetAttributeValue(scoreMidiBpm, "tempo").c_str()));
 
-    pugi::xpath_node_set partListChildren = root.select_nodes("/score-partwise/part-list/*");
-    for (pugi::xpath_node_set::const_iterator it = partListChildren.begin(); it != partListChildren.end(); ++it) {
-        pugi::xpath_node xpathNode = *it;
-        if (IsElement(xpathNode.node(), "part-group")) {
-            if (HasAttributeWithValue(xpathNode.node(), "type", "start")) {
+    pugi::xml_node partList = scorePartwise.child("part-list");
+    for (pugi::xml_node::iterator it = partList.begin(); it != partList.end(); ++it) {
+        if (it->type() != pugi::node_element) continue;
+        pugi::xml_node xmlNode = *it;
+        if (IsElement(xmlNode, "part-group")) {
+            if (HasAttributeWithValue(xmlNode, "type", "start")) {
                 StaffGrp *staffGrp = new StaffGrp();
                 // read the group-symbol (MEI @symbol)
-                std::string groupGymbol = GetContentOfChild(xpathNode.node(), "group-symbol");
+                std::string groupGymbol = GetContentOfChild(xmlNode, "group-symbol");
                 if (groupGymbol == "bracket") {
                     staffGrp->SetSymbol(staffgroupingsym_SYMBOL_bracket);
                 }
@@ -459,22 +522,23 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
                 m_staffGrpStack.pop_back();
             }
         }
-        else if (IsElement(xpathNode.node(), "score-part")) {
+        else if (IsElement(xmlNode, "score-part")) {
             // get the attributes element of the first measure of the part
-            std::string partId = xpathNode.node().attribute("id").as_string();
-            std::string xpath = StringFormat("/score-partwise/part[@id='%s']/measure[1]", partId.c_str());
-            pugi::xpath_node partFirstMeasure = root.select_single_node(xpath.c_str());
-            if (!partFirstMeasure.node().select_single_node("attributes")) {
+            std::string partId = xmlNode.attribute("id").as_string();
+            std::map<std::string, pugi::xml_node>::iterator partIter = parts.find(partId);
+            pugi::xml_node part = (partIter != parts.end()) ? partIter->second : pugi::xml_node();
+            pugi::xml_node partFirstMeasure = part.child("measure");
+            if (!partFirstMeasure.child("attributes")) {
                 LogWarning("Could not find the 'attributes' element in the first "
                            "measure of part '%s'",
                     partId.c_str());
                 continue;
             }
-            std::string partName = GetContentOfChild(xpathNode.node(), "part-name");
-            std::string partAbbr = GetContentOfChild(xpathNode.node(), "part-abbreviation");
+            std::string partName = GetContentOfChild(xmlNode, "part-name");
+            std::string partAbbr = GetContentOfChild(xmlNode, "part-abbreviation");
             // create the staffDef(s)
             StaffGrp *partStaffGrp = new StaffGrp();
-            int nbStaves = ReadMusicXmlPartAttributesAsStaffDef(partFirstMeasure.node(), partStaffGrp, staffOffset);
+            int nbStaves = ReadMusicXmlPartAttributesAsStaffDef(partFirstMeasure, partStaffGrp, staffOffset);
             // if we have more than one staff in the part we create a new staffGrp
             if (nbStaves > 1) {
                 partStaffGrp->SetLabel(partName);
@@ -493,14 +557,12 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
                 delete partStaffGrp;
             }
 
-            // find the part and read it
-            xpath = StringFormat("/score-partwise/part[@id='%s']", partId.c_str());
-            pugi::xpath_node part = root.select_single_node(xpath.c_str());
+            // read the part
             if (!part) {
                 LogWarning("Could not find the part '%s'", partId.c_str());
                 continue;
             }
-            ReadMusicXmlPart(part.node(), section, nbStaves, staffOffset);
+            ReadMusicXmlPart(part, section, nbStaves, staffOffset);
             // increment the staffOffset for reading the next part
             staffOffset += nbStaves;
         }
@@ -509,13 +571,18 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
     }
     // here we could check that we have that there is only one staffGrp left in m_staffGrpStack
 
-    Measure *measure = NULL;
+    // index the measures by @n (the first one for each @n) for adding the control elements
+    std::map<int, Measure *> measures;
+    for (int i = 0; i < section->GetChildCount(); i++) {
+        Measure *measure = dynamic_cast<Measure *>(section->GetChild(i));
+        assert(measure);
+        measures.insert(std::make_pair(measure->GetN(), measure));
+    }
+
     std::vector<std::pair<int, ControlElement *> >::iterator iter;
     for (iter = m_controlElements.begin(); iter != m_controlElements.end(); iter++) {
-        if (!measure || (measure->GetN() != iter->first)) {
-            AttCommonNComparison comparisonMeasure(MEASURE, iter->first);
-            measure = dynamic_cast<Measure *>(section->FindChildByAttComparison(&comparisonMeasure, 1));
-        }
+        std::map<int, Measure *>::iterator measureIter = measures.find(iter->first);
+        Measure *measure = (measureIter != measures.end()) ? measureIter->second : NULL;
         if (!measure) {
             LogWarning(
                 "Element '%s' could not be added to measure '%d'", iter->second->GetClassName().c_str(), iter->first);
@@ -533,8 +600,9 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
 void MusicXmlInput::ReadMusicXmlTitle(pugi::xml_node root)
 {
     assert(root);
-    pugi::xpath_node workTitle = root.select_single_node("/score-partwise/work/work-title");
-    pugi::xpath_node movementTitle = root.select_single_node("/score-partwise/movement-title");
+    pugi::xml_node scorePartwise = root.root().child("score-partwise");
+    pugi::xml_node workTitle = scorePartwise.first_element_by_path("work/work-title");
+    pugi::xml_node movementTitle = scorePartwise.child("movement-title");
     pugi::xml_node meiHead = m_doc->m_header.append_child("meiHead");
 
     // <fileDesc> /////////////
@@ -542,9 +610,9 @@ void MusicXmlInput::ReadMusicXmlTitle(pugi::xml_node root)
     pugi::xml_node titleStmt = fileDesc.append_child("titleStmt");
     pugi::xml_node meiTitle = titleStmt.append_child("title");
     if (movementTitle)
-        meiTitle.text().set(GetContent(movementTitle.node()).c_str());
+        meiTitle.text().set(GetContent(movementTitle).c_str());
     else if (workTitle)
-        meiTitle.text().set(GetContent(workTitle.node()).c_str());
+        meiTitle.text().set(GetContent(workTitle).c_str());
 
     pugi::xml_node pubStmt = fileDesc.append_child("pubStmt");
     pubStmt.append_child(pugi::node_pcdata);
@@ -589,7 +657,7 @@ int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(pugi::xml_node node, Sta
         if (IsElement(*it, "attributes")) it->set_name("mei-read");
 
         // First get the number of staves in the part
-        pugi::xpath_node staves = it->select_single_node("staves");
+        pugi::xpath_node staves = it->child("staves");
         if (staves) {
             if (staves.node().text()) {
                 int values = atoi(staves.node().text().as_string());
@@ -598,7 +666,6 @@ int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(pugi::xml_node node, Sta
         }
 
         int i;
-        std::string xpath;
         // Create as many staffDef
         for (i = 0; i < nbStaves; i++) {
             // Find or create the staffDef
@@ -615,11 +682,10 @@ int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(pugi::xml_node node, Sta
 
             // clef sign - first look if we have a clef-sign with the corresponding staff @number
             pugi::xpath_node clefSign;
-            xpath = StringFormat("clef[@number='%d']/sign", i + 1);
-            clefSign = it->select_single_node(xpath.c_str());
+            clefSign = GetChildWithNumber(*it, "clef", i + 1, "sign");
             // if not, look at a common one
             if (!clefSign) {
-                clefSign = it->select_single_node("clef/sign");
+                clefSign = it->first_element_by_path("clef/sign");
             }
             if (clefSign && HasContent(clefSign.node())) {
                 staffDef->SetClefShape(
@@ -627,20 +693,18 @@ int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(pugi::xml_node node, Sta
             }
             // clef line
             pugi::xpath_node clefLine;
-            xpath = StringFormat("clef[@number='%d']/line", i + 1);
-            clefLine = it->select_single_node(xpath.c_str());
+            clefLine = GetChildWithNumber(*it, "clef", i + 1, "line");
             if (!clefLine) {
-                clefLine = it->select_single_node("clef/line");
+                clefLine = it->first_element_by_path("clef/line");
             }
             if (clefLine && HasContent(clefLine.node())) {
                 staffDef->SetClefLine(staffDef->AttCleffingLog::StrToInt(clefLine.node().text().as_string()));
             }
             // clef octave change
             pugi::xpath_node clefOctaveChange;
-            xpath = StringFormat("clef[@number='%d']/clef-octave-change", i + 1);
-            clefOctaveChange = it->select_single_node(xpath.c_str());
+            clefOctaveChange = GetChildWithNumber(*it, "clef", i + 1, "clef-octave-change");
             if (!clefOctaveChange) {
-                clefOctaveChange = it->select_single_node("clef/clef-octave-change");
+                clefOctaveChange = it->first_element_by_path("clef/clef-octave-change");
             }
             if (clefOctaveChange && HasContent(clefOctaveChange.node())) {
                 int change = clefOctaveChange.node().text().as_int();
@@ -655,14 +719,13 @@ int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(pugi::xml_node node, Sta
             }
             // key sig
             pugi::xpath_node key;
-            xpath = StringFormat("key[@number='%d']", i + 1);
-            key = it->select_single_node(xpath.c_str());
+            key = GetChildWithNumber(*it, "key", i + 1);
             if (!key) {
-                key = it->select_single_node("key");
+                key = it->child("key");
             }
             if (key) {
-                if (key.node().select_single_node("fifths")) {
-                    int fifths = atoi(key.node().select_single_node("fifths").node().text().as_string());
+                if (key.node().child("fifths")) {
+                    int fifths = atoi(key.node().child("fifths").text().as_string());
                     std::string keySig;
                     if (fifths < 0)
                         keySig = StringFormat("%df", abs(fifths));
@@ -672,41 +735,39 @@ int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(pugi::xml_node node, Sta
                         keySig = "0";
                     staffDef->SetKeySig(staffDef->AttKeySigDefaultLog::StrToKeysignature(keySig));
                 }
-                else if (key.node().select_single_node("key-step")) {
+                else if (key.node().child("key-step")) {
                     staffDef->SetKeySig(KEYSIGNATURE_mixed);
                 }
-                if (key.node().select_single_node("mode")) {
+                if (key.node().child("mode")) {
                     staffDef->SetKeyMode(staffDef->AttKeySigDefaultLog::StrToMode(
-                        key.node().select_single_node("mode").node().text().as_string()));
+                        key.node().child("mode").text().as_string()));
                 }
             }
             // staff details
             pugi::xpath_node staffDetails;
-            xpath = StringFormat("staff-details[@number='%d']", i + 1);
-            staffDetails = it->select_single_node(xpath.c_str());
+            staffDetails = GetChildWithNumber(*it, "staff-details", i + 1);
             if (!staffDetails) {
-                staffDetails = it->select_single_node("staff-details");
+                staffDetails = it->child("staff-details");
             }
-            std::string linesStr = staffDetails.node().select_single_node("staff-lines").node().text().as_string();
+            std::string linesStr = staffDetails.node().child("staff-lines").text().as_string();
             if (!linesStr.empty()) {
                 staffDef->SetLines(atoi(linesStr.c_str()));
             }
             else
                 staffDef->SetLines(5);
-            std::string scaleStr = staffDetails.node().select_single_node("staff-size").node().text().as_string();
+            std::string scaleStr = staffDetails.node().child("staff-size").text().as_string();
             if (!scaleStr.empty()) {
                 staffDef->SetScale(staffDef->AttScalable::StrToPercent(scaleStr));
             }
-            pugi::xpath_node staffTuning = staffDetails.node().select_single_node("staff-tuning");
+            pugi::xpath_node staffTuning = staffDetails.node().child("staff-tuning");
             if (staffTuning) {
                 staffDef->SetNotationtype(NOTATIONTYPE_tab);
             }
             // time
             pugi::xpath_node time;
-            xpath = StringFormat("time[@number='%d']", i + 1);
-            time = it->select_single_node(xpath.c_str());
+            time = GetChildWithNumber(*it, "time", i + 1);
             if (!time) {
-                time = it->select_single_node("time");
+                time = it->child("time");
             }
             if (time) {
                 std::string symbol = GetAttributeValue(time.node(), "symbol");
@@ -718,10 +779,10 @@ int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(pugi::xml_node node, Sta
                     else
                         staffDef->SetMeterRend(meterSigDefaultVis_METERREND_norm);
                 }
-                if (time.node().select_nodes("beats").size() > 1) {
+                if (time.node().child("beats").next_sibling("beats")) {
                     LogWarning("Compound meter signatures are not supported");
                 }
-                pugi::xpath_node beats = time.node().select_single_node("beats");
+                pugi::xpath_node beats = time.node().child("beats");
                 if (beats && HasContent(beats.node())) {
                     m_meterCount = beats.node().text().as_int();
                     // staffDef->AttMeterSigDefaultLog::StrToInt(beats.node().text().as_string());
@@ -733,7 +794,7 @@ int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(pugi::xml_node node, Sta
                     }
                     staffDef->SetMeterCount(m_meterCount);
                 }
-                pugi::xpath_node beatType = time.node().select_single_node("beat-type");
+                pugi::xpath_node beatType = time.node().child("beat-type");
                 if (beatType && HasContent(beatType.node())) {
                     staffDef->SetMeterUnit(
                         staffDef->AttMeterSigDefaultLog::StrToInt(beatType.node().text().as_string()));
@@ -741,17 +802,16 @@ int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(pugi::xml_node node, Sta
             }
             // transpose
             pugi::xpath_node transpose;
-            xpath = StringFormat("transpose[@number='%d']", i + 1);
-            transpose = it->select_single_node(xpath.c_str());
+            transpose = GetChildWithNumber(*it, "transpose", i + 1);
             if (!transpose) {
-                transpose = it->select_single_node("transpose");
+                transpose = it->child("transpose");
             }
             if (transpose) {
                 staffDef->SetTransDiat(atoi(GetContentOfChild(transpose.node(), "diatonic").c_str()));
                 staffDef->SetTransSemi(atoi(GetContentOfChild(transpose.node(), "chromatic").c_str()));
             }
             // ppq
-            pugi::xpath_node divisions = it->select_single_node("divisions");
+            pugi::xpath_node divisions = it->child("divisions");
             if (divisions) m_ppq = atoi(GetContent(divisions.node()).c_str());
         }
     }
@@ -764,17 +824,15 @@ bool MusicXmlInput::ReadMusicXmlPart(pugi::xml_node node, Section *section, int
     assert(node);
     assert(section);
 
-    pugi::xpath_node_set measures = node.select_nodes("measure");
-    if (measures.size() == 0) {
+    if (!node.child("measure")) {
         LogWarning("No measure to load");
         return false;
     }
 
     int i = 0;
-    for (pugi::xpath_node_set::const_iterator it = measures.begin(); it != measures.end(); ++it) {
-        pugi::xpath_node xmlMeasure = *it;
+    for (pugi::xml_node xmlMeasure = node.child("measure"); xmlMeasure; xmlMeasure = xmlMeasure.next_sibling("measure")) {
         Measure *measure = new Measure();
-        ReadMusicXmlMeasure(xmlMeasure.node(), measure, nbStaves, staffOffset);
+        ReadMusicXmlMeasure(xmlMeasure, measure, nbStaves, staffOffset);
         // Add the measure to the system - if already there from a previous part we'll just merge the content
         AddMeasure(section, measure, i);
         i++;
@@ -841,20 +899,20 @@ bool MusicXmlInput::ReadMusicXmlMeasure(pugi::xml_node node, Measure *measure, i
 void MusicXmlInput::ReadMusicXmlAttributes(pugi::xml_node node, Measure *measure, int measureNum)
 {
     // read clef changes as MEI clef
-    pugi::xpath_node clef = node.select_single_node("clef");
+    pugi::xpath_node clef = node.child("clef");
     if (clef) {
         // check if we have a staff number
         std::string numberStr = GetAttributeValue(clef.node(), "number");
         int staffNum = (numberStr.empty()) ? 1 : atoi(numberStr.c_str());
         Layer *layer = SelectLayer(staffNum, measure);
-        pugi::xpath_node clefSign = clef.node().select_single_node("sign");
-        pugi::xpath_node clefLine = clef.node().select_single_node("line");
+        pugi::xpath_node clefSign = clef.node().child("sign");
+        pugi::xpath_node clefLine = clef.node().child("line");
         if (clefSign && clefLine) {
             Clef *meiClef = new Clef();
             meiClef->SetShape(meiClef->AttClefshape::StrToClefshape(GetContent(clefSign.node())));
             meiClef->SetLine(meiClef->AttClefshape::StrToInt(clefLine.node().text().as_string()));
             // clef octave change
-            pugi::xpath_node clefOctaveChange = clef.node().select_single_node("clef-octave-change");
+            pugi::xpath_node clefOctaveChange = clef.node().child("clef-octave-change");
             if (clefOctaveChange && HasContent(clefOctaveChange.node())) {
                 int change = clefOctaveChange.node().text().as_int();
                 if (abs(change) == 1)
@@ -870,7 +928,7 @@ void MusicXmlInput::ReadMusicXmlAttributes(pugi::xml_node node, Measure *measure
         }
     }
 
-    pugi::xpath_node measureRepeat = node.select_single_node("measure-style/measure-repeat");
+    pugi::xpath_node measureRepeat = node.first_element_by_path("measure-style/measure-repeat");
     if (measureRepeat) {
         if (GetAttributeValue(measureRepeat.node(), "type") == "start")
             m_mRpt = true;
@@ -890,7 +948,7 @@ void MusicXmlInput::ReadMusicXmlBackup(pugi::xml_node node, Measure *measure, in
     if (nextNote && m_durTotal > 0) {
         // We need a <space> if a note follows that starts not at the beginning of the measure
         Layer *layer = new Layer();
-        if (!node.select_single_node("voice")) layer = SelectLayer(nextNote.node(), measure);
+        if (!node.child("voice")) layer = SelectLayer(nextNote.node(), measure);
         FillSpace(layer, m_durTotal);
     }
 }
@@ -905,7 +963,7 @@ void MusicXmlInput::ReadMusicXmlBarLine(pugi::xml_node node, Measure *measure, i
 
     data_BARRENDITION barRendition = BARRENDITION_NONE;
     std::string barStyle = GetContentOfChild(node, "bar-style");
-    pugi::xpath_node repeat = node.select_single_node("repeat");
+    pugi::xpath_node repeat = node.child("repeat");
     if (!barStyle.empty()) {
         barRendition = ConvertStyleToRend(barStyle, repeat);
         if (HasAttributeWithValue(node, "location", "left")) {
@@ -918,12 +976,12 @@ void MusicXmlInput::ReadMusicXmlBarLine(pugi::xml_node node, Measure *measure, i
             measure->SetRight(barRendition);
         }
     }
-    pugi::xpath_node ending = node.select_single_node("ending");
+    pugi::xpath_node ending = node.child("ending");
     if (ending) {
         LogWarning("Endings not supported");
     }
     // fermatas
-    pugi::xpath_node xmlFermata = node.select_single_node("fermata");
+    pugi::xpath_node xmlFermata = node.child("fermata");
     if (xmlFermata) {
         Fermata *fermata = new Fermata();
         m_controlElements.push_back(std::make_pair(measureNum, fermata));
@@ -959,15 +1017,17 @@ void MusicXmlInput::ReadMusicXmlDirection(pugi::xml_node node, Measure *measure,
     assert(node);
     assert(measure);
 
-    pugi::xpath_node type = node.select_single_node("direction-type");
+    pugi::xpath_node type = node.child("direction-type");
     std::string placeStr = GetAttributeValue(node, "placement");
-    pugi::xpath_node_set words = type.node().select_nodes("words");
+    std::vector<pugi::xml_node> words;
+    for (pugi::xml_node word : type.node().children("words")) words.push_back(word);
+    pugi::xml_node soundTempo = GetChildWithAttribute(node, "sound", "tempo");
 
     // Directive
-    if (words.size() != 0 && !node.select_single_node("sound[@tempo]")) {
+    if (words.size() != 0 && !soundTempo) {
         Dir *dir = new Dir();
         if (words.size() == 1) {
-            std::string lang = GetAttributeValue(words.first().node(), "xml:lang");
+            std::string lang = GetAttributeValue(words.front(), "xml:lang");
             if (!lang.empty()) dir->SetLang(lang.c_str());
         }
         if (!placeStr.empty()) dir->SetPlace(dir->AttPlacement::StrToStaffrel(placeStr.c_str()));
@@ -977,7 +1037,7 @@ void MusicXmlInput::ReadMusicXmlDirection(pugi::xml_node node, Measure *measure,
     }
 
     // Dynamics
-    pugi::xpath_node dynam = type.node().select_single_node("dynamics");
+    pugi::xpath_node dynam = type.node().child("dynamics");
     if (dynam) {
         std::string dynamStr = GetContentOfChild(dynam.node(), "other-dynamics");
         if (dynamStr.empty()) dynamStr = dynam.node().first_child().name();
@@ -991,7 +1051,7 @@ void MusicXmlInput::ReadMusicXmlDirection(pugi::xml_node node, Measure *measure,
     }
 
     // Hairpins
-    pugi::xpath_node wedge = type.node().select_single_node("wedge");
+    pugi::xpath_node wedge = type.node().child("wedge");
     if (wedge) {
         int hairpinNumber = atoi(GetAttributeValue(wedge.node(), "number").c_str());
         hairpinNumber = (hairpinNumber < 1) ? 1 : hairpinNumber;
@@ -1023,9 +1083,9 @@ void MusicXmlInput::ReadMusicXmlDirection(pugi::xml_node node, Measure *measure,
     }
 
     // Ottava
-    pugi::xpath_node xmlShift = type.node().select_single_node("octave-shift");
+    pugi::xpath_node xmlShift = type.node().child("octave-shift");
     if (xmlShift) {
-        pugi::xpath_node staffNode = node.select_single_node("staff");
+        pugi::xpath_node staffNode = node.child("staff");
         int staffN = (!staffNode) ? 1 : atoi(GetContent(staffNode.node()).c_str());
         if (HasAttributeWithValue(xmlShift.node(), "type", "stop")) {
             m_octDis[staffN] = 0;
@@ -1062,7 +1122,7 @@ void MusicXmlInput::ReadMusicXmlDirection(pugi::xml_node node, Measure *measure,
     }
 
     // Pedal
-    pugi::xpath_node xmlPedal = type.node().select_single_node("pedal");
+    pugi::xpath_node xmlPedal = type.node().child("pedal");
     if (xmlPedal) {
         Pedal *pedal = new Pedal();
         if (!placeStr.empty()) pedal->SetPlace(pedal->AttPlacement::StrToStaffrel(placeStr.c_str()));
@@ -1074,11 +1134,11 @@ void MusicXmlInput::ReadMusicXmlDirection(pugi::xml_node node, Measure *measure,
     }
 
     // Tempo
-    pugi::xpath_node metronome = type.node().select_single_node("metronome");
-    if (node.select_single_node("sound[@tempo]") || metronome) {
+    pugi::xpath_node metronome = type.node().child("metronome");
+    if (soundTempo || metronome) {
         Tempo *tempo = new Tempo();
         if (words.size() == 1) {
-            std::string lang = GetAttributeValue(words.first().node(), "xml:lang");
+            std::string lang = GetAttributeValue(words.front(), "xml:lang");
             if (!lang.empty()) tempo->SetLang(lang.c_str());
         }
         if (!placeStr.empty()) tempo->SetPlace(tempo->AttPlacement::StrToStaffrel(placeStr.c_str()));
@@ -1086,7 +1146,7 @@ void MusicXmlInput::ReadMusicXmlDirection(pugi::xml_node node, Measure *measure,
         if (metronome)
             PrintMetronome(metronome.node(), tempo);
         else
-            tempo->SetMidiBpm(atoi(GetAttributeValue(node.select_single_node("sound").node(), "tempo").c_str()));
+            tempo->SetMidiBpm(atoi(GetAttributeValue(node.child("sound"), "tempo").c_str()));
         m_controlElements.push_back(std::make_pair(measureNum, tempo));
         m_tempoStack.push_back(tempo);
     }
@@ -1106,14 +1166,14 @@ void MusicXmlInput::ReadMusicXmlForward(pugi::xml_node node, Measure *measure, i
 
     Layer *layer = SelectLayer(node, measure);
 
-    pugi::xpath_node prevNote = node.select_single_node("preceding-sibling::note[1]");
-    pugi::xpath_node nextNote = node.select_single_node("following-sibling::note[1]");
+    pugi::xpath_node prevNote = node.previous_sibling("note");
+    pugi::xpath_node nextNote = node.next_sibling("note");
     if (nextNote) {
         // We need a <space> if a note follows
-        if (!node.select_single_node("voice")) layer = SelectLayer(nextNote.node(), measure);
+        if (!node.child("voice")) layer = SelectLayer(nextNote.node(), measure);
         FillSpace(layer, atoi(GetContentOfChild(node, "duration").c_str()));
     }
-    else if (!prevNote && !node.select_single_node("preceding-sibling::backup")) {
+    else if (!prevNote && !node.previous_sibling("backup")) {
         // If there is no previous or following note in the first layer, the measure seems to be empty
         // an invisible mRest is used, which should be replaced by mSpace, when available
         MRest *mRest = new MRest();
@@ -1131,7 +1191,7 @@ void MusicXmlInput::ReadMusicXmlHarmony(pugi::xml_node node, Measure *measure, i
     std::string typeStr = GetAttributeValue(node, "type");
 
     std::string harmText = GetContentOfChild(node, "root/root-step");
-    pugi::xpath_node alter = node.select_single_node("root/root-alter");
+    pugi::xpath_node alter = node.first_element_by_path("root/root-alter");
     if (alter) {
         if (GetContent(alter.node()) == "-1")
             harmText = harmText + "♭";
@@ -1140,7 +1200,7 @@ void MusicXmlInput::ReadMusicXmlHarmony(pugi::xml_node node, Measure *measure, i
         else if (GetContent(alter.node()) == "1")
             harmText = harmText + "♯";
     }
-    pugi::xpath_node kind = node.select_single_node("kind");
+    pugi::xpath_node kind = node.child("kind");
     if (kind) harmText = harmText + GetAttributeValue(kind.node(), "text").c_str();
     Harm *harm = new Harm();
     Text *text = new Text();
@@ -1166,7 +1226,7 @@ void MusicXmlInput::ReadMusicXmlNote(pugi::xml_node node, Measure *measure, int
     LayerElement *element = NULL;
 
     // add duration to measure time
-    if (!node.select_single_node("chord")) m_durTotal += atoi(GetContentOfChild(node, "duration").c_str());
+    if (!node.child("chord")) m_durTotal += atoi(GetContentOfChild(node, "duration").c_str());
 
     // for measure repeats add a single <mRpt> and return
     if (m_mRpt) {
@@ -1180,17 +1240,25 @@ void MusicXmlInput::ReadMusicXmlNote(pugi::xml_node node, Measure *measure, int
 
     std::string noteColor = GetAttributeValue(node, "color");
 
-    pugi::xpath_node notations = node.select_single_node("notations[not(@print-object='no')]");
+    pugi::xpath_node notations;
+    for (pugi::xml_node xmlNotations = node.child("notations"); xmlNotations;
+         xmlNotations = xmlNotations.next_sibling("notations")) {
+        if (!HasAttributeWithValue(xmlNotations, "print-object", "no")) {
+            notations = xmlNotations;
+            break;
+        }
+    }
 
     bool cue = false;
-    if (node.select_single_node("cue") || node.select_single_node("type[@size='cue']")) cue = true;
+    if (node.child("cue") || node.find_child_by_attribute("type", "size", "cue")) cue = true;
 
     // duration string and dots
     std::string typeStr = GetContentOfChild(node, "type");
-    int dots = (int)node.select_nodes("dot").size();
+    int dots = 0;
+    for (pugi::xml_node dot = node.child("dot"); dot; dot = dot.next_sibling("dot")) dots++;
 
     // tremolos
-    pugi::xpath_node tremolo = notations.node().select_single_node("ornaments/tremolo");
+    pugi::xpath_node tremolo = notations.node().first_element_by_path("ornaments/tremolo");
     std::string tremSlashNum = "0";
     if (tremolo) {
         if (HasAttributeWithValue(tremolo.node(), "type", "single")) {
@@ -1208,7 +1276,8 @@ void MusicXmlInput::ReadMusicXmlNote(pugi::xml_node node, Measure *measure, int
     }
 
     // beam start
-    bool beamStart = node.select_single_node("beam[@number='1'][text()='begin']");
+    pugi::xml_node xmlBeam = node.find_child_by_attribute("beam", "number", "1");
+    bool beamStart = xmlBeam && HasContentWithValue(xmlBeam, "begin");
     if (beamStart) {
         Beam *beam = new Beam();
         AddLayerElement(layer, beam);
@@ -1220,13 +1289,13 @@ void MusicXmlInput::ReadMusicXmlNote(pugi::xml_node node, Measure *measure, int
     // quite likely not work if we have a tuplet over serveral beams. We would need to check which
     // one is ending first in order to determine which one is on top of the hierarchy.
     // Also, it is not 100% sure that we can represent them as tuplet and beam elements.
-    pugi::xpath_node tupletStart = notations.node().select_single_node("tuplet[@type='start']");
+    pugi::xpath_node tupletStart = notations.node().find_child_by_attribute("tuplet", "type", "start");
     if (tupletStart) {
         Tuplet *tuplet = new Tuplet();
         AddLayerElement(layer, tuplet);
         m_elementStack.push_back(tuplet);
-        pugi::xpath_node actualNotes = node.select_single_node("time-modification/actual-notes");
-        pugi::xpath_node normalNotes = node.select_single_node("time-modification/normal-notes");
+        pugi::xpath_node actualNotes = node.first_element_by_path("time-modification/actual-notes");
+        pugi::xpath_node normalNotes = node.first_element_by_path("time-modification/normal-notes");
         if (actualNotes && normalNotes) {
             tuplet->SetNum(atoi(GetContent(actualNotes.node()).c_str()));
             tuplet->SetNumbase(atoi(GetContent(normalNotes.node()).c_str()));
@@ -1241,7 +1310,7 @@ void MusicXmlInput::ReadMusicXmlNote(pugi::xml_node node, Measure *measure, int
         tuplet->SetBracketVisible(ConvertWordToBool(GetAttributeValue(tupletStart.node(), "bracket")));
     }
 
-    pugi::xpath_node rest = node.select_single_node("rest");
+    pugi::xpath_node rest = node.child("rest");
     if (rest) {
         std::string stepStr = GetContentOfChild(rest.node(), "display-step");
         std::string octaveStr = GetContentOfChild(rest.node(), "display-octave");
@@ -1278,7 +1347,7 @@ void MusicXmlInput::ReadMusicXmlNote(pugi::xml_node node, Measure *measure, int
         if (!noteColor.empty()) note->SetColor(noteColor.c_str());
 
         // accidental
-        pugi::xpath_node accidental = node.select_single_node("accidental");
+        pugi::xpath_node accidental = node.child("accidental");
         if (accidental) {
             Accid *accid = new Accid();
             accid->SetAccid(ConvertAccidentalToAccid(GetContent(accidental.node())));
@@ -1302,7 +1371,7 @@ void MusicXmlInput::ReadMusicXmlNote(pugi::xml_node node, Measure *measure, int
         }
 
         // pitch and octave
-        pugi::xpath_node pitch = node.select_single_node("pitch");
+        pugi::xpath_node pitch = node.child("pitch");
         if (pitch) {
             std::string stepStr = GetContentOfChild(pitch.node(), "step");
             if (!stepStr.empty()) note->SetPname(ConvertStepToPitchName(stepStr));
@@ -1327,15 +1396,15 @@ void MusicXmlInput::ReadMusicXmlNote(pugi::xml_node node, Measure *measure, int
         }
 
         // notehead
-        pugi::xpath_node notehead = node.select_single_node("notehead");
+        pugi::xpath_node notehead = node.child("notehead");
         if (notehead) {
             // if (HasAttributeWithValue(notehead.node(), "parentheses", "yes")) note->SetEnclose(ENCLOSURE_paren);
         }
 
         // look at the next note to see if we are starting or ending a chord
-        pugi::xpath_node nextNote = node.select_single_node("./following-sibling::note");
+        pugi::xpath_node nextNote = node.next_sibling("note");
         bool nextIsChord = false;
-        if (nextNote.node().select_single_node("chord")) nextIsChord = true;
+        if (nextNote.node().child("chord")) nextIsChord = true;
         // create the chord if we are starting a new chord
         if (nextIsChord) {
             if (m_elementStack.empty() || !m_elementStack.back()->Is(CHORD)) {
@@ -1352,7 +1421,7 @@ void MusicXmlInput::ReadMusicXmlNote(pugi::xml_node node, Measure *measure, int
         }
 
         // grace notes
-        pugi::xpath_node grace = node.select_single_node("grace");
+        pugi::xpath_node grace = node.child("grace");
         if (grace) {
             std::string slashStr = GetAttributeValue(grace.node(), "slash");
             if (slashStr == "no") {
@@ -1377,9 +1446,7 @@ void MusicXmlInput::ReadMusicXmlNote(pugi::xml_node node, Measure *measure, int
         }
 
         // verse / syl
-        pugi::xpath_node_set lyrics = node.select_nodes("lyric");
-        for (pugi::xpath_node_set::const_iterator it = lyrics.begin(); it != lyrics.end(); ++it) {
-            pugi::xml_node lyric = it->node();
+        for (pugi::xml_node lyric = node.child("lyric"); lyric; lyric = lyric.next_sibling("lyric")) {
             int lyricNumber = atoi(GetAttributeValue(lyric, "number").c_str());
             lyricNumber = (lyricNumber < 1) ? 1 : lyricNumber;
             std::string lyricName = GetAttributeValue(lyric, "name");
@@ -1397,7 +1464,7 @@ void MusicXmlInput::ReadMusicXmlNote(pugi::xml_node node, Measure *measure, int
                     std::string textStr = GetContent(textNode);
                     Syl *syl = new Syl();
                     if (!lang.empty()) syl->SetLang(lang.c_str());
-                    if (lyric.select_single_node("extend")) {
+                    if (lyric.child("extend")) {
                         syl->SetCon(sylLog_CON_u);
                     }
                     if (textNode.next_sibling("elision")) {
@@ -1428,8 +1495,8 @@ void MusicXmlInput::ReadMusicXmlNote(pugi::xml_node node, Measure *measure, int
         }
 
         // ties
-        pugi::xpath_node startTie = notations.node().select_single_node("tied[@type='start']");
-        pugi::xpath_node endTie = notations.node().select_single_node("tied[@type='stop']");
+        pugi::xpath_node startTie = notations.node().find_child_by_attribute("tied", "type", "start");
+        pugi::xpath_node endTie = notations.node().find_child_by_attribute("tied", "type", "stop");
         CloseTie(staff, layer, note, endTie);
         // Then open a new tie
         if ((startTie)) {
@@ -1452,13 +1519,13 @@ void MusicXmlInput::ReadMusicXmlNote(pugi::xml_node node, Measure *measure, int
         for (pugi::xml_node articulations = notations.node().child("articulations"); articulations;
              articulations = articulations.next_sibling("articulations")) {
             Artic *artic = new Artic();
-            if (articulations.select_single_node("accent")) artics.push_back(ARTICULATION_acc);
-            if (articulations.select_single_node("detached-legato")) artics.push_back(ARTICULATION_ten_stacc);
-            if (articulations.select_single_node("spiccato")) artics.push_back(ARTICULATION_spicc);
-            if (articulations.select_single_node("staccatissimo")) artics.push_back(ARTICULATION_stacciss);
-            if (articulations.select_single_node("staccato")) artics.push_back(ARTICULATION_stacc);
-            if (articulations.select_single_node("strong-accent")) artics.push_back(ARTICULATION_marc);
-            if (articulations.select_single_node("tenuto")) artics.push_back(ARTICULATION_ten);
+            if (articulations.child("accent")) artics.push_back(ARTICULATION_acc);
+            if (articulations.child("detached-legato")) artics.push_back(ARTICULATION_ten_stacc);
+            if (articulations.child("spiccato")) artics.push_back(ARTICULATION_spicc);
+            if (articulations.child("staccatissimo")) artics.push_back(ARTICULATION_stacciss);
+            if (articulations.child("staccato")) artics.push_back(ARTICULATION_stacc);
+            if (articulations.child("strong-accent")) artics.push_back(ARTICULATION_marc);
+            if (articulations.child("tenuto")) artics.push_back(ARTICULATION_ten);
             artic->SetArtic(artics);
             element->AddChild(artic);
             artics.clear();
@@ -1466,12 +1533,12 @@ void MusicXmlInput::ReadMusicXmlNote(pugi::xml_node node, Measure *measure, int
         for (pugi::xml_node technical = notations.node().child("technical"); technical;
              technical = technical.next_sibling("technical")) {
             Artic *artic = new Artic();
-            if (technical.select_single_node("down-bow")) artics.push_back(ARTICULATION_dnbow);
-            if (technical.select_single_node("harmonic")) artics.push_back(ARTICULATION_harm);
-            if (technical.select_single_node("open-string")) artics.push_back(ARTICULATION_open);
-            if (technical.select_single_node("snap-pizzicato")) artics.push_back(ARTICULATION_snap);
-            if (technical.select_single_node("stopped")) artics.push_back(ARTICULATION_stop);
-            if (technical.select_single_node("up-bow")) artics.push_back(ARTICULATION_upbow);
+            if (technical.child("down-bow")) artics.push_back(ARTICULATION_dnbow);
+            if (technical.child("harmonic")) artics.push_back(ARTICULATION_harm);
+            if (technical.child("open-string")) artics.push_back(ARTICULATION_open);
+            if (technical.child("snap-pizzicato")) artics.push_back(ARTICULATION_snap);
+            if (technical.child("stopped")) artics.push_back(ARTICULATION_stop);
+            if (technical.child("up-bow")) artics.push_back(ARTICULATION_upbow);
             artic->SetArtic(artics);
             artic->SetType("technical");
             element->AddChild(artic);
@@ -1491,7 +1558,7 @@ void MusicXmlInput::ReadMusicXmlNote(pugi::xml_node node, Measure *measure, int
     m_ID = "#" + element->GetUuid();
 
     // Dynamics
-    pugi::xpath_node xmlDynam = notations.node().select_single_node("dynamics");
+    pugi::xpath_node xmlDynam = notations.node().child("dynamics");
     if (xmlDynam) {
         Dynam *dynam = new Dynam();
         m_controlElements.push_back(std::make_pair(measureNum, dynam));
@@ -1508,7 +1575,7 @@ void MusicXmlInput::ReadMusicXmlNote(pugi::xml_node node, Measure *measure, int
     }
 
     // fermatas
-    pugi::xpath_node xmlFermata = notations.node().select_single_node("fermata");
+    pugi::xpath_node xmlFermata = notations.node().child("fermata");
     if (xmlFermata) {
         Fermata *fermata = new Fermata();
         m_controlElements.push_back(std::make_pair(measureNum, fermata));
@@ -1531,7 +1598,7 @@ void MusicXmlInput::ReadMusicXmlNote(pugi::xml_node node, Measure *measure, int
     }
 
     // mordent
-    pugi::xpath_node xmlMordent = notations.node().select_single_node("ornaments/mordent");
+    pugi::xpath_node xmlMordent = notations.node().first_element_by_path("ornaments/mordent");
     if (xmlMordent) {
         Mordent *mordent = new Mordent();
         m_controlElements.push_back(std::make_pair(measureNum, mordent));
@@ -1549,7 +1616,7 @@ void MusicXmlInput::ReadMusicXmlNote(pugi::xml_node node, Measure *measure, int
         std::string placeStr = GetAttributeValue(xmlMordent.node(), "placement");
         if (!placeStr.empty()) mordent->SetPlace(mordent->AttPlacement::StrToStaffrel(placeStr.c_str()));
     }
-    pugi::xpath_node xmlMordentInv = notations.node().select_single_node("ornaments/inverted-mordent");
+    pugi::xpath_node xmlMordentInv = notations.node().first_element_by_path("ornaments/inverted-mordent");
     if (xmlMordentInv) {
         Mordent *mordent = new Mordent();
         m_controlElements.push_back(std::make_pair(measureNum, mordent));
@@ -1569,7 +1636,7 @@ void MusicXmlInput::ReadMusicXmlNote(pugi::xml_node node, Measure *measure, int
     }
 
     // trill
-    pugi::xpath_node xmlTrill = notations.node().select_single_node("ornaments/trill-mark");
+    pugi::xpath_node xmlTrill = notations.node().first_element_by_path("ornaments/trill-mark");
     if (xmlTrill) {
         Trill *trill = new Trill();
         m_controlElements.push_back(std::make_pair(measureNum, trill));
@@ -1584,7 +1651,7 @@ void MusicXmlInput::ReadMusicXmlNote(pugi::xml_node node, Measure *measure, int
     }
 
     // turn
-    pugi::xpath_node xmlTurn = notations.node().select_single_node("ornaments/turn");
+    pugi::xpath_node xmlTurn = notations.node().first_element_by_path("ornaments/turn");
     if (xmlTurn) {
         Turn *turn = new Turn();
         m_controlElements.push_back(std::make_pair(measureNum, turn));
@@ -1599,7 +1666,7 @@ void MusicXmlInput::ReadMusicXmlNote(pugi::xml_node node, Measure *measure, int
         std::string placeStr = GetAttributeValue(xmlTurn.node(), "placement");
         if (!placeStr.empty()) turn->SetPlace(turn->AttPlacement::StrToStaffrel(placeStr.c_str()));
     }
-    pugi::xpath_node xmlTurnInv = notations.node().select_single_node("ornaments/inverted-turn");
+    pugi::xpath_node xmlTurnInv = notations.node().first_element_by_path("ornaments/inverted-turn");
     if (xmlTurnInv) {
         Turn *turn = new Turn();
         m_controlElements.push_back(std::make_pair(measureNum, turn));
@@ -1617,9 +1684,7 @@ void MusicXmlInput::ReadMusicXmlNote(pugi::xml_node node, Measure *measure, int
 
     // slur
     // cross staff slurs won't work
-    pugi::xpath_node_set slurs = notations.node().select_nodes("slur");
-    for (pugi::xpath_node_set::const_iterator it = slurs.begin(); it != slurs.end(); ++it) {
-        pugi::xml_node slur = it->node();
+    for (pugi::xml_node slur = notations.node().child("slur"); slur; slur = slur.next_sibling("slur")) {
         int slurNumber = atoi(GetAttributeValue(slur, "number").c_str());
         slurNumber = (slurNumber < 1) ? 1 : slurNumber;
         if (HasAttributeWithValue(slur, "type", "start")) {
@@ -1654,13 +1719,13 @@ void MusicXmlInput::ReadMusicXmlNote(pugi::xml_node node, Measure *measure, int
     }
 
     // tuplet end
-    pugi::xpath_node tupletEnd = notations.node().select_single_node("tuplet[@type='stop']");
+    pugi::xpath_node tupletEnd = notations.node().find_child_by_attribute("tuplet", "type", "stop");
     if (tupletEnd) {
         RemoveLastFromStack(TUPLET);
     }
 
     // beam end
-    bool beamEnd = node.select_single_node("beam[@number='1'][text()='end']");
+    bool beamEnd = xmlBeam && HasContentWithValue(xmlBeam, "end");
     if (beamEnd) {
         RemoveLastFromStack(BEAM);
     }
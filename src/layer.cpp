@@ -294,7 +294,7 @@ int Layer::UnsetCurrentScoreDef(FunctorParams *functorParams)
 
 int Layer::AlignHorizontally(FunctorParams *functorParams)
 {
-    AlignHorizontallyParams *params = dynamic_cast<AlignHorizontallyParams *>(functorParams);
+    AlignHorizontallyParams *params = static_cast<AlignHorizontallyParams *>(functorParams);
     assert(params);
 
     params->m_currentMensur = GetCurrentMensur();
@@ -332,7 +332,7 @@ int Layer::AlignHorizontally(FunctorParams *functorParams)
 
 int Layer::AlignHorizontallyEnd(FunctorParams *functorParams)
 {
-    AlignHorizontallyParams *params = dynamic_cast<AlignHorizontallyParams *>(functorParams);
+    AlignHorizontallyParams *params = static_cast<AlignHorizontallyParams *>(functorParams);
     assert(params);
 
     params->m_scoreDefRole = CAUTIONARY_SCOREDEF;
@@ -367,7 +367,7 @@ int Layer::AlignHorizontallyEnd(FunctorParams *functorParams)
 
 int Layer::PrepareProcessingLists(FunctorParams *functorParams)
 {
-    PrepareProcessingListsParams *params = dynamic_cast<PrepareProcessingListsParams *>(functorParams);
+    PrepareProcessingListsParams *params = static_cast<PrepareProcessingListsParams *>(functorParams);
     assert(params);
 
     // Alternate solution with StaffN_LayerN_VerseN_t
@@ -382,7 +382,7 @@ int Layer::PrepareProcessingLists(FunctorParams *functorParams)
 
 int Layer::PrepareRpt(FunctorParams *functorParams)
 {
-    PrepareRptParams *params = dynamic_cast<PrepareRptParams *>(functorParams);
+    PrepareRptParams *params = static_cast<PrepareRptParams *>(functorParams);
     assert(params);
 
     // If we have encountered a mRpt before and there is none is this layer, reset it to NULL
@@ -394,7 +394,7 @@ int Layer::PrepareRpt(FunctorParams *functorParams)
 
 int Layer::AdjustSylSpacing(FunctorParams *functorParams)
 {
-    AdjustSylSpacingParams *params = dynamic_cast<AdjustSylSpacingParams *>(functorParams);
+    AdjustSylSpacingParams *params = static_cast<AdjustSylSpacingParams *>(functorParams);
     assert(params);
 
     // reset it
@@ -406,7 +406,7 @@ int Layer::AdjustSylSpacing(FunctorParams *functorParams)
 
 int Layer::CalcMaxMeasureDuration(FunctorParams *functorParams)
 {
-    CalcMaxMeasureDurationParams *params = dynamic_cast<CalcMaxMeasureDurationParams *>(functorParams);
+    CalcMaxMeasureDurationParams *params = static_cast<CalcMaxMeasureDurationParams *>(functorParams);
     assert(params);
 
     // reset it
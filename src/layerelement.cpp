@@ -86,6 +86,7 @@ void LayerElement::Reset()
     m_alignment = NULL;
     m_graceAlignment = NULL;
     m_alignmentLayerN = VRV_UNSET;
+    m_cachedDrawingXGeneration = 0;
     m_beamElementCoord = NULL;
 
     m_crossStaff = NULL;
@@ -216,17 +217,21 @@ int LayerElement::GetDrawingX() const
     // Since m_xAbs is the left position, we adjust the XRel accordingly in AdjustXRelForTranscription
     if (m_xAbs != VRV_UNSET) return m_xAbs + this->GetDrawingXRel();
 
-    if (m_cachedDrawingX != VRV_UNSET) return m_cachedDrawingX;
-
     if (!m_alignment) {
         // assert(this->Is({ BEAM, FTREM, TUPLET }));
         // Here we just get the measure position - no cast to Measure is necessary
+        // This is not cached because there is no aligner generation to check it against
         Object *measure = this->GetFirstParent(MEASURE);
         assert(measure);
-        m_cachedDrawingX = measure->GetDrawingX();
-        return m_cachedDrawingX;
+        return measure->GetDrawingX();
     }
 
+    // The cached value is valid as long as the alignment(s) and the measure have not been moved
+    unsigned long long generation = m_alignment->GetDrawingXGeneration();
+    if (m_graceAlignment) generation = std::max(generation, m_graceAlignment->GetDrawingXGeneration());
+    if ((m_cachedDrawingX != VRV_UNSET) && (m_cachedDrawingXGeneration == generation)) return m_cachedDrawingX;
+    m_cachedDrawingXGeneration = generation;
+
     // First get the first layerElement parent (if any) and use its position if they share the same alignment
     LayerElement *parent = dynamic_cast<LayerElement *>(this->GetFirstParentInRange(LAYER_ELEMENT, LAYER_ELEMENT_max));
     if (parent && (parent->GetAlignment() == this->GetAlignment())) {
@@ -487,7 +492,7 @@ int LayerElement::ResetVerticalAlignment(FunctorParams *functorParams)
 
 int LayerElement::ApplyPPUFactor(FunctorParams *functorParams)
 {
-    ApplyPPUFactorParams *params = dynamic_cast<ApplyPPUFactorParams *>(functorParams);
+    ApplyPPUFactorParams *params = static_cast<ApplyPPUFactorParams *>(functorParams);
     assert(params);
 
     if (m_xAbs != VRV_UNSET) m_xAbs /= params->m_page->GetPPUFactor();
@@ -497,7 +502,7 @@ int LayerElement::ApplyPPUFactor(FunctorParams *functorParams)
 
 int LayerElement::AlignHorizontally(FunctorParams *functorParams)
 {
-    AlignHorizontallyParams *params = dynamic_cast<AlignHorizontallyParams *>(functorParams);
+    AlignHorizontallyParams *params = static_cast<AlignHorizontallyParams *>(functorParams);
     assert(params);
 
     assert(!m_alignment);
@@ -651,7 +656,7 @@ int LayerElement::AlignHorizontally(FunctorParams *functorParams)
 
 int LayerElement::SetAlignmentPitchPos(FunctorParams *functorParams)
 {
-    SetAlignmentPitchPosParams *params = dynamic_cast<SetAlignmentPitchPosParams *>(functorParams);
+    SetAlignmentPitchPosParams *params = static_cast<SetAlignmentPitchPosParams *>(functorParams);
     assert(params);
 
     LayerElement *layerElementY = this;
@@ -746,7 +751,7 @@ int LayerElement::SetAlignmentPitchPos(FunctorParams *functorParams)
 
 int LayerElement::AdjustLayers(FunctorParams *functorParams)
 {
-    AdjustLayersParams *params = dynamic_cast<AdjustLayersParams *>(functorParams);
+    AdjustLayersParams *params = static_cast<AdjustLayersParams *>(functorParams);
     assert(params);
 
     // Check if we are starting a new layer content - if yes copy the current elements to previous
@@ -830,7 +835,7 @@ int LayerElement::AdjustLayers(FunctorParams *functorParams)
 
 int LayerElement::AdjustGraceXPos(FunctorParams *functorParams)
 {
-    AdjustGraceXPosParams *params = dynamic_cast<AdjustGraceXPosParams *>(functorParams);
+    AdjustGraceXPosParams *params = static_cast<AdjustGraceXPosParams *>(functorParams);
     assert(params);
 
     if (params->m_graceCumulatedXShift == VRV_UNSET) params->m_graceCumulatedXShift = 0;
@@ -867,7 +872,7 @@ int LayerElement::AdjustGraceXPos(FunctorParams *functorParams)
 
 int LayerElement::AdjustXPos(FunctorParams *functorParams)
 {
-    AdjustXPosParams *params = dynamic_cast<AdjustXPosParams *>(functorParams);
+    AdjustXPosParams *params = static_cast<AdjustXPosParams *>(functorParams);
     assert(params);
 
     // we should have processed aligned before
@@ -981,7 +986,7 @@ int LayerElement::PrepareDrawingCueSize(FunctorParams *functorParams)
 
 int LayerElement::PrepareCrossStaff(FunctorParams *functorParams)
 {
-    PrepareCrossStaffParams *params = dynamic_cast<PrepareCrossStaffParams *>(functorParams);
+    PrepareCrossStaffParams *params = static_cast<PrepareCrossStaffParams *>(functorParams);
     assert(params);
 
     m_crossStaff = NULL;
@@ -1048,7 +1053,7 @@ int LayerElement::PrepareCrossStaff(FunctorParams *functorParams)
 
 int LayerElement::PrepareCrossStaffEnd(FunctorParams *functorParams)
 {
-    PrepareCrossStaffParams *params = dynamic_cast<PrepareCrossStaffParams *>(functorParams);
+    PrepareCrossStaffParams *params = static_cast<PrepareCrossStaffParams *>(functorParams);
     assert(params);
 
     DurationInterface *durElement = this->GetDurationInterface();
@@ -1067,7 +1072,7 @@ int LayerElement::PrepareCrossStaffEnd(FunctorParams *functorParams)
 
 int LayerElement::PrepareTimePointing(FunctorParams *functorParams)
 {
-    PrepareTimePointingParams *params = dynamic_cast<PrepareTimePointingParams *>(functorParams);
+    PrepareTimePointingParams *params = static_cast<PrepareTimePointingParams *>(functorParams);
     assert(params);
 
     // Do not look for tstamp pointing to these
@@ -1089,7 +1094,7 @@ int LayerElement::PrepareTimePointing(FunctorParams *functorParams)
 
 int LayerElement::PrepareTimeSpanning(FunctorParams *functorParams)
 {
-    PrepareTimeSpanningParams *params = dynamic_cast<PrepareTimeSpanningParams *>(functorParams);
+    PrepareTimeSpanningParams *params = static_cast<PrepareTimeSpanningParams *>(functorParams);
     assert(params);
 
     // Do not look for tstamp pointing to these
@@ -1111,7 +1116,7 @@ int LayerElement::PrepareTimeSpanning(FunctorParams *functorParams)
 
 int LayerElement::FindTimeSpanningLayerElements(FunctorParams *functorParams)
 {
-    FindTimeSpanningLayerElementsParams *params = dynamic_cast<FindTimeSpanningLayerElementsParams *>(functorParams);
+    FindTimeSpanningLayerElementsParams *params = static_cast<FindTimeSpanningLayerElementsParams *>(functorParams);
     assert(params);
 
     if ((this->GetDrawingX() > params->m_minPos) && (this->GetDrawingX() < params->m_maxPos)) {
@@ -1126,7 +1131,7 @@ int LayerElement::FindTimeSpanningLayerElements(FunctorParams *functorParams)
 
 int LayerElement::GenerateMIDI(FunctorParams *functorParams)
 {
-    GenerateMIDIParams *params = dynamic_cast<GenerateMIDIParams *>(functorParams);
+    GenerateMIDIParams *params = static_cast<GenerateMIDIParams *>(functorParams);
     assert(params);
 
     // Here we need to check if the LayerElement as a duration, otherwise we can continue
@@ -1237,7 +1242,7 @@ int LayerElement::GenerateMIDI(FunctorParams *functorParams)
 
 int LayerElement::GenerateMIDIEnd(FunctorParams *functorParams)
 {
-    GenerateMIDIParams *params = dynamic_cast<GenerateMIDIParams *>(functorParams);
+    GenerateMIDIParams *params = static_cast<GenerateMIDIParams *>(functorParams);
     assert(params);
 
     if (this->Is(CHORD)) {
@@ -1253,7 +1258,7 @@ int LayerElement::GenerateMIDIEnd(FunctorParams *functorParams)
 
 int LayerElement::CalcMaxMeasureDuration(FunctorParams *functorParams)
 {
-    CalcMaxMeasureDurationParams *params = dynamic_cast<CalcMaxMeasureDurationParams *>(functorParams);
+    CalcMaxMeasureDurationParams *params = static_cast<CalcMaxMeasureDurationParams *>(functorParams);
     assert(params);
 
     // Here we need to check if the LayerElement as a duration, otherwise we can continue
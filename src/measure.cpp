@@ -45,6 +45,7 @@ Measure::Measure(bool measureMusic, int logMeasureNb)
     RegisterAttClass(ATT_TYPED);
 
     m_measuredMusic = measureMusic;
+    m_cachedDrawingXGeneration = 0;
     // We set parent to it because we want to access the parent doc from the aligners
     m_measureAligner.SetParent(this);
     // Idem for timestamps
@@ -87,6 +88,9 @@ void Measure::Reset()
     m_xAbs = VRV_UNSET;
     m_xAbs2 = VRV_UNSET;
     m_drawingXRel = 0;
+    m_castOffXRel = 0;
+    m_castOffWidth = 0;
+    m_castOffAlignmentChanged = false;
 
     // by default, we have a single barLine on the right (none on the left)
     m_rightBarLine.SetForm(this->GetRight());
@@ -132,17 +136,22 @@ int Measure::GetDrawingX() const
 {
     if (m_xAbs != VRV_UNSET) return m_xAbs;
 
-    if (m_cachedDrawingX != VRV_UNSET) return m_cachedDrawingX;
+    if ((m_cachedDrawingX != VRV_UNSET) && (m_cachedDrawingXGeneration == m_measureAligner.GetDrawingXGeneration())) {
+        return m_cachedDrawingX;
+    }
 
     System *system = dynamic_cast<System *>(this->GetFirstParent(SYSTEM));
     assert(system);
     m_cachedDrawingX = system->GetDrawingX() + this->GetDrawingXRel();
+    m_cachedDrawingXGeneration = m_measureAligner.GetDrawingXGeneration();
     return m_cachedDrawingX;
 }
 
 void Measure::SetDrawingXRel(int drawingXRel)
 {
-    ResetCachedDrawingX();
+    // This invalidates the cached drawing X of the measure and of all the aligned elements it contains.
+    // Elements without alignment (and the timestamps) do not cache it.
+    m_measureAligner.IncrementDrawingXGeneration();
     m_drawingXRel = drawingXRel;
 }
 
@@ -278,7 +287,7 @@ void Measure::UpgradePageBasedMEI(System *system)
 
 int Measure::ConvertToPageBased(FunctorParams *functorParams)
 {
-    ConvertToPageBasedParams *params = dynamic_cast<ConvertToPageBasedParams *>(functorParams);
+    ConvertToPageBasedParams *params = static_cast<ConvertToPageBasedParams *>(functorParams);
     assert(params);
 
     // Move itself to the pageBasedSystem - do not process children
@@ -387,7 +396,7 @@ int Measure::ResetHorizontalAlignment(FunctorParams *functorParams)
 
 int Measure::ApplyPPUFactor(FunctorParams *functorParams)
 {
-    ApplyPPUFactorParams *params = dynamic_cast<ApplyPPUFactorParams *>(functorParams);
+    ApplyPPUFactorParams *params = static_cast<ApplyPPUFactorParams *>(functorParams);
     assert(params);
 
     if (m_xAbs != VRV_UNSET) m_xAbs /= params->m_page->GetPPUFactor();
@@ -398,7 +407,7 @@ int Measure::ApplyPPUFactor(FunctorParams *functorParams)
 
 int Measure::AlignHorizontally(FunctorParams *functorParams)
 {
-    AlignHorizontallyParams *params = dynamic_cast<AlignHorizontallyParams *>(functorParams);
+    AlignHorizontallyParams *params = static_cast<AlignHorizontallyParams *>(functorParams);
     assert(params);
 
     // clear the content of the measureAligner
@@ -418,7 +427,7 @@ int Measure::AlignHorizontally(FunctorParams *functorParams)
 
 int Measure::AlignHorizontallyEnd(FunctorParams *functorParams)
 {
-    AlignHorizontallyParams *params = dynamic_cast<AlignHorizontallyParams *>(functorParams);
+    AlignHorizontallyParams *params = static_cast<AlignHorizontallyParams *>(functorParams);
     assert(params);
 
     // We also need to align the timestamps - we do it at the end since we need the *meterSig to be initialized by a
@@ -437,7 +446,7 @@ int Measure::AlignHorizontallyEnd(FunctorParams *functorParams)
 
 int Measure::AlignVertically(FunctorParams *functorParams)
 {
-    AlignVerticallyParams *params = dynamic_cast<AlignVerticallyParams *>(functorParams);
+    AlignVerticallyParams *params = static_cast<AlignVerticallyParams *>(functorParams);
     assert(params);
 
     // we also need to reset the staffNb
@@ -448,7 +457,7 @@ int Measure::AlignVertically(FunctorParams *functorParams)
 
 int Measure::AdjustLayers(FunctorParams *functorParams)
 {
-    AdjustLayersParams *params = dynamic_cast<AdjustLayersParams *>(functorParams);
+    AdjustLayersParams *params = static_cast<AdjustLayersParams *>(functorParams);
     assert(params);
 
     if (!m_hasAlignmentRefWithMultipleLayers) return FUNCTOR_SIBLINGS;
@@ -473,7 +482,7 @@ int Measure::AdjustLayers(FunctorParams *functorParams)
 
 int Measure::AdjustAccidX(FunctorParams *functorParams)
 {
-    AdjustAccidXParams *params = dynamic_cast<AdjustAccidXParams *>(functorParams);
+    AdjustAccidXParams *params = static_cast<AdjustAccidXParams *>(functorParams);
     assert(params);
 
     params->m_currentMeasure = this;
@@ -485,7 +494,7 @@ int Measure::AdjustAccidX(FunctorParams *functorParams)
 
 int Measure::AdjustGraceXPos(FunctorParams *functorParams)
 {
-    AdjustGraceXPosParams *params = dynamic_cast<AdjustGraceXPosParams *>(functorParams);
+    AdjustGraceXPosParams *params = static_cast<AdjustGraceXPosParams *>(functorParams);
     assert(params);
 
     m_measureAligner.PushAlignmentsRight();
@@ -500,7 +509,7 @@ int Measure::AdjustGraceXPos(FunctorParams *functorParams)
 
 int Measure::AdjustXPos(FunctorParams *functorParams)
 {
-    AdjustXPosParams *params = dynamic_cast<AdjustXPosParams *>(functorParams);
+    AdjustXPosParams *params = static_cast<AdjustXPosParams *>(functorParams);
     assert(params);
 
     params->m_minPos = 0;
@@ -547,7 +556,7 @@ int Measure::AdjustXPos(FunctorParams *functorParams)
 
 int Measure::AdjustSylSpacingEnd(FunctorParams *functorParams)
 {
-    AdjustSylSpacingParams *params = dynamic_cast<AdjustSylSpacingParams *>(functorParams);
+    AdjustSylSpacingParams *params = static_cast<AdjustSylSpacingParams *>(functorParams);
     assert(params);
 
     // Here we also need to handle the last syl or the measure - we check the alignment with the right barline
@@ -568,7 +577,7 @@ int Measure::AdjustSylSpacingEnd(FunctorParams *functorParams)
 
 int Measure::SetAlignmentXPos(FunctorParams *functorParams)
 {
-    SetAlignmentXPosParams *params = dynamic_cast<SetAlignmentXPosParams *>(functorParams);
+    SetAlignmentXPosParams *params = static_cast<SetAlignmentXPosParams *>(functorParams);
     assert(params);
 
     m_measureAligner.Process(params->m_functor, params);
@@ -578,7 +587,7 @@ int Measure::SetAlignmentXPos(FunctorParams *functorParams)
 
 int Measure::JustifyX(FunctorParams *functorParams)
 {
-    JustifyXParams *params = dynamic_cast<JustifyXParams *>(functorParams);
+    JustifyXParams *params = static_cast<JustifyXParams *>(functorParams);
     assert(params);
 
     if (params->m_measureXRel > 0) {
@@ -595,7 +604,7 @@ int Measure::JustifyX(FunctorParams *functorParams)
 
 int Measure::AlignMeasures(FunctorParams *functorParams)
 {
-    AlignMeasuresParams *params = dynamic_cast<AlignMeasuresParams *>(functorParams);
+    AlignMeasuresParams *params = static_cast<AlignMeasuresParams *>(functorParams);
     assert(params);
 
     SetDrawingXRel(params->m_shift);
@@ -617,15 +626,26 @@ int Measure::ResetDrawing(FunctorParams *functorParams)
 
 int Measure::CastOffSystems(FunctorParams *functorParams)
 {
-    CastOffSystemsParams *params = dynamic_cast<CastOffSystemsParams *>(functorParams);
+    CastOffSystemsParams *params = static_cast<CastOffSystemsParams *>(functorParams);
     assert(params);
 
+    // Keep the position and the width from the horizontal layout of the content system, unless we are reusing them
+    if (!params->m_reuseWidths) {
+        m_castOffXRel = this->m_drawingXRel;
+        m_castOffWidth = this->GetWidth();
+    }
+    else {
+        this->SetDrawingXRel(m_castOffXRel);
+    }
+    // The measure was aligned again in the content system if its alignment was changed (see Doc::CastOffDoc)
+    m_castOffAlignmentChanged = false;
+
     if ((params->m_currentSystem->GetChildCount() > 0)
-        && (this->m_drawingXRel + this->GetWidth() + params->m_currentScoreDefWidth - params->m_shift
+        && (m_castOffXRel + m_castOffWidth + params->m_currentScoreDefWidth - params->m_shift
                > params->m_systemWidth)) {
         params->m_currentSystem = new System();
         params->m_page->AddChild(params->m_currentSystem);
-        params->m_shift = this->m_drawingXRel;
+        params->m_shift = m_castOffXRel;
     }
 
     // First add all pendings objects
@@ -648,7 +668,7 @@ int Measure::CastOffSystems(FunctorParams *functorParams)
 
 int Measure::CastOffEncoding(FunctorParams *functorParams)
 {
-    CastOffEncodingParams *params = dynamic_cast<CastOffEncodingParams *>(functorParams);
+    CastOffEncodingParams *params = static_cast<CastOffEncodingParams *>(functorParams);
     assert(params);
 
     MoveItselfTo(params->m_currentSystem);
@@ -658,7 +678,7 @@ int Measure::CastOffEncoding(FunctorParams *functorParams)
 
 int Measure::FillStaffCurrentTimeSpanningEnd(FunctorParams *functorParams)
 {
-    FillStaffCurrentTimeSpanningParams *params = dynamic_cast<FillStaffCurrentTimeSpanningParams *>(functorParams);
+    FillStaffCurrentTimeSpanningParams *params = static_cast<FillStaffCurrentTimeSpanningParams *>(functorParams);
     assert(params);
 
     std::vector<Object *>::iterator iter = params->m_timeSpanningElements.begin();
@@ -680,7 +700,7 @@ int Measure::FillStaffCurrentTimeSpanningEnd(FunctorParams *functorParams)
 
 int Measure::PrepareBoundaries(FunctorParams *functorParams)
 {
-    PrepareBoundariesParams *params = dynamic_cast<PrepareBoundariesParams *>(functorParams);
+    PrepareBoundariesParams *params = static_cast<PrepareBoundariesParams *>(functorParams);
     assert(params);
 
     std::vector<BoundaryStartInterface *>::iterator iter;
@@ -702,7 +722,7 @@ int Measure::PrepareBoundaries(FunctorParams *functorParams)
 
 int Measure::PrepareCrossStaff(FunctorParams *functorParams)
 {
-    PrepareCrossStaffParams *params = dynamic_cast<PrepareCrossStaffParams *>(functorParams);
+    PrepareCrossStaffParams *params = static_cast<PrepareCrossStaffParams *>(functorParams);
     assert(params);
 
     params->m_currentMeasure = this;
@@ -712,7 +732,7 @@ int Measure::PrepareCrossStaff(FunctorParams *functorParams)
 
 int Measure::PrepareFloatingGrps(FunctorParams *functorParams)
 {
-    PrepareFloatingGrpsParams *params = dynamic_cast<PrepareFloatingGrpsParams *>(functorParams);
+    PrepareFloatingGrpsParams *params = static_cast<PrepareFloatingGrpsParams *>(functorParams);
     assert(params);
 
     if (params->m_previousEnding) {
@@ -726,7 +746,7 @@ int Measure::PrepareFloatingGrps(FunctorParams *functorParams)
 
 int Measure::PrepareTimePointingEnd(FunctorParams *functorParams)
 {
-    PrepareTimePointingParams *params = dynamic_cast<PrepareTimePointingParams *>(functorParams);
+    PrepareTimePointingParams *params = static_cast<PrepareTimePointingParams *>(functorParams);
     assert(params);
 
     if (!params->m_timePointingInterfaces.empty()) {
@@ -744,7 +764,7 @@ int Measure::PrepareTimePointingEnd(FunctorParams *functorParams)
 
 int Measure::PrepareTimeSpanningEnd(FunctorParams *functorParams)
 {
-    PrepareTimeSpanningParams *params = dynamic_cast<PrepareTimeSpanningParams *>(functorParams);
+    PrepareTimeSpanningParams *params = static_cast<PrepareTimeSpanningParams *>(functorParams);
     assert(params);
 
     ArrayOfSpanningInterClassIdPairs::iterator iter = params->m_timeSpanningInterfaces.begin();
@@ -767,7 +787,7 @@ int Measure::PrepareTimeSpanningEnd(FunctorParams *functorParams)
 
 int Measure::PrepareTimestampsEnd(FunctorParams *functorParams)
 {
-    PrepareTimestampsParams *params = dynamic_cast<PrepareTimestampsParams *>(functorParams);
+    PrepareTimestampsParams *params = static_cast<PrepareTimestampsParams *>(functorParams);
     assert(params);
 
     ArrayOfObjectBeatPairs::iterator iter = params->m_tstamps.begin();
@@ -830,7 +850,7 @@ int Measure::PrepareTimestampsEnd(FunctorParams *functorParams)
 
 int Measure::GenerateMIDI(FunctorParams *functorParams)
 {
-    GenerateMIDIParams *params = dynamic_cast<GenerateMIDIParams *>(functorParams);
+    GenerateMIDIParams *params = static_cast<GenerateMIDIParams *>(functorParams);
     assert(params);
 
     // Here we need to reset the currentMeasureTime because we are starting a new measure
@@ -841,7 +861,7 @@ int Measure::GenerateMIDI(FunctorParams *functorParams)
 
 int Measure::GenerateMIDIEnd(FunctorParams *functorParams)
 {
-    GenerateMIDIParams *params = dynamic_cast<GenerateMIDIParams *>(functorParams);
+    GenerateMIDIParams *params = static_cast<GenerateMIDIParams *>(functorParams);
     assert(params);
 
     // We a to the total time the maximum duration of the measure so if there is no layer, if the layer is not full
@@ -856,7 +876,7 @@ int Measure::GenerateMIDIEnd(FunctorParams *functorParams)
 
 int Measure::CalcMaxMeasureDuration(FunctorParams *functorParams)
 {
-    CalcMaxMeasureDurationParams *params = dynamic_cast<CalcMaxMeasureDurationParams *>(functorParams);
+    CalcMaxMeasureDurationParams *params = static_cast<CalcMaxMeasureDurationParams *>(functorParams);
     assert(params);
 
     // We just need to add a value to the stack
@@ -347,7 +347,7 @@ wchar_t Note::GetMensuralSmuflNoteHead()
 
 int Note::CalcStem(FunctorParams *functorParams)
 {
-    CalcStemParams *params = dynamic_cast<CalcStemParams *>(functorParams);
+    CalcStemParams *params = static_cast<CalcStemParams *>(functorParams);
     assert(params);
 
     // Stems have been calculated previously in Beam or FTrem - siblings becasue flags do not need to
@@ -422,7 +422,7 @@ int Note::CalcStem(FunctorParams *functorParams)
 
 int Note::CalcChordNoteHeads(FunctorParams *functorParams)
 {
-    FunctorDocParams *params = dynamic_cast<FunctorDocParams *>(functorParams);
+    FunctorDocParams *params = static_cast<FunctorDocParams *>(functorParams);
     assert(params);
 
     Staff *staff = dynamic_cast<Staff *>(this->GetFirstParent(STAFF));
@@ -475,7 +475,7 @@ int Note::CalcChordNoteHeads(FunctorParams *functorParams)
 
 int Note::CalcDots(FunctorParams *functorParams)
 {
-    CalcDotsParams *params = dynamic_cast<CalcDotsParams *>(functorParams);
+    CalcDotsParams *params = static_cast<CalcDotsParams *>(functorParams);
     assert(params);
 
     // We currently have no dots object with mensural notes
@@ -544,7 +544,7 @@ int Note::CalcDots(FunctorParams *functorParams)
 
 int Note::CalcLedgerLines(FunctorParams *functorParams)
 {
-    FunctorDocParams *params = dynamic_cast<FunctorDocParams *>(functorParams);
+    FunctorDocParams *params = static_cast<FunctorDocParams *>(functorParams);
     assert(params);
 
     Staff *staff = dynamic_cast<Staff *>(this->GetFirstParent(STAFF));
@@ -652,7 +652,7 @@ int Note::PrepareLayerElementParts(FunctorParams *functorParams)
 
 int Note::PrepareTieAttr(FunctorParams *functorParams)
 {
-    PrepareTieAttrParams *params = dynamic_cast<PrepareTieAttrParams *>(functorParams);
+    PrepareTieAttrParams *params = static_cast<PrepareTieAttrParams *>(functorParams);
     assert(params);
 
     AttTiepresent *check = this;
@@ -702,7 +702,7 @@ int Note::FillStaffCurrentTimeSpanning(FunctorParams *functorParams)
 
 int Note::PrepareLyrics(FunctorParams *functorParams)
 {
-    PrepareLyricsParams *params = dynamic_cast<PrepareLyricsParams *>(functorParams);
+    PrepareLyricsParams *params = static_cast<PrepareLyricsParams *>(functorParams);
     assert(params);
 
     params->m_lastButOneNote = params->m_lastNote;
@@ -713,7 +713,7 @@ int Note::PrepareLyrics(FunctorParams *functorParams)
 
 int Note::PreparePointersByLayer(FunctorParams *functorParams)
 {
-    PreparePointersByLayerParams *params = dynamic_cast<PreparePointersByLayerParams *>(functorParams);
+    PreparePointersByLayerParams *params = static_cast<PreparePointersByLayerParams *>(functorParams);
     assert(params);
 
     params->m_currentNote = this;
@@ -32,6 +32,7 @@
 #include "metersig.h"
 #include "note.h"
 #include "page.h"
+#include "profiler.h"
 #include "staff.h"
 #include "system.h"
 #include "tempo.h"
@@ -45,7 +46,7 @@ namespace vrv {
 // Object
 //----------------------------------------------------------------------------
 
-unsigned long Object::s_objectCounter = 0;
+std::atomic<unsigned long> Object::s_objectCounter(0);
 
 Object::Object() : BoundingBox()
 {
@@ -561,12 +562,82 @@ void Object::Process(Functor *functor, FunctorParams *functorParams, Functor *en
         return;
     }
 
-    bool processChildren = true;
+    // Look-up table of the comparison object to use for each ClassId - only the first one matching is used
+    std::vector<AttComparison *> filtersByClassId;
+    if (filters && !filters->empty()) {
+        filtersByClassId.resize(UNSPECIFIED + 1, NULL);
+        ArrayOfAttComparisons::iterator attComparisonIter;
+        for (attComparisonIter = filters->begin(); attComparisonIter != filters->end(); attComparisonIter++) {
+            ClassId classId = (*attComparisonIter)->GetType();
+            if (!filtersByClassId.at(classId)) filtersByClassId.at(classId) = *attComparisonIter;
+        }
+    }
+
+    // The explicit stack replacing the recursion, with one frame for each object whose children are processed
+    std::vector<ProcessFrame> stack;
+    stack.reserve(16);
+
+    // The number of objects on which the functor is called (for profiling)
+    long visited = 0;
+
+    Object *current = this;
+    while (true) {
+        if (current) {
+            visited++;
+            ProcessFrame frame(current, deepness, direction);
+            if (current->ProcessEnter(functor, functorParams, frame)) {
+                stack.push_back(frame);
+            }
+            current = NULL;
+        }
+        if (stack.empty()) {
+            break;
+        }
+
+        ProcessFrame &top = stack.back();
+        // Look for the next child to process, which is evaluated with the filter for its type (if any)
+        while (top.m_processChildren && (functor->m_returnCode != FUNCTOR_STOP)) {
+            if ((top.m_next < 0) || (top.m_next >= (int)top.m_object->m_children.size())) {
+                break;
+            }
+            Object *child = top.m_object->m_children.at(top.m_next);
+            top.m_next += (direction == FORWARD) ? 1 : -1;
+            if (!filtersByClassId.empty()) {
+                AttComparison *attComparison = filtersByClassId.at(child->GetClassId());
+                // use the operator of the AttComparison object to evaluate the attribute
+                if (attComparison && !(*attComparison)(child)) {
+                    continue;
+                }
+            }
+            current = child;
+            deepness = top.m_deepness;
+            break;
+        }
+        if (current) {
+            continue;
+        }
+
+        // All the children have been processed
+        if (endFunctor) {
+            endFunctor->Call(top.m_object, functorParams);
+        }
+        stack.pop_back();
+    }
+
+    Profiler::AddVisitedNodes(visited);
+}
+
+bool Object::ProcessEnter(Functor *functor, FunctorParams *functorParams, ProcessFrame &frame)
+{
+    if (functor->m_returnCode == FUNCTOR_STOP) {
+        return false;
+    }
+
     if (functor->m_visibleOnly && this->IsEditorialElement()) {
         EditorialElement *editorialElement = dynamic_cast<EditorialElement *>(this);
         assert(editorialElement);
         if (editorialElement->m_visibility == Hidden) {
-            processChildren = false;
+            frame.m_processChildren = false;
         }
     }
 
@@ -575,63 +646,21 @@ void Object::Process(Functor *functor, FunctorParams *functorParams, Functor *en
     // do not go any deeper in this case
     if (functor->m_returnCode == FUNCTOR_SIBLINGS) {
         functor->m_returnCode = FUNCTOR_CONTINUE;
-        return;
+        return false;
     }
     else if (this->IsEditorialElement()) {
         // since editorial object doesn't count, we increase the deepness limit
-        deepness++;
+        frame.m_deepness++;
     }
-    if (deepness == 0) {
+    if (frame.m_deepness == 0) {
         // any need to change the functor m_returnCode?
-        return;
-    }
-    deepness--;
-
-    if (processChildren) {
-        ArrayOfObjects::iterator iter;
-        // We need a pointer to the array for the option to work on a reversed copy
-        ArrayOfObjects *children = &this->m_children;
-        ArrayOfObjects reversed;
-        // For processing backwards, we operated on a copied reversed version
-        // Since we hold pointers, only addresses are copied
-        if (direction == BACKWARD) {
-            reversed = (*children);
-            std::reverse(reversed.begin(), reversed.end());
-            children = &reversed;
-        }
-        for (iter = children->begin(); iter != children->end(); ++iter) {
-            if (filters && !filters->empty()) {
-                bool hasAttComparison = false;
-                // first we look if there is a comparison object for the object type (e.g., a Staff)
-                ArrayOfAttComparisons::iterator attComparisonIter;
-                for (attComparisonIter = filters->begin(); attComparisonIter != filters->end(); attComparisonIter++) {
-                    // if yes, we will use it (*attComparisonIter) for evaluating if the object matches
-                    // the attribute (see below)
-                    Object *o = *iter;
-                    if (o->GetClassId() == (*attComparisonIter)->GetType()) {
-                        hasAttComparison = true;
-                        break;
-                    }
-                }
-                if (hasAttComparison) {
-                    // use the operator of the AttComparison object to evaluate the attribute
-                    if ((**attComparisonIter)(*iter)) {
-                        // the attribute value matches, process the object
-                        // LogDebug("%s ", (*iter)->GetClassName().c_str());
-                        (*iter)->Process(functor, functorParams, endFunctor, filters, deepness, direction);
-                    }
-                    // continue to the next child
-                    continue;
-                }
-            }
-            // we will end here if there is no filter at all or for the current child type
-            (*iter)->Process(functor, functorParams, endFunctor, filters, deepness, direction);
-        }
+        return false;
     }
+    frame.m_deepness--;
 
-    if (endFunctor) {
-        endFunctor->Call(this, functorParams);
-    }
+    // For processing backwards, we start from the last child (as it is after the functor call)
+    frame.m_next = (frame.m_direction == FORWARD) ? 0 : (int)m_children.size() - 1;
+    return true;
 }
 
 int Object::Save(FileOutputStream *output)
@@ -801,19 +830,13 @@ Functor::Functor(int (Object::*_obj_fpt)(FunctorParams *))
     obj_fpt = _obj_fpt;
 }
 
-void Functor::Call(Object *ptr, FunctorParams *functorParams)
-{
-    // we should have return codes (not just bool) for avoiding to go further down the tree in some cases
-    m_returnCode = (*ptr.*obj_fpt)(functorParams);
-}
-
 //----------------------------------------------------------------------------
 // Object functor methods
 //----------------------------------------------------------------------------
 
 int Object::AddLayerElementToFlatList(FunctorParams *functorParams)
 {
-    AddLayerElementToFlatListParams *params = dynamic_cast<AddLayerElementToFlatListParams *>(functorParams);
+    AddLayerElementToFlatListParams *params = static_cast<AddLayerElementToFlatListParams *>(functorParams);
     assert(params);
 
     params->m_flatList->push_back(this);
@@ -824,7 +847,7 @@ int Object::AddLayerElementToFlatList(FunctorParams *functorParams)
 
 int Object::FindByUuid(FunctorParams *functorParams)
 {
-    FindByUuidParams *params = dynamic_cast<FindByUuidParams *>(functorParams);
+    FindByUuidParams *params = static_cast<FindByUuidParams *>(functorParams);
     assert(params);
 
     if (params->m_element) {
@@ -843,7 +866,7 @@ int Object::FindByUuid(FunctorParams *functorParams)
 
 int Object::FindByAttComparison(FunctorParams *functorParams)
 {
-    FindByAttComparisonParams *params = dynamic_cast<FindByAttComparisonParams *>(functorParams);
+    FindByAttComparisonParams *params = static_cast<FindByAttComparisonParams *>(functorParams);
     assert(params);
 
     if (params->m_element) {
@@ -863,7 +886,7 @@ int Object::FindByAttComparison(FunctorParams *functorParams)
 
 int Object::FindExtremeByAttComparison(FunctorParams *functorParams)
 {
-    FindExtremeByAttComparisonParams *params = dynamic_cast<FindExtremeByAttComparisonParams *>(functorParams);
+    FindExtremeByAttComparisonParams *params = static_cast<FindExtremeByAttComparisonParams *>(functorParams);
     assert(params);
 
     // evaluate by applying the AttComparison operator()
@@ -876,7 +899,7 @@ int Object::FindExtremeByAttComparison(FunctorParams *functorParams)
 
 int Object::FindAllByAttComparison(FunctorParams *functorParams)
 {
-    FindAllByAttComparisonParams *params = dynamic_cast<FindAllByAttComparisonParams *>(functorParams);
+    FindAllByAttComparisonParams *params = static_cast<FindAllByAttComparisonParams *>(functorParams);
     assert(params);
 
     // evaluate by applying the AttComparison operator()
@@ -889,7 +912,7 @@ int Object::FindAllByAttComparison(FunctorParams *functorParams)
 
 int Object::SetCautionaryScoreDef(FunctorParams *functorParams)
 {
-    SetCautionaryScoreDefParams *params = dynamic_cast<SetCautionaryScoreDefParams *>(functorParams);
+    SetCautionaryScoreDefParams *params = static_cast<SetCautionaryScoreDefParams *>(functorParams);
     assert(params);
 
     assert(params->m_currentScoreDef);
@@ -915,7 +938,7 @@ int Object::SetCautionaryScoreDef(FunctorParams *functorParams)
 
 int Object::SetCurrentScoreDef(FunctorParams *functorParams)
 {
-    SetCurrentScoreDefParams *params = dynamic_cast<SetCurrentScoreDefParams *>(functorParams);
+    SetCurrentScoreDefParams *params = static_cast<SetCurrentScoreDefParams *>(functorParams);
     assert(params);
 
     assert(params->m_upcomingScoreDef);
@@ -1059,7 +1082,7 @@ int Object::SetCurrentScoreDef(FunctorParams *functorParams)
 
 int Object::GetAlignmentLeftRight(FunctorParams *functorParams)
 {
-    GetAlignmentLeftRightParams *params = dynamic_cast<GetAlignmentLeftRightParams *>(functorParams);
+    GetAlignmentLeftRightParams *params = static_cast<GetAlignmentLeftRightParams *>(functorParams);
     assert(params);
 
     if (!this->IsLayerElement()) return FUNCTOR_CONTINUE;
@@ -1077,7 +1100,7 @@ int Object::GetAlignmentLeftRight(FunctorParams *functorParams)
 
 int Object::SetOverflowBBoxes(FunctorParams *functorParams)
 {
-    SetOverflowBBoxesParams *params = dynamic_cast<SetOverflowBBoxesParams *>(functorParams);
+    SetOverflowBBoxesParams *params = static_cast<SetOverflowBBoxesParams *>(functorParams);
     assert(params);
 
     // starting a new staff
@@ -1176,7 +1199,7 @@ int Object::SetOverflowBBoxes(FunctorParams *functorParams)
 
 int Object::SetOverflowBBoxesEnd(FunctorParams *functorParams)
 {
-    SetOverflowBBoxesParams *params = dynamic_cast<SetOverflowBBoxesParams *>(functorParams);
+    SetOverflowBBoxesParams *params = static_cast<SetOverflowBBoxesParams *>(functorParams);
     assert(params);
 
     // starting new layer
@@ -1202,7 +1225,7 @@ int Object::SetOverflowBBoxesEnd(FunctorParams *functorParams)
 
 int Object::Save(FunctorParams *functorParams)
 {
-    SaveParams *params = dynamic_cast<SaveParams *>(functorParams);
+    SaveParams *params = static_cast<SaveParams *>(functorParams);
     assert(params);
 
     if (!params->m_output->WriteObject(this)) {
@@ -1213,7 +1236,7 @@ int Object::Save(FunctorParams *functorParams)
 
 int Object::SaveEnd(FunctorParams *functorParams)
 {
-    SaveParams *params = dynamic_cast<SaveParams *>(functorParams);
+    SaveParams *params = static_cast<SaveParams *>(functorParams);
     assert(params);
 
     if (!params->m_output->WriteObjectEnd(this)) {
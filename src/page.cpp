@@ -17,6 +17,9 @@
 #include "bboxdevicecontext.h"
 #include "doc.h"
 #include "functorparams.h"
+#include "layer.h"
+#include "measure.h"
+#include "profiler.h"
 #include "system.h"
 #include "view.h"
 #include "vrv.h"
@@ -42,6 +45,8 @@ void Page::Reset()
 
     m_drawingScoreDef.Reset();
     m_layoutDone = false;
+    m_castOffLongestActualDur = VRV_UNSET;
+    m_longestActualDur = DUR_4;
     this->ResetUuid();
 
     // by default we have no values and use the document ones
@@ -74,11 +79,34 @@ void Page::LayOut(bool force)
         return;
     }
 
-    this->LayOutHorizontally();
+    this->LayOutHorizontally((m_castOffLongestActualDur != VRV_UNSET) && !force);
     this->JustifyHorizontally();
     this->LayOutVertically();
 
     m_layoutDone = true;
+    m_castOffLongestActualDur = VRV_UNSET;
+
+    // The alignment of the measures was changed in place (system scoreDefs and justification). The next cast-off keeps
+    // their position and width but needs to align them again before laying out the content vertically
+    for (int i = 0; i < this->GetChildCount(); i++) {
+        Object *system = this->GetChild(i);
+        for (int j = 0; j < system->GetChildCount(); j++) {
+            Measure *measure = dynamic_cast<Measure *>(system->GetChild(j));
+            if (measure) measure->SetCastOffAlignmentChanged(true);
+        }
+    }
+}
+
+bool Page::HasCastOffAlignmentChanged() const
+{
+    for (int i = 0; i < this->GetChildCount(); i++) {
+        const Object *system = this->GetChild(i);
+        for (int j = 0; j < system->GetChildCount(); j++) {
+            const Measure *measure = dynamic_cast<const Measure *>(system->GetChild(j));
+            if (measure && measure->HasCastOffAlignmentChanged()) return true;
+        }
+    }
+    return false;
 }
 
 void Page::LayOutTranscription(bool force)
@@ -153,8 +181,10 @@ void Page::LayOutTranscription(bool force)
     m_layoutDone = true;
 }
 
-void Page::LayOutHorizontally()
+void Page::LayOutHorizontally(bool reuseCastOff)
 {
+    ProfilerScope profilerScope("LayOutHorizontally");
+
     Doc *doc = dynamic_cast<Doc *>(GetParent());
     assert(doc);
 
@@ -162,13 +192,55 @@ void Page::LayOutHorizontally()
     // Make sure we have the correct page
     assert(this == doc->GetDrawingPage());
 
+    // When reusing the alignment done when casting off the document, only the first and the last measure of each
+    // system need to be aligned again - the filter is passed to all the functors processing the measure content.
+    // Measures with a scoreDef or staffDef change are also aligned again because their drawing clefs, key signatures,
+    // etc. were re-created by Doc::CollectScoreDefs after the cast-off and the alignment still points to the old ones
+    // Measures whose alignment was changed by the layout of a page since the cast-off are aligned again as well
+    ArrayOfObjects boundaryMeasures;
+    if (reuseCastOff) {
+        AttComparison matchLayer(LAYER);
+        ArrayOfObjects layers;
+        for (int i = 0; i < this->GetChildCount(); i++) {
+            Object *system = this->GetChild(i);
+            Object *first = system->FindChildByType(MEASURE, 1, FORWARD);
+            Object *last = system->FindChildByType(MEASURE, 1, BACKWARD);
+            for (int j = 0; j < system->GetChildCount(); j++) {
+                Object *measure = system->GetChild(j);
+                if (!measure->Is(MEASURE)) continue;
+                bool isBoundary = ((measure == first) || (measure == last)
+                    || dynamic_cast<Measure *>(measure)->HasCastOffAlignmentChanged());
+                if (!isBoundary) {
+                    measure->FindAllChildByAttComparison(&layers, &matchLayer);
+                    for (ArrayOfObjects::iterator iter = layers.begin(); iter != layers.end(); iter++) {
+                        Layer *layer = dynamic_cast<Layer *>(*iter);
+                        assert(layer);
+                        if (layer->HasStaffDef() || layer->HasCautionStaffDef()) {
+                            isBoundary = true;
+                            break;
+                        }
+                    }
+                }
+                if (isBoundary) boundaryMeasures.push_back(measure);
+            }
+        }
+    }
+    IsInListComparison isBoundaryMeasure(MEASURE, boundaryMeasures);
+    ArrayOfAttComparisons measureFilters;
+    if (reuseCastOff) measureFilters.push_back(&isBoundaryMeasure);
+    ArrayOfAttComparisons *filters = (reuseCastOff) ? &measureFilters : NULL;
+
     // Reset the horizontal alignment
     Functor resetHorizontalAlignment(&Object::ResetHorizontalAlignment);
-    this->Process(&resetHorizontalAlignment, NULL);
+    Profiler::Start("ResetHorizontalAlignment");
+    this->Process(&resetHorizontalAlignment, NULL, NULL, filters);
+    Profiler::End();
 
     // Reset the vertical alignment
     Functor resetVerticalAlignment(&Object::ResetVerticalAlignment);
+    Profiler::Start("ResetVerticalAlignment");
     this->Process(&resetVerticalAlignment, NULL);
+    Profiler::End();
 
     // Align the content of the page using measure aligners
     // After this:
@@ -176,7 +248,9 @@ void Page::LayOutHorizontally()
     Functor alignHorizontally(&Object::AlignHorizontally);
     Functor alignHorizontallyEnd(&Object::AlignHorizontallyEnd);
     AlignHorizontallyParams alignHorizontallyParams(&alignHorizontally);
-    this->Process(&alignHorizontally, &alignHorizontallyParams, &alignHorizontallyEnd);
+    Profiler::Start("AlignHorizontally");
+    this->Process(&alignHorizontally, &alignHorizontallyParams, &alignHorizontallyEnd, filters);
+    Profiler::End();
 
     // Align the content of the page using system aligners
     // After this:
@@ -184,70 +258,97 @@ void Page::LayOutHorizontally()
     Functor alignVertically(&Object::AlignVertically);
     Functor alignVerticallyEnd(&Object::AlignVerticallyEnd);
     AlignVerticallyParams alignVerticallyParams(doc, &alignVerticallyEnd);
+    Profiler::Start("AlignVertically");
     this->Process(&alignVertically, &alignVerticallyParams, &alignVerticallyEnd);
+    Profiler::End();
 
     // Unless duration-based spacing is disabled, set the X position of each Alignment.
     // Does non-linear spacing based on the duration space between two Alignment objects.
     if (!doc->GetEvenSpacing()) {
         int longestActualDur = DUR_4;
-        // Get the longest duration in the piece
-        AttDurExtreme durExtremeComparison(LONGEST);
-        Object *longestDur = this->FindChildExtremeByAttComparison(&durExtremeComparison);
-        if (longestDur) {
-            DurationInterface *interface = longestDur->GetDurationInterface();
-            assert(interface);
-            longestActualDur = interface->GetActualDur();
-            // LogDebug("Longest duration is DUR_* code %d", longestActualDur);
+        // When reusing the cast-off alignment, we have to keep the longest duration it was done with
+        if (reuseCastOff) {
+            longestActualDur = m_castOffLongestActualDur;
+        }
+        else {
+            // Get the longest duration in the piece
+            AttDurExtreme durExtremeComparison(LONGEST);
+            Object *longestDur = this->FindChildExtremeByAttComparison(&durExtremeComparison);
+            if (longestDur) {
+                DurationInterface *interface = longestDur->GetDurationInterface();
+                assert(interface);
+                longestActualDur = interface->GetActualDur();
+                // LogDebug("Longest duration is DUR_* code %d", longestActualDur);
+            }
         }
+        m_longestActualDur = longestActualDur;
 
         Functor setAlignmentX(&Object::SetAlignmentXPos);
         SetAlignmentXPosParams setAlignmentXPosParams(doc, &setAlignmentX);
         setAlignmentXPosParams.m_longestActualDur = longestActualDur;
-        this->Process(&setAlignmentX, &setAlignmentXPosParams);
+        Profiler::Start("SetAlignmentXPos");
+        this->Process(&setAlignmentX, &setAlignmentXPosParams, NULL, filters);
+        Profiler::End();
     }
 
     // Set the pitch / pos alignement
     SetAlignmentPitchPosParams setAlignmentPitchPosParams(doc);
     Functor setAlignmentPitchPos(&Object::SetAlignmentPitchPos);
-    this->Process(&setAlignmentPitchPos, &setAlignmentPitchPosParams);
+    Profiler::Start("SetAlignmentPitchPos");
+    this->Process(&setAlignmentPitchPos, &setAlignmentPitchPosParams, NULL, filters);
+    Profiler::End();
 
     CalcStemParams calcStemParams(doc);
     Functor calcStem(&Object::CalcStem);
-    this->Process(&calcStem, &calcStemParams);
+    Profiler::Start("CalcStem");
+    this->Process(&calcStem, &calcStemParams, NULL, filters);
+    Profiler::End();
 
     FunctorDocParams calcChordNoteHeadsParams(doc);
     Functor calcChordNoteHeads(&Object::CalcChordNoteHeads);
-    this->Process(&calcChordNoteHeads, &calcChordNoteHeadsParams);
+    Profiler::Start("CalcChordNoteHeads");
+    this->Process(&calcChordNoteHeads, &calcChordNoteHeadsParams, NULL, filters);
+    Profiler::End();
 
     CalcDotsParams calcDotsParams(doc);
     Functor calcDots(&Object::CalcDots);
-    this->Process(&calcDots, &calcDotsParams);
+    Profiler::Start("CalcDots");
+    this->Process(&calcDots, &calcDotsParams, NULL, filters);
+    Profiler::End();
 
     // Render it for filling the bounding box
     View view;
     view.SetDoc(doc);
     BBoxDeviceContext bBoxDC(&view, 0, 0, BBOX_HORIZONTAL_ONLY);
     // Do not do the layout in this view - otherwise we will loop...
+    Profiler::Start("BBoxRender");
     view.SetPage(this->GetIdx(), false);
     view.DrawCurrentPage(&bBoxDC, false);
+    Profiler::End();
 
     // Adjust the x position of the LayerElement where multiple layer collide
     // Look at each LayerElement and change the m_xShift if the bounding box is overlapping
     Functor adjustLayers(&Object::AdjustLayers);
     AdjustLayersParams adjustLayersParams(doc, &adjustLayers, doc->m_scoreDef.GetStaffNs());
-    this->Process(&adjustLayers, &adjustLayersParams);
+    Profiler::Start("AdjustLayers");
+    this->Process(&adjustLayers, &adjustLayersParams, NULL, filters);
+    Profiler::End();
 
     // Adjust the X position of the accidentals, including in chords
     Functor adjustAccidX(&Object::AdjustAccidX);
     AdjustAccidXParams adjustAccidXParams(doc, &adjustAccidX);
-    this->Process(&adjustAccidX, &adjustAccidXParams);
+    Profiler::Start("AdjustAccidX");
+    this->Process(&adjustAccidX, &adjustAccidXParams, NULL, filters);
+    Profiler::End();
 
     // Adjust the X shift of the Alignment looking at the bounding boxes
     // Look at each LayerElement and change the m_xShift if the bounding box is overlapping
     Functor adjustXPos(&Object::AdjustXPos);
     Functor adjustXPosEnd(&Object::AdjustXPosEnd);
     AdjustXPosParams adjustXPosParams(doc, &adjustXPos, &adjustXPosEnd, doc->m_scoreDef.GetStaffNs());
-    this->Process(&adjustXPos, &adjustXPosParams, &adjustXPosEnd);
+    Profiler::Start("AdjustXPos");
+    this->Process(&adjustXPos, &adjustXPosParams, &adjustXPosEnd, filters);
+    Profiler::End();
 
     // Adjust the X shift of the Alignment looking at the bounding boxes
     // Look at each LayerElement and change the m_xShift if the bounding box is overlapping
@@ -255,25 +356,35 @@ void Page::LayOutHorizontally()
     Functor adjustGraceXPosEnd(&Object::AdjustGraceXPosEnd);
     AdjustGraceXPosParams adjustGraceXPosParams(
         doc, &adjustGraceXPos, &adjustGraceXPosEnd, doc->m_scoreDef.GetStaffNs());
-    this->Process(&adjustGraceXPos, &adjustGraceXPosParams, &adjustGraceXPosEnd);
+    Profiler::Start("AdjustGraceXPos");
+    this->Process(&adjustGraceXPos, &adjustGraceXPosParams, &adjustGraceXPosEnd, filters);
+    Profiler::End();
 
     // We need to populate processing lists for processing the document by Layer (for matching @tie) and
     // by Verse (for matching syllable connectors)
     PrepareProcessingListsParams prepareProcessingListsParams;
     Functor prepareProcessingLists(&Object::PrepareProcessingLists);
-    this->Process(&prepareProcessingLists, &prepareProcessingListsParams);
+    Profiler::Start("PrepareProcessingLists");
+    this->Process(&prepareProcessingLists, &prepareProcessingListsParams, NULL, filters);
+    Profiler::End();
 
-    this->AdjustSylSpacingByVerse(prepareProcessingListsParams, doc);
+    Profiler::Start("AdjustSylSpacing");
+    this->AdjustSylSpacingByVerse(prepareProcessingListsParams, doc, filters);
+    Profiler::End();
 
     // Adjust measure X position
     AlignMeasuresParams alignMeasuresParams;
     Functor alignMeasures(&Object::AlignMeasures);
     Functor alignMeasuresEnd(&Object::AlignMeasuresEnd);
+    Profiler::Start("AlignMeasures");
     this->Process(&alignMeasures, &alignMeasuresParams, &alignMeasuresEnd);
+    Profiler::End();
 }
 
 void Page::LayOutVertically()
 {
+    ProfilerScope profilerScope("LayOutVertically");
+
     Doc *doc = dynamic_cast<Doc *>(GetParent());
     assert(doc);
 
@@ -283,11 +394,15 @@ void Page::LayOutVertically()
 
     // Reset the vertical alignment
     Functor resetVerticalAlignment(&Object::ResetVerticalAlignment);
+    Profiler::Start("ResetVerticalAlignment");
     this->Process(&resetVerticalAlignment, NULL);
+    Profiler::End();
 
     FunctorDocParams calcLegerLinesParams(doc);
     Functor calcLedgerLines(&Object::CalcLedgerLines);
+    Profiler::Start("CalcLedgerLines");
     this->Process(&calcLedgerLines, &calcLegerLinesParams);
+    Profiler::End();
 
     // Align the content of the page using system aligners
     // After this:
@@ -295,54 +410,72 @@ void Page::LayOutVertically()
     Functor alignVertically(&Object::AlignVertically);
     Functor alignVerticallyEnd(&Object::AlignVerticallyEnd);
     AlignVerticallyParams alignVerticallyParams(doc, &alignVerticallyEnd);
+    Profiler::Start("AlignVertically");
     this->Process(&alignVertically, &alignVerticallyParams, &alignVerticallyEnd);
+    Profiler::End();
 
     // Adjust the position of outside articulations
     FunctorDocParams calcArticParams(doc);
     Functor calcArtic(&Object::CalcArtic);
+    Profiler::Start("CalcArtic");
     this->Process(&calcArtic, &calcArticParams);
+    Profiler::End();
 
     // Render it for filling the bounding box
     View view;
     BBoxDeviceContext bBoxDC(&view, 0, 0);
     view.SetDoc(doc);
     // Do not do the layout in this view - otherwise we will loop...
+    Profiler::Start("BBoxRender");
     view.SetPage(this->GetIdx(), false);
     view.DrawCurrentPage(&bBoxDC, false);
+    Profiler::End();
 
     // Adjust the position of outside articulations with slurs end and start positions
     FunctorDocParams adjustArticWithSlursParams(doc);
     Functor adjustArticWithSlurs(&Object::AdjustArticWithSlurs);
+    Profiler::Start("AdjustArticWithSlurs");
     this->Process(&adjustArticWithSlurs, &adjustArticWithSlursParams);
+    Profiler::End();
 
     // Fill the arrays of bounding boxes (above and below) for each staff alignment for which the box overflows.
     SetOverflowBBoxesParams setOverflowBBoxesParams(doc);
     Functor setOverflowBBoxes(&Object::SetOverflowBBoxes);
     Functor setOverflowBBoxesEnd(&Object::SetOverflowBBoxesEnd);
+    Profiler::Start("SetOverflowBBoxes");
     this->Process(&setOverflowBBoxes, &setOverflowBBoxesParams, &setOverflowBBoxesEnd);
+    Profiler::End();
 
     // Adjust the positioners of floationg elements (slurs, hairpin, dynam, etc)
     Functor adjustFloatingPostioners(&Object::AdjustFloatingPostioners);
     AdjustFloatingPostionersParams adjustFloatingPostionersParams(doc, &adjustFloatingPostioners);
+    Profiler::Start("AdjustFloatingPostioners");
     this->Process(&adjustFloatingPostioners, &adjustFloatingPostionersParams);
+    Profiler::End();
 
     // Adjust the overlap of the staff aligmnents by looking at the overflow bounding boxes params.clear();
     Functor adjustStaffOverlap(&Object::AdjustStaffOverlap);
     AdjustStaffOverlapParams adjustStaffOverlapParams(&adjustStaffOverlap);
+    Profiler::Start("AdjustStaffOverlap");
     this->Process(&adjustStaffOverlap, &adjustStaffOverlapParams);
+    Profiler::End();
 
     // Set the Y position of each StaffAlignment
     // Adjust the Y shift to make sure there is a minimal space (staffMargin) between each staff
     Functor adjustYPos(&Object::AdjustYPos);
     AdjustYPosParams adjustYPosParams(doc, &adjustYPos);
+    Profiler::Start("AdjustYPos");
     this->Process(&adjustYPos, &adjustYPosParams);
+    Profiler::End();
 
     // Adjust system Y position
     AlignSystemsParams alignSystemsParams;
     alignSystemsParams.m_shift = doc->m_drawingPageHeight - doc->m_drawingPageTopMar;
     alignSystemsParams.m_systemMargin = (doc->GetSpacingSystem()) * doc->GetDrawingUnit(100);
     Functor alignSystems(&Object::AlignSystems);
+    Profiler::Start("AlignSystems");
     this->Process(&alignSystems, &alignSystemsParams);
+    Profiler::End();
 }
 
 void Page::JustifyHorizontally()
@@ -362,7 +495,9 @@ void Page::JustifyHorizontally()
     Functor justifyX(&Object::JustifyX);
     JustifyXParams justifyXParams(&justifyX);
     justifyXParams.m_systemFullWidth = doc->m_drawingPageWidth - doc->m_drawingPageLeftMar - doc->m_drawingPageRightMar;
+    Profiler::Start("JustifyHorizontally");
     this->Process(&justifyX, &justifyXParams);
+    Profiler::End();
 }
 
 void Page::LayOutPitchPos()
@@ -419,7 +554,8 @@ int Page::GetContentWidth() const
     return first->m_drawingTotalWidth + first->m_systemLeftMar + first->m_systemRightMar;
 }
 
-void Page::AdjustSylSpacingByVerse(PrepareProcessingListsParams &listsParams, Doc *doc)
+void Page::AdjustSylSpacingByVerse(
+    PrepareProcessingListsParams &listsParams, Doc *doc, ArrayOfAttComparisons *measureFilters)
 {
     IntTree_t::iterator staves;
     IntTree_t::iterator layers;
@@ -438,6 +574,7 @@ void Page::AdjustSylSpacingByVerse(PrepareProcessingListsParams &listsParams, Do
                 AttCommonNComparison matchLayer(LAYER, layers->first);
                 AttCommonNComparison matchVerse(VERSE, verses->first);
                 filters = { &matchStaff, &matchLayer, &matchVerse };
+                if (measureFilters) filters.insert(filters.end(), measureFilters->begin(), measureFilters->end());
 
                 // The first pass sets m_drawingFirstNote and m_drawingLastNote for each syl
                 // m_drawingLastNote is set only if the syl has a forward connector
@@ -461,7 +598,7 @@ void Page::UpgradePageBasedMEI(Doc *doc)
 
 int Page::ApplyPPUFactor(FunctorParams *functorParams)
 {
-    ApplyPPUFactorParams *params = dynamic_cast<ApplyPPUFactorParams *>(functorParams);
+    ApplyPPUFactorParams *params = static_cast<ApplyPPUFactorParams *>(functorParams);
     assert(params);
 
     params->m_page = this;
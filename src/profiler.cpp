@@ -0,0 +1,183 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        profiler.cpp
+// Author:      Verovio contributors
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "profiler.h"
+
+//----------------------------------------------------------------------------
+
+#include <assert.h>
+
+//----------------------------------------------------------------------------
+
+#include "vrv.h"
+
+namespace vrv {
+
+//----------------------------------------------------------------------------
+// ProfilerPhase
+//----------------------------------------------------------------------------
+
+ProfilerPhase::ProfilerPhase(const std::string &name, ProfilerPhase *parent)
+{
+    m_name = name;
+    m_parent = parent;
+    m_calls = 0;
+    m_time = 0.0;
+    m_nodes = 0;
+}
+
+ProfilerPhase::~ProfilerPhase()
+{
+    std::vector<ProfilerPhase *>::iterator iter;
+    for (iter = m_children.begin(); iter != m_children.end(); ++iter) {
+        delete *iter;
+    }
+}
+
+ProfilerPhase *ProfilerPhase::GetChild(const std::string &name)
+{
+    std::vector<ProfilerPhase *>::iterator iter;
+    for (iter = m_children.begin(); iter != m_children.end(); ++iter) {
+        if ((*iter)->m_name == name) return *iter;
+    }
+    ProfilerPhase *child = new ProfilerPhase(name, this);
+    m_children.push_back(child);
+    return child;
+}
+
+long ProfilerPhase::GetTotalNodes() const
+{
+    long nodes = m_nodes;
+    std::vector<ProfilerPhase *>::const_iterator iter;
+    for (iter = m_children.begin(); iter != m_children.end(); ++iter) {
+        nodes += (*iter)->GetTotalNodes();
+    }
+    return nodes;
+}
+
+double ProfilerPhase::GetTimeOf(const std::string &name) const
+{
+    double time = 0.0;
+    std::vector<ProfilerPhase *>::const_iterator iter;
+    for (iter = m_children.begin(); iter != m_children.end(); ++iter) {
+        if ((*iter)->m_name == name)
+            time += (*iter)->m_time;
+        else
+            time += (*iter)->GetTimeOf(name);
+    }
+    return time;
+}
+
+long ProfilerPhase::GetNodesOf(const std::string &name) const
+{
+    long nodes = 0;
+    std::vector<ProfilerPhase *>::const_iterator iter;
+    for (iter = m_children.begin(); iter != m_children.end(); ++iter) {
+        if ((*iter)->m_name == name)
+            nodes += (*iter)->GetTotalNodes();
+        else
+            nodes += (*iter)->GetNodesOf(name);
+    }
+    return nodes;
+}
+
+void ProfilerPhase::WriteJSON(std::string &output, int indent) const
+{
+    std::string pad(indent, ' ');
+    output += pad + "{\n";
+    output += pad + StringFormat("    \"name\": \"%s\",\n", m_name.c_str());
+    output += pad + StringFormat("    \"calls\": %d,\n", m_calls);
+    output += pad + StringFormat("    \"time\": %.3f,\n", m_time * 1000.0);
+    output += pad + StringFormat("    \"nodes\": %ld", this->GetTotalNodes());
+    if (!m_children.empty()) {
+        output += ",\n" + pad + "    \"phases\": [\n";
+        std::vector<ProfilerPhase *>::const_iterator iter;
+        for (iter = m_children.begin(); iter != m_children.end(); ++iter) {
+            if (iter != m_children.begin()) output += ",\n";
+            (*iter)->WriteJSON(output, indent + 8);
+        }
+        output += "\n" + pad + "    ]";
+    }
+    output += "\n" + pad + "}";
+}
+
+//----------------------------------------------------------------------------
+// Profiler
+//----------------------------------------------------------------------------
+
+thread_local Profiler *Profiler::s_current = NULL;
+
+Profiler::Profiler() : m_root("root", NULL)
+{
+    m_enabled = false;
+    m_currentPhase = &m_root;
+}
+
+Profiler::~Profiler()
+{
+    // Do not leave a dangling profiler bound to the thread
+    if (s_current == this) s_current = NULL;
+}
+
+void Profiler::Enable(bool enable)
+{
+    this->Reset();
+    m_enabled = enable;
+}
+
+void Profiler::Reset()
+{
+    std::vector<ProfilerPhase *>::iterator iter;
+    for (iter = m_root.m_children.begin(); iter != m_root.m_children.end(); ++iter) {
+        delete *iter;
+    }
+    m_root.m_children.clear();
+    m_root.m_nodes = 0;
+    m_currentPhase = &m_root;
+}
+
+Profiler *Profiler::SetCurrent(Profiler *profiler)
+{
+    Profiler *previous = s_current;
+    s_current = profiler;
+    return previous;
+}
+
+void Profiler::StartPhase(const char *name)
+{
+    assert(m_currentPhase);
+
+    m_currentPhase = m_currentPhase->GetChild(name);
+    m_currentPhase->m_calls++;
+    m_currentPhase->m_start = std::chrono::steady_clock::now();
+}
+
+void Profiler::EndPhase()
+{
+    assert(m_currentPhase);
+
+    // Unbalanced call, for example when the profiler was enabled within a phase
+    if (m_currentPhase == &m_root) return;
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_currentPhase->m_start;
+    m_currentPhase->m_time += elapsed.count();
+    m_currentPhase = m_currentPhase->m_parent;
+}
+
+std::string Profiler::GetJSON() const
+{
+    std::string output = "{\n    \"phases\": [\n";
+    std::vector<ProfilerPhase *>::const_iterator iter;
+    for (iter = m_root.m_children.begin(); iter != m_root.m_children.end(); ++iter) {
+        if (iter != m_root.m_children.begin()) output += ",\n";
+        (*iter)->WriteJSON(output, 8);
+    }
+    output += "\n    ]\n}\n";
+    return output;
+}
+
+} // namespace vrv
@@ -152,7 +152,7 @@ int Rest::PrepareLayerElementParts(FunctorParams *functorParams)
 
 int Rest::CalcDots(FunctorParams *functorParams)
 {
-    CalcDotsParams *params = dynamic_cast<CalcDotsParams *>(functorParams);
+    CalcDotsParams *params = static_cast<CalcDotsParams *>(functorParams);
     assert(params);
 
     // We currently have no dots object with mensural rests
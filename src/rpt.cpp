@@ -291,7 +291,7 @@ void MultiRpt::Reset()
 
 int MRpt::PrepareRpt(FunctorParams *functorParams)
 {
-    PrepareRptParams *params = dynamic_cast<PrepareRptParams *>(functorParams);
+    PrepareRptParams *params = static_cast<PrepareRptParams *>(functorParams);
     assert(params);
 
     // If multiNumber is not true, nothing needs to be done
@@ -313,7 +313,7 @@ int MRpt::PrepareRpt(FunctorParams *functorParams)
 
 int FTrem::CalcStem(FunctorParams *functorParams)
 {
-    CalcStemParams *params = dynamic_cast<CalcStemParams *>(functorParams);
+    CalcStemParams *params = static_cast<CalcStemParams *>(functorParams);
     assert(params);
 
     ListOfObjects *fTremChildren = this->GetList(this);
@@ -319,11 +319,27 @@ void ScoreDef::FilterList(ListOfObjects *childList)
             iter++;
         }
     }
+
+    // Index them by @n for GetStaffDef - insert does not replace an existing value, so the first one is kept
+    m_staffDefIndex.clear();
+    for (iter = childList->begin(); iter != childList->end(); ++iter) {
+        StaffDef *staffDef = dynamic_cast<StaffDef *>(*iter);
+        assert(staffDef);
+        m_staffDefIndex.insert(std::make_pair(staffDef->GetN(), staffDef));
+    }
 }
 
 StaffDef *ScoreDef::GetStaffDef(int n)
 {
     this->ResetList(this);
+
+    // The @n of a staffDef can be changed without modifying the scoreDef, so check it before returning it
+    std::map<int, StaffDef *>::iterator found = m_staffDefIndex.find(n);
+    if ((found != m_staffDefIndex.end()) && (found->second->GetN() == n)) {
+        return found->second;
+    }
+
+    // Otherwise look through the list
     ListOfObjects *childList = this->GetList(this);
     ListOfObjects::iterator iter;
 
@@ -502,7 +518,7 @@ void StaffDef::Reset()
 
 int ScoreDef::ConvertToPageBased(FunctorParams *functorParams)
 {
-    ConvertToPageBasedParams *params = dynamic_cast<ConvertToPageBasedParams *>(functorParams);
+    ConvertToPageBasedParams *params = static_cast<ConvertToPageBasedParams *>(functorParams);
     assert(params);
 
     // Move itself to the pageBasedSystem - do not process children
@@ -513,7 +529,7 @@ int ScoreDef::ConvertToPageBased(FunctorParams *functorParams)
 
 int ScoreDef::CastOffSystems(FunctorParams *functorParams)
 {
-    CastOffSystemsParams *params = dynamic_cast<CastOffSystemsParams *>(functorParams);
+    CastOffSystemsParams *params = static_cast<CastOffSystemsParams *>(functorParams);
     assert(params);
 
     // Since the functor returns FUNCTOR_SIBLINGS we should never go lower than the system children
@@ -537,7 +553,7 @@ int ScoreDef::CastOffSystems(FunctorParams *functorParams)
 
 int ScoreDef::CastOffEncoding(FunctorParams *functorParams)
 {
-    CastOffEncodingParams *params = dynamic_cast<CastOffEncodingParams *>(functorParams);
+    CastOffEncodingParams *params = static_cast<CastOffEncodingParams *>(functorParams);
     assert(params);
 
     MoveItselfTo(params->m_currentSystem);
@@ -551,7 +567,7 @@ int ScoreDef::CastOffEncoding(FunctorParams *functorParams)
 
 int StaffDef::ReplaceDrawingValuesInStaffDef(FunctorParams *functorParams)
 {
-    ReplaceDrawingValuesInStaffDefParams *params = dynamic_cast<ReplaceDrawingValuesInStaffDefParams *>(functorParams);
+    ReplaceDrawingValuesInStaffDefParams *params = static_cast<ReplaceDrawingValuesInStaffDefParams *>(functorParams);
     assert(params);
 
     if (params->m_clef) {
@@ -572,7 +588,7 @@ int StaffDef::ReplaceDrawingValuesInStaffDef(FunctorParams *functorParams)
 
 int StaffDef::SetStaffDefRedrawFlags(FunctorParams *functorParams)
 {
-    SetStaffDefRedrawFlagsParams *params = dynamic_cast<SetStaffDefRedrawFlagsParams *>(functorParams);
+    SetStaffDefRedrawFlagsParams *params = static_cast<SetStaffDefRedrawFlagsParams *>(functorParams);
     assert(params);
 
     if (params->m_clef || params->m_applyToAll) {
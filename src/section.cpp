@@ -120,7 +120,7 @@ void Sb::Reset()
 
 int Section::ConvertToPageBased(FunctorParams *functorParams)
 {
-    ConvertToPageBasedParams *params = dynamic_cast<ConvertToPageBasedParams *>(functorParams);
+    ConvertToPageBasedParams *params = static_cast<ConvertToPageBasedParams *>(functorParams);
     assert(params);
 
     this->MoveItselfTo(params->m_pageBasedSystem);
@@ -130,7 +130,7 @@ int Section::ConvertToPageBased(FunctorParams *functorParams)
 
 int Section::ConvertToPageBasedEnd(FunctorParams *functorParams)
 {
-    ConvertToPageBasedParams *params = dynamic_cast<ConvertToPageBasedParams *>(functorParams);
+    ConvertToPageBasedParams *params = static_cast<ConvertToPageBasedParams *>(functorParams);
     assert(params);
 
     ConvertToPageBasedBoundary(this, params->m_pageBasedSystem);
@@ -164,7 +164,7 @@ int Section::ResetDrawing(FunctorParams *functorParams)
 
 int Pb::CastOffEncoding(FunctorParams *functorParams)
 {
-    CastOffEncodingParams *params = dynamic_cast<CastOffEncodingParams *>(functorParams);
+    CastOffEncodingParams *params = static_cast<CastOffEncodingParams *>(functorParams);
     assert(params);
 
     if (!params->m_firstPbProcessed) {
@@ -188,7 +188,7 @@ int Pb::CastOffEncoding(FunctorParams *functorParams)
 
 int Sb::CastOffEncoding(FunctorParams *functorParams)
 {
-    CastOffEncodingParams *params = dynamic_cast<CastOffEncodingParams *>(functorParams);
+    CastOffEncodingParams *params = static_cast<CastOffEncodingParams *>(functorParams);
     assert(params);
 
     params->m_currentSystem = new System();
@@ -243,7 +243,7 @@ int Staff::ResetVerticalAlignment(FunctorParams *functorParams)
 
 int Staff::ApplyPPUFactor(FunctorParams *functorParams)
 {
-    ApplyPPUFactorParams *params = dynamic_cast<ApplyPPUFactorParams *>(functorParams);
+    ApplyPPUFactorParams *params = static_cast<ApplyPPUFactorParams *>(functorParams);
     assert(params);
 
     if (m_yAbs != VRV_UNSET) m_yAbs /= params->m_page->GetPPUFactor();
@@ -253,7 +253,7 @@ int Staff::ApplyPPUFactor(FunctorParams *functorParams)
 
 int Staff::AlignVertically(FunctorParams *functorParams)
 {
-    AlignVerticallyParams *params = dynamic_cast<AlignVerticallyParams *>(functorParams);
+    AlignVerticallyParams *params = static_cast<AlignVerticallyParams *>(functorParams);
     assert(params);
 
     params->m_staffN = this->GetN();
@@ -282,7 +282,7 @@ int Staff::AlignVertically(FunctorParams *functorParams)
 
 int Staff::FillStaffCurrentTimeSpanning(FunctorParams *functorParams)
 {
-    FillStaffCurrentTimeSpanningParams *params = dynamic_cast<FillStaffCurrentTimeSpanningParams *>(functorParams);
+    FillStaffCurrentTimeSpanningParams *params = static_cast<FillStaffCurrentTimeSpanningParams *>(functorParams);
     assert(params);
 
     std::vector<Object *>::iterator iter = params->m_timeSpanningElements.begin();
@@ -310,7 +310,7 @@ int Staff::ResetDrawing(FunctorParams *functorParams)
 
 int Staff::PrepareRpt(FunctorParams *functorParams)
 {
-    PrepareRptParams *params = dynamic_cast<PrepareRptParams *>(functorParams);
+    PrepareRptParams *params = static_cast<PrepareRptParams *>(functorParams);
     assert(params);
 
     // If multiNumber is set, we already know that nothing needs to be done
@@ -46,6 +46,7 @@ SvgDeviceContext::SvgDeviceContext(int width, int height) : DeviceContext()
 {
     m_width = width;
     m_height = height;
+    m_viewBoxX = 0;
 
     m_userScaleX = 1.0;
     m_userScaleY = 1.0;
@@ -354,8 +355,9 @@ void SvgDeviceContext::StartPage()
     m_currentNode = m_currentNode.append_child("svg");
     m_svgNodeStack.push_back(m_currentNode);
     m_currentNode.append_attribute("class") = "definition-scale";
-    m_currentNode.append_attribute("viewBox")
-        = StringFormat("0 0 %d %d", m_width * DEFINITION_FACTOR, m_height * DEFINITION_FACTOR).c_str();
+    std::string viewBox = StringFormat(
+        "%d 0 %d %d", m_viewBoxX * DEFINITION_FACTOR, m_width * DEFINITION_FACTOR, m_height * DEFINITION_FACTOR);
+    m_currentNode.append_attribute("viewBox") = viewBox.c_str();
 
     // a graphic for the origin
     m_currentNode = m_currentNode.append_child("g");
@@ -77,7 +77,7 @@ void Syl::AddChild(Object *child)
 
 int Syl::PrepareLyrics(FunctorParams *functorParams)
 {
-    PrepareLyricsParams *params = dynamic_cast<PrepareLyricsParams *>(functorParams);
+    PrepareLyricsParams *params = static_cast<PrepareLyricsParams *>(functorParams);
     assert(params);
 
     Verse *verse = dynamic_cast<Verse *>(this->GetFirstParent(VERSE, MAX_NOTE_DEPTH));
@@ -128,7 +128,7 @@ int Syl::FillStaffCurrentTimeSpanning(FunctorParams *functorParams)
 
 int Syl::AdjustSylSpacing(FunctorParams *functorParams)
 {
-    AdjustSylSpacingParams *params = dynamic_cast<AdjustSylSpacingParams *>(functorParams);
+    AdjustSylSpacingParams *params = static_cast<AdjustSylSpacingParams *>(functorParams);
     assert(params);
 
     if (!this->HasUpdatedHorizontalBB()) {
@@ -115,7 +115,15 @@ int System::GetDrawingY() const
 
 void System::SetDrawingXRel(int drawingXRel)
 {
-    ResetCachedDrawingX();
+    // Moving the measures invalidates the cached drawing X of their content
+    ArrayOfObjects::iterator iter;
+    for (iter = m_children.begin(); iter != m_children.end(); ++iter) {
+        if ((*iter)->Is(MEASURE)) {
+            Measure *measure = dynamic_cast<Measure *>(*iter);
+            assert(measure);
+            measure->m_measureAligner.IncrementDrawingXGeneration();
+        }
+    }
     m_drawingXRel = drawingXRel;
 }
 
@@ -200,7 +208,7 @@ int System::ResetVerticalAlignment(FunctorParams *functorParams)
 
 int System::ApplyPPUFactor(FunctorParams *functorParams)
 {
-    ApplyPPUFactorParams *params = dynamic_cast<ApplyPPUFactorParams *>(functorParams);
+    ApplyPPUFactorParams *params = static_cast<ApplyPPUFactorParams *>(functorParams);
     assert(params);
 
     if (m_xAbs != VRV_UNSET) m_xAbs /= params->m_page->GetPPUFactor();
@@ -213,7 +221,7 @@ int System::ApplyPPUFactor(FunctorParams *functorParams)
 
 int System::AlignHorizontally(FunctorParams *functorParams)
 {
-    AlignHorizontallyParams *params = dynamic_cast<AlignHorizontallyParams *>(functorParams);
+    AlignHorizontallyParams *params = static_cast<AlignHorizontallyParams *>(functorParams);
     assert(params);
 
     // since we are starting a new system its first scoreDef will need to be a SYSTEM_SCOREDEF
@@ -224,7 +232,7 @@ int System::AlignHorizontally(FunctorParams *functorParams)
 
 int System::AlignVertically(FunctorParams *functorParams)
 {
-    AlignVerticallyParams *params = dynamic_cast<AlignVerticallyParams *>(functorParams);
+    AlignVerticallyParams *params = static_cast<AlignVerticallyParams *>(functorParams);
     assert(params);
 
     params->m_systemAligner = &m_systemAligner;
@@ -234,7 +242,7 @@ int System::AlignVertically(FunctorParams *functorParams)
 
 int System::AlignVerticallyEnd(FunctorParams *functorParams)
 {
-    AlignVerticallyParams *params = dynamic_cast<AlignVerticallyParams *>(functorParams);
+    AlignVerticallyParams *params = static_cast<AlignVerticallyParams *>(functorParams);
     assert(params);
 
     params->m_cumulatedShift = params->m_doc->GetSpacingStaff() * params->m_doc->GetDrawingUnit(100);
@@ -246,7 +254,7 @@ int System::AlignVerticallyEnd(FunctorParams *functorParams)
 
 int System::AdjustYPos(FunctorParams *functorParams)
 {
-    AdjustYPosParams *params = dynamic_cast<AdjustYPosParams *>(functorParams);
+    AdjustYPosParams *params = static_cast<AdjustYPosParams *>(functorParams);
     assert(params);
 
     params->m_previousOverflowBelow = 0;
@@ -260,7 +268,7 @@ int System::AdjustYPos(FunctorParams *functorParams)
 
 int System::AlignMeasures(FunctorParams *functorParams)
 {
-    AlignMeasuresParams *params = dynamic_cast<AlignMeasuresParams *>(functorParams);
+    AlignMeasuresParams *params = static_cast<AlignMeasuresParams *>(functorParams);
     assert(params);
 
     SetDrawingXRel(this->m_systemLeftMar + this->GetDrawingLabelsWidth());
@@ -272,7 +280,7 @@ int System::AlignMeasures(FunctorParams *functorParams)
 
 int System::AlignMeasuresEnd(FunctorParams *functorParams)
 {
-    AlignMeasuresParams *params = dynamic_cast<AlignMeasuresParams *>(functorParams);
+    AlignMeasuresParams *params = static_cast<AlignMeasuresParams *>(functorParams);
     assert(params);
 
     m_drawingTotalWidth = params->m_shift + this->GetDrawingLabelsWidth();
@@ -283,7 +291,7 @@ int System::AlignMeasuresEnd(FunctorParams *functorParams)
 
 int System::AlignSystems(FunctorParams *functorParams)
 {
-    AlignSystemsParams *params = dynamic_cast<AlignSystemsParams *>(functorParams);
+    AlignSystemsParams *params = static_cast<AlignSystemsParams *>(functorParams);
     assert(params);
 
     SetDrawingYRel(params->m_shift);
@@ -297,7 +305,7 @@ int System::AlignSystems(FunctorParams *functorParams)
 
 int System::JustifyX(FunctorParams *functorParams)
 {
-    JustifyXParams *params = dynamic_cast<JustifyXParams *>(functorParams);
+    JustifyXParams *params = static_cast<JustifyXParams *>(functorParams);
     assert(params);
 
     assert(GetParent());
@@ -332,7 +340,7 @@ int System::JustifyX(FunctorParams *functorParams)
 
 int System::AdjustStaffOverlap(FunctorParams *functorParams)
 {
-    AdjustStaffOverlapParams *params = dynamic_cast<AdjustStaffOverlapParams *>(functorParams);
+    AdjustStaffOverlapParams *params = static_cast<AdjustStaffOverlapParams *>(functorParams);
     assert(params);
 
     params->m_previous = NULL;
@@ -343,7 +351,7 @@ int System::AdjustStaffOverlap(FunctorParams *functorParams)
 
 int System::AdjustFloatingPostioners(FunctorParams *functorParams)
 {
-    AdjustFloatingPostionersParams *params = dynamic_cast<AdjustFloatingPostionersParams *>(functorParams);
+    AdjustFloatingPostionersParams *params = static_cast<AdjustFloatingPostionersParams *>(functorParams);
     assert(params);
 
     AdjustFloatingPostionerGrpsParams adjustFloatingPostionerGrpsParams(params->m_doc);
@@ -395,7 +403,7 @@ int System::AdjustFloatingPostioners(FunctorParams *functorParams)
 
 int System::CastOffPages(FunctorParams *functorParams)
 {
-    CastOffPagesParams *params = dynamic_cast<CastOffPagesParams *>(functorParams);
+    CastOffPagesParams *params = static_cast<CastOffPagesParams *>(functorParams);
     assert(params);
 
     if ((params->m_currentPage->GetChildCount() > 0)
@@ -418,7 +426,7 @@ int System::CastOffPages(FunctorParams *functorParams)
 
 int System::UnCastOff(FunctorParams *functorParams)
 {
-    UnCastOffParams *params = dynamic_cast<UnCastOffParams *>(functorParams);
+    UnCastOffParams *params = static_cast<UnCastOffParams *>(functorParams);
     assert(params);
 
     // Just move all the content of the system to the continous one (parameter)
@@ -431,7 +439,7 @@ int System::UnCastOff(FunctorParams *functorParams)
 
 int System::CastOffSystemsEnd(FunctorParams *functorParams)
 {
-    CastOffSystemsParams *params = dynamic_cast<CastOffSystemsParams *>(functorParams);
+    CastOffSystemsParams *params = static_cast<CastOffSystemsParams *>(functorParams);
     assert(params);
 
     if (params->m_pendingObjects.empty()) return FUNCTOR_STOP;
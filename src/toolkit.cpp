@@ -9,7 +9,21 @@
 
 //----------------------------------------------------------------------------
 
+#include <algorithm>
 #include <assert.h>
+#include <climits>
+#include <cstdio>
+#include <iterator>
+#include <sstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <process.h>
+#endif
 
 //----------------------------------------------------------------------------
 
@@ -43,8 +57,6 @@ const char *UTF_16_LE_BOM = "\xFF\xFE";
 // Toolkit
 //----------------------------------------------------------------------------
 
-char *Toolkit::m_humdrumBuffer = NULL;
-
 Toolkit::Toolkit(bool initFont)
 {
     m_scale = DEFAULT_SCALE;
@@ -64,33 +76,28 @@ Toolkit::Toolkit(bool initFont)
     m_adjustPageHeight = false;
     m_noJustification = false;
     m_evenNoteSpacing = false;
+    m_reuseLayout = false;
     m_showBoundingBoxes = false;
     m_scoreBasedMei = false;
+    m_measureRangeFirst = VRV_UNSET;
+    m_measureRangeLast = VRV_UNSET;
 
-    m_cString = NULL;
-    m_humdrumBuffer = NULL;
+    m_editBatch = false;
+    m_editPrepareDrawing = false;
+    m_editSnapshotPageIdx = VRV_UNSET;
+    m_editInfo = "{}";
 
     if (initFont) {
         Resources::InitFonts();
     }
 }
 
-Toolkit::~Toolkit()
-{
-    if (m_cString) {
-        free(m_cString);
-        m_cString = NULL;
-    }
-    if (m_humdrumBuffer) {
-        free(m_humdrumBuffer);
-        m_humdrumBuffer = NULL;
-    }
-}
+Toolkit::~Toolkit() {}
 
 bool Toolkit::SetResourcePath(const std::string &path)
 {
-    Resources::SetPath(path);
-    return Resources::InitFonts();
+    m_resources.m_path = path;
+    return Resources::InitFonts(&m_resources);
 };
 
 bool Toolkit::SetBorder(int border)
@@ -246,6 +253,66 @@ void Toolkit::SetChoiceXPathQueries(std::vector<std::string> const &xPathQueries
         m_choiceXPathQueries.end());
 }
 
+bool Toolkit::SetMeasureRange(std::string const &range)
+{
+    // An empty string resets the range
+    if (range.empty()) {
+        m_measureRangeFirst = VRV_UNSET;
+        m_measureRangeLast = VRV_UNSET;
+        return true;
+    }
+    // Only 'N' or 'N-M' with digits only is accepted
+    const char *start = range.c_str();
+    char *end = NULL;
+    long first = (isdigit(*start)) ? strtol(start, &end, 10) : 0;
+    long last = first;
+    if (end && (*end == '-')) {
+        start = end + 1;
+        last = (isdigit(*start)) ? strtol(start, &end, 10) : 0;
+    }
+    if (!end || (*end != '\0') || (first < 1) || (last < first) || (last > INT_MAX)) {
+        LogError("Measure range '%s' is invalid; it must be 'N1-N2' or 'N' with 0 < N1 <= N2", range.c_str());
+        return false;
+    }
+    m_measureRangeFirst = (int)first;
+    m_measureRangeLast = (int)last;
+    return true;
+}
+
+std::string Toolkit::GetMeasureRange()
+{
+    if (m_measureRangeFirst == VRV_UNSET) return "";
+    return StringFormat("%d-%d", m_measureRangeFirst, m_measureRangeLast);
+}
+
+bool Toolkit::SetStaffSelection(std::string const &staves)
+{
+    std::vector<int> staffNs;
+    std::istringstream iss(staves);
+    std::string token;
+    while (std::getline(iss, token, ',')) {
+        char *end = NULL;
+        long n = strtol(token.c_str(), &end, 10);
+        if (token.empty() || (*end != '\0') || (n < 1)) {
+            LogError("Staff selection '%s' is invalid; it must be a comma-separated list of staff @n", staves.c_str());
+            return false;
+        }
+        staffNs.push_back((int)n);
+    }
+    m_staffSelection = staffNs;
+    return true;
+}
+
+std::string Toolkit::GetStaffSelection()
+{
+    std::string staves;
+    for (auto n : m_staffSelection) {
+        if (!staves.empty()) staves += ",";
+        staves += StringFormat("%d", n);
+    }
+    return staves;
+}
+
 FileFormat Toolkit::IdentifyInputFormat(const string &data)
 {
 #ifdef MUSICXML_DEFAULT_HUMDRUM
@@ -328,7 +395,9 @@ FileFormat Toolkit::IdentifyInputFormat(const string &data)
 
 bool Toolkit::SetFont(std::string const &font)
 {
-    return Resources::SetFont(font);
+    // The horizontal layout and the text extends (which fall back on the glyphs) are redone since the font
+    // generation changes
+    return Resources::SetFont(&m_resources, font);
 };
 
 bool Toolkit::LoadFile(const std::string &filename)
@@ -337,7 +406,32 @@ bool Toolkit::LoadFile(const std::string &filename)
         return LoadUTF16File(filename);
     }
 
-    std::ifstream in(filename.c_str());
+#ifndef _WIN32
+    // Map the file in memory instead of reading it into a string. The mapping is private, so the data can be parsed
+    // in place without modifying the file, and only the pages written by the parser are copied.
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return false;
+    }
+
+    struct stat fileStat;
+    if ((fstat(fd, &fileStat) == -1) || (fileStat.st_size == 0)) {
+        close(fd);
+        return false;
+    }
+    size_t fileSize = (size_t)fileStat.st_size;
+
+    void *content = mmap(NULL, fileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (content == MAP_FAILED) {
+        return false;
+    }
+
+    bool success = LoadData((char *)content, fileSize);
+    munmap(content, fileSize);
+    return success;
+#else
+    std::ifstream in(filename.c_str(), std::ios::in | std::ios::binary);
     if (!in.is_open()) {
         return false;
     }
@@ -346,12 +440,16 @@ bool Toolkit::LoadFile(const std::string &filename)
     std::streamsize fileSize = (std::streamsize)in.tellg();
     in.clear();
     in.seekg(0, std::ios::beg);
+    if (fileSize <= 0) {
+        return false;
+    }
 
-    // read the file into the string:
+    // read the file into the string and parse it in place
     std::string content(fileSize, 0);
     in.read(&content[0], fileSize);
 
-    return LoadData(content);
+    return LoadData(&content[0], content.size());
+#endif
 }
 
 bool Toolkit::IsUTF16(const std::string &filename)
@@ -406,6 +504,16 @@ bool Toolkit::LoadUTF16File(const std::string &filename)
 
 bool Toolkit::LoadData(const std::string &data)
 {
+    ResourcesScope resourcesScope(&m_resources);
+    ProfilerScope profilerScope(&m_profiler, "LoadData");
+
+    // The Humdrum output does not need the layout and is not cached
+    std::string snapshotKey;
+    if (!m_layoutCache.empty() && !m_noLayout && !m_reuseLayout && (GetOutputFormat() != HUMDRUM)) {
+        snapshotKey = this->GetSnapshotKey(data.c_str(), data.size());
+        if (this->LoadSnapshot(snapshotKey)) return true;
+    }
+
     string newData;
     FileInputStream *input = NULL;
 
@@ -432,21 +540,30 @@ bool Toolkit::LoadData(const std::string &data)
             tempinput->SetOutputFormat("humdrum");
         }
 
+        Profiler::Start("ImportHumdrum");
         if (!tempinput->ImportString(data)) {
+            Profiler::End();
             LogError("Error importing Humdrum data");
             delete tempinput;
             return false;
         }
+        Profiler::End();
 
-        SetHumdrumBuffer(tempinput->GetHumdrumString().c_str());
+        // The filters have already been applied by the input and the data does not need to be parsed again
+        Profiler::Start("SetHumdrumBuffer");
+        m_humdrumBuffer = tempinput->GetHumdrumString();
+        Profiler::End();
 
         if (GetOutputFormat() == HUMDRUM) {
+            delete tempinput;
             return true;
         }
 
+        Profiler::Start("ExportMei");
         MeiOutput meioutput(&tempdoc, "");
         meioutput.SetScoreBasedMEI(true);
         newData = meioutput.GetOutput();
+        Profiler::End();
         delete tempinput;
 
         input = new MeiInput(&m_doc, "");
@@ -463,29 +580,38 @@ bool Toolkit::LoadData(const std::string &data)
     else if (inputFormat == MUSICXMLHUM) {
         // This is the indirect converter from MusicXML to MEI using iohumdrum:
         hum::Tool_musicxml2hum converter;
+        Profiler::Start("ConvertMusicXmlToHumdrum");
         pugi::xml_document xmlfile;
         xmlfile.load(data.c_str());
         stringstream conversion;
         bool status = converter.convert(conversion, xmlfile);
+        Profiler::End();
         if (!status) {
             LogError("Error converting MusicXML");
             return false;
         }
-        std::string buffer = conversion.str();
-        SetHumdrumBuffer(buffer.c_str());
 
         // Now convert Humdrum into MEI:
         Doc tempdoc;
-        FileInputStream *tempinput = new HumdrumInput(&tempdoc, "");
+        HumdrumInput *tempinput = new HumdrumInput(&tempdoc, "");
         tempinput->SetTypeOption(GetHumType());
+        Profiler::Start("ImportHumdrum");
         if (!tempinput->ImportString(conversion.str())) {
+            Profiler::End();
             LogError("Error importing Humdrum data");
             delete tempinput;
             return false;
         }
+        Profiler::End();
+
+        Profiler::Start("SetHumdrumBuffer");
+        m_humdrumBuffer = tempinput->GetHumdrumString();
+        Profiler::End();
+        Profiler::Start("ExportMei");
         MeiOutput meioutput(&tempdoc, "");
         meioutput.SetScoreBasedMEI(true);
         newData = meioutput.GetOutput();
+        Profiler::End();
         delete tempinput;
         input = new MeiInput(&m_doc, "");
     }
@@ -501,23 +627,84 @@ bool Toolkit::LoadData(const std::string &data)
         return false;
     }
 
-    // xpath queries?
-    if (m_appXPathQueries.size() > 0) {
-        input->SetAppXPathQueries(m_appXPathQueries);
+    if (!this->ImportInput(input, newData.size() ? newData : data)) return false;
+
+    if (!snapshotKey.empty()) {
+        this->SaveSnapshot(snapshotKey, (inputFormat == HUMDRUM) || (inputFormat == MUSICXMLHUM));
+    }
+    return true;
+}
+
+bool Toolkit::LoadData(char *data, size_t length)
+{
+    auto inputFormat = m_format;
+    if (inputFormat == AUTO) {
+        // Only the beginning of the data is looked at for identifying it (see IdentifyInputFormat)
+        inputFormat = IdentifyInputFormat(std::string(data, std::min(length, (size_t)600)));
+    }
+
+    // Only the XML formats can be parsed in place - the others are converted or read from a string
+    if ((inputFormat != MEI) && (inputFormat != MUSICXML)) {
+        return this->LoadData(std::string(data, length));
     }
-    if (m_choiceXPathQueries.size() > 0) {
-        input->SetChoiceXPathQueries(m_choiceXPathQueries);
+
+    ResourcesScope resourcesScope(&m_resources);
+    ProfilerScope profilerScope(&m_profiler, "LoadData");
+
+    // The key has to be calculated before the buffer is modified by the parser
+    std::string snapshotKey;
+    if (!m_layoutCache.empty() && !m_noLayout && !m_reuseLayout) {
+        snapshotKey = this->GetSnapshotKey(data, length);
+        if (this->LoadSnapshot(snapshotKey)) return true;
+    }
+
+    FileInputStream *input = NULL;
+    if (inputFormat == MEI) {
+        input = new MeiInput(&m_doc, "");
     }
-    if (m_mdivXPathQuery.length() > 0) {
-        input->SetMdivXPathQuery(m_mdivXPathQuery);
+    else {
+        input = new MusicXmlInput(&m_doc, "");
+    }
+
+    if (!this->ImportInput(input, "", data, length)) return false;
+
+    if (!snapshotKey.empty()) this->SaveSnapshot(snapshotKey, false);
+    return true;
+}
+
+bool Toolkit::ImportInput(FileInputStream *input, const std::string &data, char *buffer, size_t length,
+    const std::vector<std::vector<int> > *snapshotSystemSizes)
+{
+    // xpath queries? - a snapshot contains only the selected <mdiv> and the selection of the <app> and <choice>
+    // elements is already encoded
+    if (!snapshotSystemSizes) {
+        if (m_appXPathQueries.size() > 0) {
+            input->SetAppXPathQueries(m_appXPathQueries);
+        }
+        if (m_choiceXPathQueries.size() > 0) {
+            input->SetChoiceXPathQueries(m_choiceXPathQueries);
+        }
+        if (m_mdivXPathQuery.length() > 0) {
+            input->SetMdivXPathQuery(m_mdivXPathQuery);
+        }
+        if (m_measureRangeFirst != VRV_UNSET) {
+            input->SetMeasureRange(m_measureRangeFirst, m_measureRangeLast);
+        }
+        if (!m_staffSelection.empty()) {
+            input->SetStaffSelection(m_staffSelection);
+        }
     }
 
     // load the file
-    if (!input->ImportString(newData.size() ? newData : data)) {
+    Profiler::Start("Import");
+    bool imported = (buffer) ? input->ImportBuffer(buffer, length) : input->ImportString(data);
+    if (!imported) {
+        Profiler::End();
         LogError("Error importing data");
         delete input;
         return false;
     }
+    Profiler::End();
 
     m_doc.SetPageHeight(this->GetPageHeight());
     m_doc.SetPageWidth(this->GetPageWidth());
@@ -529,6 +716,9 @@ bool Toolkit::LoadData(const std::string &data)
     m_doc.SetSpacingStaff(this->GetSpacingStaff());
     m_doc.SetSpacingSystem(this->GetSpacingSystem());
     m_doc.SetEvenSpacing(this->GetEvenNoteSpacing());
+    m_doc.SetReuseLayout(this->GetReuseLayout());
+    // a snapshot of an excerpt is an excerpt too
+    if (snapshotSystemSizes && (m_measureRangeFirst != VRV_UNSET)) m_doc.SetExcerpt(true);
 
     m_doc.PrepareDrawing();
 
@@ -536,16 +726,19 @@ bool Toolkit::LoadData(const std::string &data)
     // DARMS have no layout information. MEI files _can_ have it, but it
     // might have been ignored because of the --ignore-layout option.
     // Regardless, we won't do layout if the --no-layout option was set.
-    if (!m_noLayout) {
+    if (snapshotSystemSizes) {
+        if (!m_doc.CastOffSnapshotDoc(*snapshotSystemSizes)) {
+            LogError("The layout of the snapshot does not match its content");
+            delete input;
+            return false;
+        }
+    }
+    else if (!m_noLayout) {
         if (input->HasLayoutInformation() && !m_ignoreLayout) {
-            // LogElapsedTimeStart();
             m_doc.CastOffEncodingDoc();
-            // LogElapsedTimeEnd("layout");
         }
         else {
-            // LogElapsedTimeStart();
             m_doc.CastOffDoc();
-            // LogElapsedTimeEnd("layout");
         }
     }
 
@@ -560,6 +753,168 @@ bool Toolkit::LoadData(const std::string &data)
     return true;
 }
 
+std::string Toolkit::GetSnapshotKey(const char *data, size_t length)
+{
+    // Everything changing the content or the layout of the pages has to be part of the key
+    std::string options = StringFormat("%s|%d|%d|%d|%d|%d|%d|%f|%f|%d|%d|%d|%s", GetVersion().c_str(), m_format,
+        m_pageHeight, m_pageWidth, m_border, m_spacingStaff, m_spacingSystem, m_spacingLinear, m_spacingNonLinear,
+        m_evenNoteSpacing, m_ignoreLayout, m_humType, Resources::GetFontName().c_str());
+    for (auto const &query : m_appXPathQueries) {
+        options += "|app:" + query;
+    }
+    for (auto const &query : m_choiceXPathQueries) {
+        options += "|choice:" + query;
+    }
+    options += "|mdiv:" + m_mdivXPathQuery;
+    options += "|measures:" + this->GetMeasureRange();
+    options += "|staves:" + this->GetStaffSelection();
+
+    // 64-bit FNV-1a hash of the data followed by the options
+    unsigned long long hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ULL;
+    }
+    for (auto c : options) {
+        hash ^= (unsigned char)c;
+        hash *= 1099511628211ULL;
+    }
+
+    return StringFormat("%016llx", hash);
+}
+
+std::string Toolkit::GetSnapshotFilename(const std::string &key)
+{
+    return m_layoutCache + "/" + key + ".mei";
+}
+
+bool Toolkit::LoadSnapshot(const std::string &key)
+{
+    std::string filename = this->GetSnapshotFilename(key);
+    std::ifstream in(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+
+    // The snapshot can be truncated or corrupted, so the numbers it gives are checked against the size of the file
+    in.seekg(0, std::ios::end);
+    long fileSize = (long)in.tellg();
+    in.seekg(0, std::ios::beg);
+
+    // The first line identifies the snapshot and the version that wrote it
+    std::string line;
+    std::getline(in, line);
+    if (line != StringFormat("verovio-layout-snapshot 2 %s %s", GetVersion().c_str(), key.c_str())) {
+        LogWarning("The layout snapshot '%s' does not match and is removed", key.c_str());
+        in.close();
+        std::remove(filename.c_str());
+        return false;
+    }
+
+    // The second line gives the number of elements of each system, with the pages separated by ';'
+    std::vector<std::vector<int> > systemSizes(1);
+    bool valid = (bool)std::getline(in, line);
+    std::istringstream sizes(line);
+    std::string size;
+    while (valid && std::getline(sizes, size, ' ')) {
+        if (size == ";") {
+            systemSizes.push_back(std::vector<int>());
+        }
+        else {
+            char *end = NULL;
+            long n = strtol(size.c_str(), &end, 10);
+            valid = (!size.empty() && (*end == '\0') && (n >= 0) && (n < fileSize));
+            systemSizes.back().push_back((int)n);
+        }
+    }
+
+    // The third line gives the length of the Humdrum buffer, which follows it
+    long humdrumLength = -1;
+    if (valid && std::getline(in, line)) {
+        char *end = NULL;
+        long n = strtol(line.c_str(), &end, 10);
+        if (!line.empty() && (*end == '\0') && (n >= 0) && (n <= fileSize - (long)in.tellg())) humdrumLength = n;
+    }
+    if (humdrumLength < 0) {
+        LogWarning("The layout snapshot '%s' is corrupted and is removed", key.c_str());
+        in.close();
+        std::remove(filename.c_str());
+        return false;
+    }
+    std::string humdrumBuffer(humdrumLength, '\0');
+    if (!humdrumBuffer.empty()) in.read(&humdrumBuffer[0], humdrumBuffer.size());
+
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    if (in.bad() || content.empty()) {
+        LogWarning("The layout snapshot '%s' is incomplete and is removed", key.c_str());
+        std::remove(filename.c_str());
+        return false;
+    }
+
+    ProfilerScope profilerScope(&m_profiler, "LoadSnapshot");
+
+    if (!this->ImportInput(new MeiInput(&m_doc, ""), "", &content[0], content.size(), &systemSizes)) {
+        // Start again from a clean document and load the data - the snapshot is removed so it is written again
+        LogWarning("The layout snapshot '%s' could not be loaded and is removed", key.c_str());
+        m_doc.Reset();
+        std::remove(filename.c_str());
+        return false;
+    }
+
+    m_humdrumBuffer = humdrumBuffer;
+
+    return true;
+}
+
+bool Toolkit::SaveSnapshot(const std::string &key, bool withHumdrumBuffer)
+{
+    ProfilerScope profilerScope(&m_profiler, "SaveSnapshot");
+
+    // Write a temporary file first so an incomplete snapshot is never read. Its name is unique to the process and
+    // to the toolkit because several of them can write the same snapshot at the same time.
+#ifndef _WIN32
+    int pid = getpid();
+#else
+    int pid = _getpid();
+#endif
+    std::string filename = this->GetSnapshotFilename(key);
+    std::string tempFilename = StringFormat("%s.%d.%p.tmp", filename.c_str(), pid, (void *)this);
+    std::ofstream out(tempFilename.c_str(), std::ios::out | std::ios::binary);
+    if (!out.is_open()) {
+        LogWarning("The layout snapshot '%s' cannot be written", filename.c_str());
+        return false;
+    }
+
+    out << "verovio-layout-snapshot 2 " << GetVersion() << " " << key << "\n";
+    std::vector<std::vector<int> > systemSizes = this->GetSystemSizes();
+    for (int i = 0; i < (int)systemSizes.size(); ++i) {
+        if (i > 0) out << " ; ";
+        for (int j = 0; j < (int)systemSizes.at(i).size(); ++j) {
+            out << ((j > 0) ? " " : "") << systemSizes.at(i).at(j);
+        }
+    }
+    out << "\n";
+
+    // The Humdrum buffer set when importing Humdrum data is kept with the layout
+    std::string humdrumBuffer = (withHumdrumBuffer) ? m_humdrumBuffer : "";
+    out << humdrumBuffer.size() << "\n";
+    out << humdrumBuffer;
+
+    MeiOutput meioutput(&m_doc, "");
+    meioutput.SetScoreBasedMEI(true);
+    out << meioutput.GetOutput();
+    out.close();
+
+    if (out.fail() || (std::rename(tempFilename.c_str(), filename.c_str()) != 0)) {
+        LogWarning("The layout snapshot '%s' cannot be written", filename.c_str());
+        std::remove(tempFilename.c_str());
+        return false;
+    }
+
+    return true;
+}
+
 std::string Toolkit::GetMEI(int pageNo, bool scoreBased)
 {
     // Page number is one-based - correct it to 0-based first
@@ -645,6 +1000,10 @@ bool Toolkit::ParseOptions(const std::string &json_options)
 
     if (json.has<jsonxx::String>("mdivXPathQuery")) SetMdivXPathQuery(json.get<jsonxx::String>("mdivXPathQuery"));
 
+    if (json.has<jsonxx::String>("measureRange")) SetMeasureRange(json.get<jsonxx::String>("measureRange"));
+
+    if (json.has<jsonxx::String>("staffSelection")) SetStaffSelection(json.get<jsonxx::String>("staffSelection"));
+
     if (json.has<jsonxx::Number>("xmlIdSeed")) Object::SeedUuid(json.get<jsonxx::Number>("xmlIdSeed"));
 
     // Parse the various flags
@@ -659,6 +1018,10 @@ bool Toolkit::ParseOptions(const std::string &json_options)
 
     if (json.has<jsonxx::Number>("noJustification")) SetNoJustification(json.get<jsonxx::Number>("noJustification"));
 
+    if (json.has<jsonxx::Number>("reuseLayout")) SetReuseLayout(json.get<jsonxx::Number>("reuseLayout"));
+
+    if (json.has<jsonxx::String>("layoutCache")) SetLayoutCache(json.get<jsonxx::String>("layoutCache"));
+
     if (json.has<jsonxx::Number>("humType")) {
         SetHumType(json.get<jsonxx::Number>("humType"));
     }
@@ -666,6 +1029,8 @@ bool Toolkit::ParseOptions(const std::string &json_options)
     if (json.has<jsonxx::Number>("showBoundingBoxes"))
         SetShowBoundingBoxes(json.get<jsonxx::Number>("showBoundingBoxes"));
 
+    if (json.has<jsonxx::Number>("profile")) SetProfile(json.get<jsonxx::Number>("profile"));
+
     return true;
 #else
     // The non-js version of the app should not use this function.
@@ -706,6 +1071,13 @@ std::string Toolkit::GetElementAttr(const std::string &xmlId)
 bool Toolkit::Edit(const std::string &json_editorAction)
 {
 #ifdef USE_EMSCRIPTEN
+    ResourcesScope resourcesScope(&m_resources);
+
+    // An array of actions is performed as one batch
+    jsonxx::Array actions;
+    if (actions.parse(json_editorAction)) {
+        return this->EditBatch(actions);
+    }
 
     jsonxx::Object json;
 
@@ -715,7 +1087,32 @@ bool Toolkit::Edit(const std::string &json_editorAction)
         return false;
     }
 
+    // The edit info is given only for an array of actions
+    m_editInfo = "{}";
+    return this->EditAction(json);
+
+#else
+    // The non-js version of the app should not use this function.
+    return false;
+#endif
+}
+
+std::string Toolkit::GetEditInfo()
+{
+#ifdef USE_EMSCRIPTEN
+    return m_editInfo;
+#else
+    // The non-js version of the app should not use this function.
+    return "";
+#endif
+}
+
+#ifdef USE_EMSCRIPTEN
+bool Toolkit::EditAction(jsonxx::Object json)
+{
     if (json.has<jsonxx::String>("action") && json.has<jsonxx::Object>("param")) {
+        // The content is modified and the horizontal layout will need to be redone by the next cast-off
+        m_doc.ResetCastOffWidths();
         if (json.get<jsonxx::String>("action") == "drag") {
             std::string elementId;
             int x, y;
@@ -742,11 +1139,145 @@ bool Toolkit::Edit(const std::string &json_editorAction)
     }
     LogError("Does not understand action.");
     return false;
+}
 
-#else
-    // The non-js version of the app should not use this function.
-    return false;
+bool Toolkit::EditBatch(jsonxx::Array actions)
+{
+    ResourcesScope resourcesScope(&m_resources);
+    ProfilerScope profilerScope(&m_profiler, "EditBatch");
+
+    this->BeginEditBatch();
+
+    // The batch stops at the first action that fails and the document is restored as it was before the batch
+    bool success = true;
+    for (int i = 0; i < (int)actions.size(); i++) {
+        if (!actions.has<jsonxx::Object>(i) || !this->EditAction(actions.get<jsonxx::Object>(i))) {
+            LogError("Editor action %d could not be performed and the batch is undone", i);
+            success = false;
+            break;
+        }
+    }
+
+    this->EndEditBatch(!success);
+
+    return success;
+}
 #endif
+
+void Toolkit::BeginEditBatch()
+{
+    ProfilerScope profilerScope(&m_profiler, "BeginEditBatch");
+
+    m_editPreviousLayout = this->GetLayoutMeasures();
+    m_editSnapshotSystemSizes = this->GetSystemSizes();
+    MeiOutput meioutput(&m_doc, "");
+    meioutput.SetScoreBasedMEI(true);
+    m_editSnapshot = meioutput.GetOutput();
+    m_editSnapshotPageIdx = (m_doc.GetDrawingPage()) ? m_doc.GetDrawingPage()->GetIdx() : VRV_UNSET;
+
+    m_editBatch = true;
+    m_editPrepareDrawing = false;
+    m_editedMeasures.clear();
+}
+
+void Toolkit::EndEditBatch(bool restore)
+{
+    ResourcesScope resourcesScope(&m_resources);
+    ProfilerScope profilerScope(&m_profiler, "EndEditBatch");
+
+    if (!m_editBatch) {
+        LogError("No batch of editor actions was begun");
+        return;
+    }
+    m_editBatch = false;
+
+    // The pages with an edited measure and the pages with different systems have changed
+    std::set<int> changedPages;
+    if (restore) {
+        m_editedMeasures.clear();
+        if (!this->ImportInput(new MeiInput(&m_doc, ""), "", &m_editSnapshot[0], m_editSnapshot.size(),
+                &m_editSnapshotSystemSizes)) {
+            LogError("The document could not be restored after the batch of editor actions");
+        }
+        // The editor actions are performed on the drawing page, which has to be the same as before the batch
+        else if ((m_editSnapshotPageIdx != VRV_UNSET) && m_doc.HasPage(m_editSnapshotPageIdx)) {
+            m_view.SetPage(m_editSnapshotPageIdx);
+        }
+    }
+    else {
+        if (m_editPrepareDrawing) m_doc.PrepareDrawing();
+        // Without layout, the content stays on one single page and one single system (see LoadData)
+        if (m_noLayout) {
+            m_doc.UnCastOffDoc();
+        }
+        else {
+            this->RedoLayout();
+        }
+
+        for (auto measure : m_editedMeasures) {
+            Page *page = dynamic_cast<Page *>(measure->GetFirstParent(PAGE));
+            if (page) changedPages.insert(page->GetIdx() + 1);
+        }
+        m_editedMeasures.clear();
+        std::vector<std::vector<Object *> > layout = this->GetLayoutMeasures();
+        for (int i = 0; i < (int)layout.size(); i++) {
+            if ((i >= (int)m_editPreviousLayout.size()) || (layout.at(i) != m_editPreviousLayout.at(i))) {
+                changedPages.insert(i + 1);
+            }
+        }
+    }
+
+    m_editPreviousLayout.clear();
+    m_editSnapshot.clear();
+    m_editSnapshotSystemSizes.clear();
+
+#ifdef USE_EMSCRIPTEN
+    jsonxx::Object o;
+    jsonxx::Array pages;
+    for (auto page : changedPages) pages << page;
+    o << "changedPages" << pages;
+    o << "pageCount" << this->GetPageCount();
+    m_editInfo = o.json();
+#endif
+}
+
+void Toolkit::AddEditedElement(Object *element)
+{
+    assert(element);
+
+    if (!m_editBatch) return;
+    Object *measure = element->GetFirstParent(MEASURE);
+    if (measure) m_editedMeasures.insert(measure);
+}
+
+std::vector<std::vector<Object *> > Toolkit::GetLayoutMeasures()
+{
+    std::vector<std::vector<Object *> > layout;
+    for (int i = 0; i < m_doc.GetChildCount(); i++) {
+        Object *page = m_doc.GetChild(i);
+        std::vector<Object *> measures;
+        for (int j = 0; j < page->GetChildCount(); j++) {
+            measures.push_back(page->GetChild(j)->FindChildByType(MEASURE, 1));
+        }
+        measures.push_back(page->FindChildByType(MEASURE, 2, BACKWARD));
+        layout.push_back(measures);
+    }
+    return layout;
+}
+
+std::vector<std::vector<int> > Toolkit::GetSystemSizes()
+{
+    std::vector<std::vector<int> > systemSizes;
+    for (int i = 0; i < m_doc.GetChildCount(); ++i) {
+        Page *page = dynamic_cast<Page *>(m_doc.GetChild(i));
+        assert(page);
+        std::vector<int> sizes;
+        for (int j = 0; j < page->GetChildCount(); ++j) {
+            sizes.push_back(page->GetChild(j)->GetChildCount());
+        }
+        systemSizes.push_back(sizes);
+    }
+    return systemSizes;
 }
 
 std::string Toolkit::GetLogString()
@@ -782,6 +1313,9 @@ void Toolkit::RedoLayout()
         return;
     }
 
+    ResourcesScope resourcesScope(&m_resources);
+    ProfilerScope profilerScope(&m_profiler, "RedoLayout");
+
     m_doc.SetPageHeight(this->GetPageHeight());
     m_doc.SetPageWidth(this->GetPageWidth());
     m_doc.SetPageRightMar(this->GetBorder());
@@ -789,13 +1323,68 @@ void Toolkit::RedoLayout()
     m_doc.SetPageTopMar(this->GetBorder());
     m_doc.SetSpacingStaff(this->GetSpacingStaff());
     m_doc.SetSpacingSystem(this->GetSpacingSystem());
+    m_doc.SetReuseLayout(this->GetReuseLayout());
 
     m_doc.UnCastOffDoc();
     m_doc.CastOffDoc();
 }
 
+std::string Toolkit::GetLayoutBreaks(const std::string &json_pageWidths)
+{
+#if defined(USE_EMSCRIPTEN) || defined(PYTHON_BINDING)
+    jsonxx::Array widths;
+    jsonxx::Object o;
+    jsonxx::Array layouts;
+
+    if (!widths.parse(json_pageWidths)) {
+        LogError("Can not parse JSON string.");
+        return o.json();
+    }
+
+    if (m_noLayout || (m_doc.GetType() == Transcription)) {
+        return o.json();
+    }
+
+    ResourcesScope resourcesScope(&m_resources);
+    ProfilerScope profilerScope(&m_profiler, "GetLayoutBreaks");
+
+    int pageWidth = this->GetPageWidth();
+    for (int i = 0; i < (int)widths.size(); i++) {
+        if (!widths.has<jsonxx::Number>(i) || !this->SetPageWidth(widths.get<jsonxx::Number>(i))) continue;
+        // Only the first one aligns again the measures of the pages rendered before, the others reuse everything
+        this->RedoLayout();
+
+        jsonxx::Array pages;
+        for (int j = 0; j < m_doc.GetChildCount(); j++) {
+            Object *page = m_doc.GetChild(j);
+            jsonxx::Array systems;
+            for (int k = 0; k < page->GetChildCount(); k++) {
+                Object *measure = page->GetChild(k)->FindChildByType(MEASURE, 1);
+                if (measure) systems << measure->GetUuid();
+            }
+            pages << jsonxx::Value(systems);
+        }
+        jsonxx::Object layout;
+        layout << "pageWidth" << this->GetPageWidth();
+        layout << "pages" << pages;
+        layouts << layout;
+    }
+    o << "layouts" << layouts;
+
+    m_pageWidth = pageWidth;
+    this->RedoLayout();
+
+    return o.json();
+#else
+    // The non-js version of the app should not use this function.
+    return "";
+#endif
+}
+
 void Toolkit::RedoPagePitchPosLayout()
 {
+    ResourcesScope resourcesScope(&m_resources);
+
     Page *page = m_doc.GetDrawingPage();
 
     if (!page) {
@@ -808,12 +1397,70 @@ void Toolkit::RedoPagePitchPosLayout()
 
 std::string Toolkit::RenderToSvg(int pageNo, bool xml_declaration)
 {
+    ResourcesScope resourcesScope(&m_resources);
+    ProfilerScope profilerScope(&m_profiler, "RenderToSvg");
+
     // Page number is one-based - correct it to 0-based first
-    pageNo--;
+    return RenderPageToSvg(pageNo - 1, VRV_UNSET, VRV_UNSET, xml_declaration);
+}
 
+std::string Toolkit::RenderToSvgRange(int pageNo, int x1, int x2, bool xml_declaration)
+{
+    ResourcesScope resourcesScope(&m_resources);
+    ProfilerScope profilerScope(&m_profiler, "RenderToSvgRange");
+
+    // Page number is one-based - correct it to 0-based first
+    return RenderPageToSvg(pageNo - 1, std::min(x1, x2), std::max(x1, x2), xml_declaration);
+}
+
+std::string Toolkit::RenderMeasuresToSvg(const std::string &startId, const std::string &endId, bool xml_declaration)
+{
+    ResourcesScope resourcesScope(&m_resources);
+    ProfilerScope profilerScope(&m_profiler, "RenderMeasuresToSvg");
+
+    Measure *start = dynamic_cast<Measure *>(m_doc.FindChildByUuid(startId));
+    Measure *end = dynamic_cast<Measure *>(m_doc.FindChildByUuid(endId));
+    if (!start || !end) {
+        LogError("Measures '%s' and '%s' not found", startId.c_str(), endId.c_str());
+        return "";
+    }
+    Page *page = dynamic_cast<Page *>(start->GetFirstParent(PAGE));
+    if (!page || (page != end->GetFirstParent(PAGE))) {
+        LogError("Measures '%s' and '%s' are not on the same page", startId.c_str(), endId.c_str());
+        return "";
+    }
+
+    // Lay out the page for getting the measure positions - the page is not set again for rendering it
+    Profiler::Start("SetPage");
+    m_view.SetPage(page->GetIdx());
+    Profiler::End();
+
+    int x1 = std::min(
+        start->GetDrawingX() + start->GetLeftBarLineXRel(), end->GetDrawingX() + end->GetLeftBarLineXRel());
+    int x2 = std::max(
+        start->GetDrawingX() + start->GetRightBarLineXRel(), end->GetDrawingX() + end->GetRightBarLineXRel());
+    // Only the measures between the bar lines are drawn, and not the neighbouring ones with content sticking into them
+    m_view.SetDrawingClipX(x1, x2, true);
+
+    // From logical coordinates to page units
+    x1 = (x1 + m_doc.m_drawingPageLeftMar) / DEFINITION_FACTOR;
+    x2 = (x2 + m_doc.m_drawingPageLeftMar + DEFINITION_FACTOR - 1) / DEFINITION_FACTOR;
+
+    return RenderCurrentPageToSvg(x1, x2, xml_declaration);
+}
+
+std::string Toolkit::RenderPageToSvg(int pageIdx, int x1, int x2, bool xml_declaration)
+{
     // Get the current system for the SVG clipping size
-    m_view.SetPage(pageNo);
+    Profiler::Start("SetPage");
+    m_view.SetPage(pageIdx);
+    Profiler::End();
+
+    return RenderCurrentPageToSvg(x1, x2, xml_declaration);
+}
 
+std::string Toolkit::RenderCurrentPageToSvg(int x1, int x2, bool xml_declaration)
+{
     // Adjusting page width and height according to the options
     int width = m_pageWidth;
     int height = m_pageHeight;
@@ -821,6 +1468,13 @@ std::string Toolkit::RenderToSvg(int pageNo, bool xml_declaration)
     if (m_noLayout) width = m_doc.GetAdjustedDrawingPageWidth();
     if (m_adjustPageHeight || m_noLayout) height = m_doc.GetAdjustedDrawingPageHeight();
 
+    bool clip = (x1 != VRV_UNSET);
+    if (clip) {
+        x1 = std::max(0, std::min(x1, width));
+        x2 = std::max(x1, std::min(x2, width));
+        width = x2 - x1;
+    }
+
     // Create the SVG object, h & w come from the system
     // We will need to set the size of the page after having drawn it depending on the options
     SvgDeviceContext svg(width, height);
@@ -831,10 +1485,26 @@ std::string Toolkit::RenderToSvg(int pageNo, bool xml_declaration)
     // debug BB?
     svg.SetDrawBoundingBoxes(m_showBoundingBoxes);
 
+    // only draw the measures visible in the range, which is converted to logical coordinates
+    if (clip) {
+        svg.SetViewBoxX(x1);
+        // The drawing clip of a range of measures is already set (see RenderMeasuresToSvg)
+        if (!m_view.HasDrawingClipX()) {
+            m_view.SetDrawingClipX(x1 * DEFINITION_FACTOR - m_doc.m_drawingPageLeftMar,
+                x2 * DEFINITION_FACTOR - m_doc.m_drawingPageLeftMar);
+        }
+    }
+
     // render the page
+    Profiler::Start("DrawCurrentPage");
     m_view.DrawCurrentPage(&svg, false);
+    Profiler::End();
 
+    m_view.ResetDrawingClipX();
+
+    Profiler::Start("GetStringSVG");
     std::string out_str = svg.GetStringSVG(xml_declaration);
+    Profiler::End();
     return out_str;
 }
 
@@ -855,6 +1525,16 @@ bool Toolkit::RenderToSvgFile(const std::string &filename, int pageNo)
     return true;
 }
 
+std::vector<std::string> Toolkit::RenderAllToSvg(bool xml_declaration)
+{
+    std::vector<std::string> pages;
+    pages.reserve(this->GetPageCount());
+    for (int pageNo = 1; pageNo <= this->GetPageCount(); ++pageNo) {
+        pages.push_back(this->RenderToSvg(pageNo, xml_declaration));
+    }
+    return pages;
+}
+
 std::string Toolkit::GetHumdrum()
 {
     return GetHumdrumBuffer();
@@ -882,6 +1562,14 @@ void Toolkit::GetHumdrum(ostream &output)
 
 std::string Toolkit::RenderToMidi()
 {
+    std::string data = this->RenderToMidiData();
+    return Base64Encode(reinterpret_cast<const unsigned char *>(data.c_str()), (unsigned int)data.length());
+}
+
+std::string Toolkit::RenderToMidiData()
+{
+    ProfilerScope profilerScope(&m_profiler, "RenderToMidi");
+
     MidiFile outputfile;
     outputfile.absoluteTicks();
     m_doc.ExportMIDI(&outputfile);
@@ -889,10 +1577,7 @@ std::string Toolkit::RenderToMidi()
 
     stringstream strstrem;
     outputfile.write(strstrem);
-    std::string outputstr = Base64Encode(
-        reinterpret_cast<const unsigned char *>(strstrem.str().c_str()), (unsigned int)strstrem.str().length());
-
-    return outputstr;
+    return strstrem.str();
 }
 
 std::string Toolkit::GetElementsAtTime(int millisec)
@@ -932,6 +1617,8 @@ std::string Toolkit::GetElementsAtTime(int millisec)
 
 bool Toolkit::RenderToMidiFile(const std::string &filename)
 {
+    ProfilerScope profilerScope(&m_profiler, "RenderToMidi");
+
     MidiFile outputfile;
     outputfile.absoluteTicks();
     m_doc.ExportMIDI(&outputfile);
@@ -971,89 +1658,55 @@ double Toolkit::GetTimeForElement(const std::string &xmlId)
     return timeofElement;
 }
 
-void Toolkit::SetCString(const std::string &data)
+void Toolkit::SetCString(std::string data)
 {
-    if (m_cString) {
-        free(m_cString);
-        m_cString = NULL;
-    }
-
-    m_cString = (char *)malloc(strlen(data.c_str()) + 1);
-
-    // something went wrong
-    if (!m_cString) {
-        return;
-    }
-    strcpy(m_cString, data.c_str());
+    // the previous string is released and the new one is taken over without copying its content
+    m_cString.swap(data);
 }
 
 void Toolkit::SetHumdrumBuffer(const char *data)
 {
-    if (m_humdrumBuffer) {
-        free(m_humdrumBuffer);
-        m_humdrumBuffer = NULL;
-    }
-
 #ifndef NO_HUMDRUM_SUPPORT
     hum::HumdrumFile file;
     file.readString(data);
     // apply Humdrum tools if there are any filters in the file.
     if (file.hasFilters()) {
-        string output;
         hum::Tool_filter filter;
         filter.run(file);
         if (filter.hasHumdrumText()) {
-            output = filter.getHumdrumText();
+            m_humdrumBuffer = filter.getHumdrumText();
         }
         else {
             // humdrum structure not always correct in output from tools
             // yet, so reload.
             stringstream tempdata;
             tempdata << file;
-            output = tempdata.str();
+            m_humdrumBuffer = tempdata.str();
         }
-        m_humdrumBuffer = (char *)malloc(output.size() + 1);
-        if (!m_humdrumBuffer) {
-            // something went wrong
-            return;
-        }
-        strcpy(m_humdrumBuffer, output.c_str());
     }
     else {
-        int size = (int)strlen(data) + 1;
-        m_humdrumBuffer = (char *)malloc(size);
-        if (!m_humdrumBuffer) {
-            // something went wrong
-            return;
-        }
-        strcpy(m_humdrumBuffer, data);
+        m_humdrumBuffer = data;
     }
 
 #else
-    size_t size = (int)strlen(data) + 1;
-    m_humdrumBuffer = (char *)malloc(size);
-    if (!m_humdrumBuffer) {
-        // something went wrong
-        return;
-    }
-    strcpy(m_humdrumBuffer, data);
+    m_humdrumBuffer = data;
 #endif
 }
 
 const char *Toolkit::GetCString()
 {
-    if (m_cString) {
-        return m_cString;
-    }
-    else {
-        return "[unspecified]";
-    }
+    return m_cString.c_str();
+}
+
+size_t Toolkit::GetCStringLength()
+{
+    return m_cString.size();
 }
 
 const char *Toolkit::GetHumdrumBuffer()
 {
-    if (m_humdrumBuffer) {
-        return m_humdrumBuffer;
+    if (!m_humdrumBuffer.empty()) {
+        return m_humdrumBuffer.c_str();
     }
     else {
         return "[empty]";
@@ -1071,6 +1724,7 @@ bool Toolkit::Drag(std::string elementId, int x, int y)
     if (!element) {
         element = m_doc.FindChildByUuid(elementId);
     }
+    if (!element) return false;
     if (element->Is(NOTE)) {
         Note *note = dynamic_cast<Note *>(element);
         assert(note);
@@ -1081,6 +1735,7 @@ bool Toolkit::Drag(std::string elementId, int x, int y)
             = (data_PITCHNAME)m_view.CalculatePitchCode(layer, m_view.ToLogicalY(y), note->GetDrawingX(), &oct);
         note->SetPname(pname);
         note->SetOct(oct);
+        this->AddEditedElement(note);
         return true;
     }
     return false;
@@ -1114,7 +1769,15 @@ bool Toolkit::Insert(std::string elementType, std::string startid, std::string e
         slur->SetStartid(startid);
         slur->SetEndid(endid);
         measure->AddChild(slur);
-        m_doc.PrepareDrawing();
+        // Within a batch, the drawing is prepared once at the end
+        if (m_editBatch) {
+            this->AddEditedElement(start);
+            this->AddEditedElement(end);
+            m_editPrepareDrawing = true;
+        }
+        else {
+            m_doc.PrepareDrawing();
+        }
         return true;
     }
     return false;
@@ -1124,16 +1787,28 @@ bool Toolkit::Set(std::string elementId, std::string attrType, std::string attrV
 {
     if (!m_doc.GetDrawingPage()) return false;
     Object *element = m_doc.GetDrawingPage()->FindChildByUuid(elementId);
-    if (Att::SetCmn(element, attrType, attrValue)) return true;
-    if (Att::SetCmnornaments(element, attrType, attrValue)) return true;
-    if (Att::SetCritapp(element, attrType, attrValue)) return true;
-    if (Att::SetExternalsymbols(element, attrType, attrValue)) return true;
-    if (Att::SetMei(element, attrType, attrValue)) return true;
-    if (Att::SetMensural(element, attrType, attrValue)) return true;
-    if (Att::SetMidi(element, attrType, attrValue)) return true;
-    if (Att::SetPagebased(element, attrType, attrValue)) return true;
-    if (Att::SetShared(element, attrType, attrValue)) return true;
-    return false;
+    if (!element) return false;
+    bool success = false;
+    if (Att::SetCmn(element, attrType, attrValue))
+        success = true;
+    else if (Att::SetCmnornaments(element, attrType, attrValue))
+        success = true;
+    else if (Att::SetCritapp(element, attrType, attrValue))
+        success = true;
+    else if (Att::SetExternalsymbols(element, attrType, attrValue))
+        success = true;
+    else if (Att::SetMei(element, attrType, attrValue))
+        success = true;
+    else if (Att::SetMensural(element, attrType, attrValue))
+        success = true;
+    else if (Att::SetMidi(element, attrType, attrValue))
+        success = true;
+    else if (Att::SetPagebased(element, attrType, attrValue))
+        success = true;
+    else if (Att::SetShared(element, attrType, attrValue))
+        success = true;
+    if (success) this->AddEditedElement(element);
+    return success;
 }
 
 #ifdef USE_EMSCRIPTEN
@@ -72,7 +72,7 @@ void Verse::AddChild(Object *child)
 
 int Verse::AlignVertically(FunctorParams *functorParams)
 {
-    AlignVerticallyParams *params = dynamic_cast<AlignVerticallyParams *>(functorParams);
+    AlignVerticallyParams *params = static_cast<AlignVerticallyParams *>(functorParams);
     assert(params);
 
     // this gets (or creates) the measureAligner for the measure
@@ -88,7 +88,7 @@ int Verse::AlignVertically(FunctorParams *functorParams)
 
 int Verse::PrepareProcessingLists(FunctorParams *functorParams)
 {
-    PrepareProcessingListsParams *params = dynamic_cast<PrepareProcessingListsParams *>(functorParams);
+    PrepareProcessingListsParams *params = static_cast<PrepareProcessingListsParams *>(functorParams);
     assert(params);
     // StaffN_LayerN_VerseN_t *tree = static_cast<StaffN_LayerN_VerseN_t*>((*params).at(0));
 
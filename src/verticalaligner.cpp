@@ -210,7 +210,7 @@ void StaffAlignment::SetCurrentFloatingPositioner(FloatingObject *object, Object
 
 int StaffAlignment::AdjustFloatingPostioners(FunctorParams *functorParams)
 {
-    AdjustFloatingPostionersParams *params = dynamic_cast<AdjustFloatingPostionersParams *>(functorParams);
+    AdjustFloatingPostionersParams *params = static_cast<AdjustFloatingPostionersParams *>(functorParams);
     assert(params);
 
     int staffSize = this->GetStaffSize();
@@ -230,6 +230,10 @@ int StaffAlignment::AdjustFloatingPostioners(FunctorParams *functorParams)
         return FUNCTOR_SIBLINGS;
     }
 
+    // The horizontal extents of the overflowing boxes, filled when needed
+    HorizontalContentExtents overflowAboveExtents;
+    HorizontalContentExtents overflowBelowExtents;
+
     ArrayOfFloatingPositioners::iterator iter;
     for (iter = m_floatingPositioners.begin(); iter != m_floatingPositioners.end(); ++iter) {
         assert((*iter)->GetObject());
@@ -272,20 +276,22 @@ int StaffAlignment::AdjustFloatingPostioners(FunctorParams *functorParams)
         (*iter)->CalcDrawingYRel(params->m_doc, this, NULL);
 
         ArrayOfBoundingBoxes *overflowBoxes = &m_overflowBelowBBoxes;
+        HorizontalContentExtents *overflowExtents = &overflowBelowExtents;
         // above?
         if ((*iter)->GetDrawingPlace() == STAFFREL_above) {
             overflowBoxes = &m_overflowAboveBBoxes;
+            overflowExtents = &overflowAboveExtents;
         }
-        auto i = overflowBoxes->begin();
-        auto end = overflowBoxes->end();
-        while (i != end) {
-            // find all the overflowing elements from the staff that overlap horizonatally
-            i = std::find_if(i, end, [iter](BoundingBox *elem) { return (*iter)->HorizontalContentOverlap(elem); });
-            if (i != end) {
-                // update the yRel accordingly
-                (*iter)->CalcDrawingYRel(params->m_doc, this, *i);
-                i++;
-            }
+        // add the boxes not in the extents yet (all of them the first time)
+        for (int j = overflowExtents->GetCount(); j < (int)overflowBoxes->size(); ++j) {
+            overflowExtents->Add(overflowBoxes->at(j));
+        }
+        // find all the overflowing elements from the staff that overlap horizonatally
+        int i = overflowExtents->FindHorizontalContentOverlap(*iter);
+        while (i < overflowExtents->GetCount()) {
+            // update the yRel accordingly
+            (*iter)->CalcDrawingYRel(params->m_doc, this, overflowBoxes->at(i));
+            i = overflowExtents->FindHorizontalContentOverlap(*iter, i + 1);
         }
         //  Now update the staffAlignment max overflow (above or below) and add the positioner to the list of
         //  overflowing elements
@@ -306,7 +312,7 @@ int StaffAlignment::AdjustFloatingPostioners(FunctorParams *functorParams)
 
 int StaffAlignment::AdjustFloatingPostionerGrps(FunctorParams *functorParams)
 {
-    AdjustFloatingPostionerGrpsParams *params = dynamic_cast<AdjustFloatingPostionerGrpsParams *>(functorParams);
+    AdjustFloatingPostionerGrpsParams *params = static_cast<AdjustFloatingPostionerGrpsParams *>(functorParams);
     assert(params);
 
     ArrayOfFloatingPositioners positioners;
@@ -360,7 +366,7 @@ int StaffAlignment::AdjustFloatingPostionerGrps(FunctorParams *functorParams)
 
 int StaffAlignment::AdjustStaffOverlap(FunctorParams *functorParams)
 {
-    AdjustStaffOverlapParams *params = dynamic_cast<AdjustStaffOverlapParams *>(functorParams);
+    AdjustStaffOverlapParams *params = static_cast<AdjustStaffOverlapParams *>(functorParams);
     assert(params);
 
     // This is the bottom alignment (or something is wrong)
@@ -371,26 +377,25 @@ int StaffAlignment::AdjustStaffOverlap(FunctorParams *functorParams)
         return FUNCTOR_SIBLINGS;
     }
 
+    HorizontalContentExtents overflowAboveExtents;
+    if (!params->m_previous->m_overflowBelowBBoxes.empty()) overflowAboveExtents.Add(m_overflowAboveBBoxes);
+
     ArrayOfBoundingBoxes::iterator iter;
     // go through all the elements of the top staff that have an overflow below
     for (iter = params->m_previous->m_overflowBelowBBoxes.begin();
          iter != params->m_previous->m_overflowBelowBBoxes.end(); iter++) {
-        auto i = m_overflowAboveBBoxes.begin();
-        auto end = m_overflowAboveBBoxes.end();
-        while (i != end) {
-            // find all the elements from the bottom staff that have an overflow at the top with an horizontal overap
-            i = std::find_if(i, end, [iter](BoundingBox *elem) { return (*iter)->HorizontalContentOverlap(elem); });
-            if (i != end) {
-                // calculate the vertical overlap and see if this is more than the expected space
-                int overflowBelow = params->m_previous->CalcOverflowBelow(*iter);
-                int overflowAbove = this->CalcOverflowAbove(*i);
-                int spacing = std::max(params->m_previous->m_overflowBelow, this->m_overflowAbove);
-                if (spacing < (overflowBelow + overflowAbove)) {
-                    // LogDebug("Overlap %d", (overflowBelow + overflowAbove) - spacing);
-                    this->SetOverlap((overflowBelow + overflowAbove) - spacing);
-                }
-                i++;
+        // find all the elements from the bottom staff that have an overflow at the top with an horizontal overap
+        int i = overflowAboveExtents.FindHorizontalContentOverlap(*iter);
+        while (i < overflowAboveExtents.GetCount()) {
+            // calculate the vertical overlap and see if this is more than the expected space
+            int overflowBelow = params->m_previous->CalcOverflowBelow(*iter);
+            int overflowAbove = this->CalcOverflowAbove(m_overflowAboveBBoxes.at(i));
+            int spacing = std::max(params->m_previous->m_overflowBelow, this->m_overflowAbove);
+            if (spacing < (overflowBelow + overflowAbove)) {
+                // LogDebug("Overlap %d", (overflowBelow + overflowAbove) - spacing);
+                this->SetOverlap((overflowBelow + overflowAbove) - spacing);
             }
+            i = overflowAboveExtents.FindHorizontalContentOverlap(*iter, i + 1);
         }
     }
 
@@ -401,7 +406,7 @@ int StaffAlignment::AdjustStaffOverlap(FunctorParams *functorParams)
 
 int StaffAlignment::AlignVerticallyEnd(FunctorParams *functorParams)
 {
-    AlignVerticallyParams *params = dynamic_cast<AlignVerticallyParams *>(functorParams);
+    AlignVerticallyParams *params = static_cast<AlignVerticallyParams *>(functorParams);
     assert(params);
 
     SetYRel(-params->m_cumulatedShift);
@@ -413,7 +418,7 @@ int StaffAlignment::AlignVerticallyEnd(FunctorParams *functorParams)
 
 int StaffAlignment::AdjustYPos(FunctorParams *functorParams)
 {
-    AdjustYPosParams *params = dynamic_cast<AdjustYPosParams *>(functorParams);
+    AdjustYPosParams *params = static_cast<AdjustYPosParams *>(functorParams);
     assert(params);
 
     int maxOverlfowAbove;
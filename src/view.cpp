@@ -35,6 +35,10 @@ View::View()
     m_currentMeasure = NULL;
     m_currentStaff = NULL;
     m_currentSystem = NULL;
+
+    m_drawingClipX1 = VRV_UNSET;
+    m_drawingClipX2 = VRV_UNSET;
+    m_drawingClipBarLines = false;
 }
 
 View::~View()
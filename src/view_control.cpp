@@ -1042,6 +1042,15 @@ void View::GetSpanningPointPositions(
     }
 }
 
+void View::CalcBezierAtSpanningPoints(
+    const Point bezier[4], ArrayOfLayerElementPointPairs *spanningPoints, std::vector<int> &curveYs)
+{
+    // The x positions are replaced by the y positions of the curve - the buffer keeps its capacity when resized
+    curveYs.resize(spanningPoints->size());
+    for (int i = 0; i < (int)spanningPoints->size(); ++i) curveYs.at(i) = spanningPoints->at(i).second.x;
+    BoundingBox::CalcBezierAtPositions(bezier, curveYs.data(), curveYs.data(), (int)curveYs.size());
+}
+
 int View::AdjustSlurCurve(Slur *slur, ArrayOfLayerElementPointPairs *spanningPoints, Point *p1, Point *p2, Point *c1,
     Point *c2, curvature_CURVEDIR curveDir, float angle, bool posRatio)
 {
@@ -1071,8 +1080,10 @@ int View::AdjustSlurCurve(Slur *slur, ArrayOfLayerElementPointPairs *spanningPoi
         float maxRatio = 1.0;
         float posXRatio = 1.0;
         int posX;
+        this->CalcBezierAtSpanningPoints(bezier, spanningPoints, m_slurCurveYs);
+        int pointIdx = 0;
         for (itPoint = spanningPoints->begin(); itPoint != spanningPoints->end();) {
-            y = BoundingBox::CalcBezierAtPosition(bezier, itPoint->second.x);
+            y = m_slurCurveYs.at(pointIdx++);
 
             // Weight the desired height according to the x position if wanted
             posXRatio = 1.0;
@@ -1131,8 +1142,10 @@ int View::AdjustSlurCurve(Slur *slur, ArrayOfLayerElementPointPairs *spanningPoi
     // Check if we need further adjustment of the points with the curve
     bezier[1] = *c1;
     bezier[2] = *c2;
+    this->CalcBezierAtSpanningPoints(bezier, spanningPoints, m_slurCurveYs);
+    int pointIdx = 0;
     for (itPoint = spanningPoints->begin(); itPoint != spanningPoints->end();) {
-        y = BoundingBox::CalcBezierAtPosition(bezier, itPoint->second.x);
+        y = m_slurCurveYs.at(pointIdx++);
         if (curveDir == curvature_CURVEDIR_above) {
             if (y >= itPoint->second.y)
                 itPoint = spanningPoints->erase(itPoint);
@@ -1172,8 +1185,10 @@ void View::AdjustSlurPosition(Slur *slur, ArrayOfLayerElementPointPairs *spannin
     ArrayOfLayerElementPointPairs::iterator itPoint;
     int y;
 
+    this->CalcBezierAtSpanningPoints(bezier, spanningPoints, m_slurCurveYs);
+    int pointIdx = 0;
     for (itPoint = spanningPoints->begin(); itPoint != spanningPoints->end();) {
-        y = BoundingBox::CalcBezierAtPosition(bezier, itPoint->second.x);
+        y = m_slurCurveYs.at(pointIdx++);
 
         // Weight the desired height according to the x position on the other side
         posXRatio = 1.0;
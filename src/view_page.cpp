@@ -9,6 +9,7 @@
 
 //----------------------------------------------------------------------------
 
+#include <algorithm>
 #include <assert.h>
 
 //----------------------------------------------------------------------------
@@ -36,6 +37,8 @@
 #include "syl.h"
 #include "system.h"
 #include "text.h"
+#include "tie.h"
+#include "timeinterface.h"
 #include "tuplet.h"
 #include "vrv.h"
 
@@ -52,6 +55,8 @@ void View::DrawCurrentPage(DeviceContext *dc, bool background)
 
     m_currentPage = m_doc->SetDrawingPage(m_pageIdx);
 
+    dc->SetTextExtentCache(m_doc->GetTextExtentCache());
+
     int i;
 
     // Keep the width of the initial scoreDef
@@ -142,6 +147,8 @@ void View::DrawSystem(DeviceContext *dc, System *system)
 
     // First get the first measure of the system
     Measure *measure = dynamic_cast<Measure *>(system->FindChildByType(MEASURE));
+    // With a clipping range, the scoreDef is drawn only when the beginning of the system is visible
+    if (measure && HasDrawingClipX() && (m_drawingClipX1 > measure->GetDrawingX())) measure = NULL;
     if (measure) {
         // NULL for the BarLine parameters indicates that we are drawing the scoreDef
         DrawScoreDef(dc, system->GetDrawingScoreDef(), measure, system->GetDrawingX(), NULL);
@@ -173,6 +180,92 @@ void View::DrawSystem(DeviceContext *dc, System *system)
     dc->EndGraphic(system, this);
 }
 
+void View::SetDrawingClipX(int x1, int x2, bool barLines)
+{
+    m_drawingClipX1 = std::min(x1, x2);
+    m_drawingClipX2 = std::max(x1, x2);
+    m_drawingClipBarLines = barLines;
+}
+
+void View::ResetDrawingClipX()
+{
+    m_drawingClipX1 = VRV_UNSET;
+    m_drawingClipX2 = VRV_UNSET;
+    m_drawingClipBarLines = false;
+}
+
+bool View::IsInDrawingClipX(Measure *measure)
+{
+    assert(measure);
+
+    if (!HasDrawingClipX()) return true;
+
+    int x1 = measure->GetDrawingX() + measure->GetLeftBarLineXRel();
+    int x2 = measure->GetDrawingX() + measure->GetRightBarLineXRel();
+    // The neighbouring measures share a bar line with the range
+    if (m_drawingClipBarLines) return ((x1 >= m_drawingClipX1) && (x2 <= m_drawingClipX2));
+
+    // Take into account content sticking out of the measure (e.g., lyrics)
+    if (measure->HasContentBB()) {
+        x1 = std::min(x1, measure->GetContentLeft());
+        x2 = std::max(x2, measure->GetContentRight());
+    }
+
+    return ((x2 >= m_drawingClipX1) && (x1 <= m_drawingClipX2));
+}
+
+void View::DrawClippedMeasureSpanning(DeviceContext *dc, Measure *measure, System *system)
+{
+    assert(dc);
+    assert(measure);
+    assert(system);
+
+    // Time spanning control elements ending in or after the clipping range
+    Object *current;
+    for (current = measure->GetFirst(); current; current = measure->GetNext()) {
+        if (!current->IsControlElement() || !current->HasInterface(INTERFACE_TIME_SPANNING)) continue;
+        TimeSpanningInterface *interface = current->GetTimeSpanningInterface();
+        assert(interface);
+        if (!interface->HasStartAndEnd() || (interface->GetEnd()->GetDrawingX() < m_drawingClipX1)) continue;
+        // cast to ControlElement check in DrawControlElement
+        DrawControlElement(dc, dynamic_cast<ControlElement *>(current), measure, system);
+    }
+}
+
+void View::DrawClippedMeasureConnectors(DeviceContext *dc, Measure *measure, System *system)
+{
+    assert(dc);
+    assert(measure);
+    assert(system);
+
+    ArrayOfObjects notes;
+    AttComparison isNote(NOTE);
+    measure->FindAllChildByAttComparison(&notes, &isNote);
+    for (ArrayOfObjects::iterator iter = notes.begin(); iter != notes.end(); ++iter) {
+        Note *note = dynamic_cast<Note *>(*iter);
+        assert(note);
+        Tie *tie = note->GetDrawingTieAttr();
+        if (!tie || !tie->HasStartAndEnd() || (tie->GetEnd()->GetDrawingX() < m_drawingClipX1)) continue;
+        // create a placeholder for the tie attribute as in DrawNote
+        dc->StartGraphic(tie, "", tie->GetUuid().c_str());
+        dc->EndGraphic(tie, this);
+        system->AddToDrawingList(tie);
+    }
+
+    ArrayOfObjects syls;
+    AttComparison isSyl(SYL);
+    measure->FindAllChildByAttComparison(&syls, &isSyl);
+    for (ArrayOfObjects::iterator iter = syls.begin(); iter != syls.end(); ++iter) {
+        Syl *syl = dynamic_cast<Syl *>(*iter);
+        assert(syl);
+        if (!syl->GetStart() || !syl->GetEnd() || (syl->GetEnd()->GetDrawingX() < m_drawingClipX1)) continue;
+        // create a placeholder for the connector as for the tie attribute since the syl is not drawn
+        dc->StartGraphic(syl, "", syl->GetUuid().c_str());
+        dc->EndGraphic(syl, this);
+        system->AddToDrawingList(syl);
+    }
+}
+
 void View::DrawSystemList(DeviceContext *dc, System *system, const ClassId classId)
 {
     assert(dc);
@@ -1018,11 +1111,27 @@ void View::DrawSystemChildren(DeviceContext *dc, Object *parent, System *system)
     assert(parent);
     assert(system);
 
+    // The last measure skipped before the clipping range (if any)
+    Measure *clippedMeasure = NULL;
+
     Object *current;
     for (current = parent->GetFirst(); current; current = parent->GetNext()) {
         if (current->Is(MEASURE)) {
-            // cast to Measure check in DrawMeasure
-            DrawMeasure(dc, dynamic_cast<Measure *>(current), system);
+            Measure *measure = dynamic_cast<Measure *>(current);
+            assert(measure);
+            if (HasDrawingClipX() && !IsInDrawingClipX(measure)) {
+                // Only the measures before the clipping range can have elements spanning into it
+                if (measure->GetDrawingX() < m_drawingClipX1) {
+                    DrawClippedMeasureSpanning(dc, measure, system);
+                    clippedMeasure = measure;
+                }
+                continue;
+            }
+            if (clippedMeasure) {
+                DrawClippedMeasureConnectors(dc, clippedMeasure, system);
+                clippedMeasure = NULL;
+            }
+            DrawMeasure(dc, measure, system);
         }
         // scoreDef are not drawn directly, but anything else should not be possible
         else if (current->Is(SCOREDEF)) {
@@ -56,24 +56,48 @@ namespace vrv {
 // Static members with some default values
 //----------------------------------------------------------------------------
 
+/**
+ * A font loaded from the resources with its name and its glyphs by code
+ */
+struct Resources::LoadedFont {
+    std::string m_name;
+    std::map<wchar_t, Glyph> m_glyphs;
+};
+
 std::string Resources::m_path = "/usr/local/share/verovio";
-std::map<wchar_t, Glyph> Resources::m_font;
-std::map<wchar_t, Glyph> Resources::m_textFont;
+std::map<std::string, Resources::LoadedFont *> Resources::m_loadedFonts;
+std::atomic<Resources::LoadedFont *> Resources::m_font(NULL);
+std::atomic<Resources::LoadedFont *> Resources::m_textFont(NULL);
+std::recursive_mutex Resources::m_mutex;
+std::atomic<int> Resources::m_fontGeneration(0);
+thread_local const ResourceSet *Resources::s_current = NULL;
 
 //----------------------------------------------------------------------------
 // Font related methods
 //----------------------------------------------------------------------------
 
+std::string Resources::GetPath()
+{
+    if (s_current && !s_current->m_path.empty()) return s_current->m_path;
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    return m_path;
+}
+
+void Resources::SetPath(std::string path)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    m_path = path;
+}
+
 bool Resources::InitFonts()
 {
-    // We will need to rethink this for adding the option to add custom fonts
-    // Font Bravura first since it is expected to have always all symbols
-    if (!LoadFont("Bravura")) LogError("Bravura font could not be loaded.");
-    // The Leipzig as the default font
-    if (!LoadFont("Leipzig")) LogError("Leipzig font could not be loaded.");
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
 
-    if (m_font.size() < SMUFL_COUNT) {
-        LogError("Expected %d default SMUFL glyphs but could load only %d.", SMUFL_COUNT, m_font.size());
+    LoadedFont *font = GetDefaultFont(m_path);
+    if (m_font.exchange(font) != font) m_fontGeneration++;
+
+    if (font->m_glyphs.size() < SMUFL_COUNT) {
+        LogError("Expected %d default SMUFL glyphs but could load only %d.", SMUFL_COUNT, font->m_glyphs.size());
         return false;
     }
 
@@ -85,28 +109,129 @@ bool Resources::InitFonts()
     return true;
 }
 
+bool Resources::InitFonts(ResourceSet *resources)
+{
+    assert(resources);
+
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+    std::string path = (resources->m_path.empty()) ? m_path : resources->m_path;
+    LoadedFont *font = GetDefaultFont(path);
+    if (resources->m_font != font) m_fontGeneration++;
+    resources->m_font = font;
+
+    if (font->m_glyphs.size() < SMUFL_COUNT) {
+        LogError("Expected %d default SMUFL glyphs but could load only %d.", SMUFL_COUNT, font->m_glyphs.size());
+        return false;
+    }
+
+    LoadedFont *textFont = GetTextFont(path);
+    if (resources->m_textFont != textFont) m_fontGeneration++;
+    resources->m_textFont = textFont;
+    if (!textFont) {
+        LogError("Text font could not be initialized.");
+        return false;
+    }
+
+    return true;
+}
+
 bool Resources::SetFont(std::string fontName)
 {
-    return LoadFont(fontName);
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+    LoadedFont *font = GetFont(m_path, fontName);
+    if (!font) return false;
+    if (m_font.exchange(font) != font) m_fontGeneration++;
+
+    return true;
+}
+
+bool Resources::SetFont(ResourceSet *resources, std::string fontName)
+{
+    assert(resources);
+
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+    LoadedFont *font = GetFont((resources->m_path.empty()) ? m_path : resources->m_path, fontName);
+    if (!font) return false;
+    if (resources->m_font != font) m_fontGeneration++;
+    resources->m_font = font;
+
+    return true;
+}
+
+std::string Resources::GetFontName()
+{
+    LoadedFont *font = (s_current && s_current->m_font) ? s_current->m_font : m_font.load();
+    return (font) ? font->m_name : "";
 }
 
 Glyph *Resources::GetGlyph(wchar_t smuflCode)
 {
-    if (!m_font.count(smuflCode)) return NULL;
-    return &m_font[smuflCode];
+    LoadedFont *font = (s_current && s_current->m_font) ? s_current->m_font : m_font.load();
+    if (!font) return NULL;
+    std::map<wchar_t, Glyph>::iterator iter = font->m_glyphs.find(smuflCode);
+    if (iter == font->m_glyphs.end()) return NULL;
+    return &iter->second;
 }
 
 Glyph *Resources::GetTextGlyph(wchar_t code)
 {
-    if (!m_textFont.count(code)) return NULL;
-    return &m_textFont[code];
+    LoadedFont *font = (s_current && s_current->m_textFont) ? s_current->m_textFont : m_textFont.load();
+    if (!font) return NULL;
+    std::map<wchar_t, Glyph>::iterator iter = font->m_glyphs.find(code);
+    if (iter == font->m_glyphs.end()) return NULL;
+    return &iter->second;
+}
+
+const ResourceSet *Resources::SetCurrent(const ResourceSet *resources)
+{
+    const ResourceSet *previous = s_current;
+    s_current = resources;
+    return previous;
+}
+
+Resources::LoadedFont *Resources::GetDefaultFont(const std::string &path)
+{
+    // The default font is loaded once for the path and shared by the toolkits
+    std::string key = path + "/Leipzig";
+    if (m_loadedFonts.count(key)) return m_loadedFonts.at(key);
+
+    LoadedFont *font = new LoadedFont();
+    // We will need to rethink this for adding the option to add custom fonts
+    // Font Bravura first since it is expected to have always all symbols
+    if (!LoadFont(path, "Bravura", font)) LogError("Bravura font could not be loaded.");
+    // The Leipzig as the default font
+    if (!LoadFont(path, "Leipzig", font)) LogError("Leipzig font could not be loaded.");
+    m_loadedFonts[key] = font;
+    return font;
+}
+
+Resources::LoadedFont *Resources::GetFont(const std::string &path, const std::string &fontName)
+{
+    std::string key = path + "/" + fontName;
+    if (m_loadedFonts.count(key)) return m_loadedFonts.at(key);
+
+    // The font is loaded over the default one, which provides the glyphs missing in it
+    LoadedFont *font = new LoadedFont();
+    std::string defaultKey = path + "/Leipzig";
+    if (m_loadedFonts.count(defaultKey)) *font = *m_loadedFonts.at(defaultKey);
+    if (!LoadFont(path, fontName, font)) {
+        delete font;
+        return NULL;
+    }
+    m_loadedFonts[key] = font;
+    return font;
 }
 
-bool Resources::LoadFont(std::string fontName)
+bool Resources::LoadFont(const std::string &path, std::string fontName, LoadedFont *font)
 {
+    assert(font);
+
     ::DIR *dir;
     dirent *pdir;
-    std::string dirname = Resources::GetPath() + "/" + fontName;
+    std::string dirname = path + "/" + fontName;
     dir = opendir(dirname.c_str());
 
     if (!dir) {
@@ -127,16 +252,17 @@ bool Resources::LoadFont(std::string fontName)
             }
             std::string codeStr = pdir->d_name;
             codeStr = codeStr.substr(0, 4);
-            Glyph glyph(Resources::GetPath() + "/" + fontName + "/" + pdir->d_name, codeStr);
-            m_font[smuflCode] = glyph;
+            Glyph glyph(path + "/" + fontName + "/" + pdir->d_name, codeStr);
+            font->m_glyphs[smuflCode] = glyph;
         }
     }
 
     closedir(dir);
+    font->m_name = fontName;
 
     // Then load the bounding boxes (if bounding box file is provided)
     pugi::xml_document doc;
-    std::string filename = Resources::GetPath() + "/" + fontName + ".xml";
+    std::string filename = path + "/" + fontName + ".xml";
     pugi::xml_parse_result result = doc.load_file(filename.c_str());
     if (!result) {
         // File not found, default bounding boxes will be used
@@ -154,11 +280,11 @@ bool Resources::LoadFont(std::string fontName)
         Glyph *glyph = NULL;
         if (current.attribute("c")) {
             wchar_t smuflCode = (wchar_t)strtol(current.attribute("c").value(), NULL, 16);
-            if (!m_font.count(smuflCode)) {
+            if (!font->m_glyphs.count(smuflCode)) {
                 LogWarning("Glyph with code '%d' not found.", smuflCode);
                 continue;
             }
-            glyph = &m_font[smuflCode];
+            glyph = &font->m_glyphs[smuflCode];
             if (glyph->GetUnitsPerEm() != unitsPerEm * 10) {
                 LogWarning("Glyph and bounding box units-per-em for code '%d' miss-match (bounding box: %d)", smuflCode,
                     unitsPerEm);
@@ -191,28 +317,53 @@ bool Resources::LoadFont(std::string fontName)
 }
 
 bool Resources::InitTextFont()
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+    LoadedFont *font = GetTextFont(m_path);
+    if (!font) return false;
+    if (m_textFont.exchange(font) != font) m_fontGeneration++;
+    return true;
+}
+
+Resources::LoadedFont *Resources::GetTextFont(const std::string &path)
 {
     // For the text font, we load the bounding boxes only
     pugi::xml_document doc;
-    // For now, we have only Times bounding boxes for ASCII chars
+    // For now, we have only Times bounding boxes for ASCII and Latin-1 chars
     // For any other char, we currently use 'o' bounding box
-    std::string filename = Resources::GetPath() + "/text/Times.xml";
+    std::string filename = path + "/text/Times.xml";
+    if (m_loadedFonts.count(filename)) return m_loadedFonts.at(filename);
     pugi::xml_parse_result result = doc.load_file(filename.c_str());
     if (!result) {
         // File not found, default bounding boxes will be used
         LogMessage("Cannot load bounding boxes for text font '%s'", filename.c_str());
-        return false;
+        return NULL;
     }
     pugi::xml_node root = doc.first_child();
     if (!root.attribute("units-per-em")) {
         LogWarning("No units-per-em attribute in bouding box file");
-        return false;
+        return NULL;
     }
     int unitsPerEm = atoi(root.attribute("units-per-em").value());
+    LoadedFont *font = new LoadedFont();
+    font->m_name = "Times";
     pugi::xml_node current;
     for (current = root.child("g"); current; current = current.next_sibling("g")) {
         if (current.attribute("c")) {
-            wchar_t code = (wchar_t)strtol(current.attribute("c").value(), NULL, 16);
+            // Codes above ASCII are given as the hex value of their UTF-8 bytes (e.g., C3A9 for U+00E9)
+            std::string hex = current.attribute("c").value();
+            std::string bytes;
+            for (unsigned int i = 0; i + 1 < hex.length(); i += 2) {
+                bytes.push_back((char)strtol(hex.substr(i, 2).c_str(), NULL, 16));
+            }
+            if (!utf8::is_valid(bytes.begin(), bytes.end())) {
+                LogWarning("Invalid code '%s' in text font bounding box file", hex.c_str());
+                continue;
+            }
+            std::wstring wcode = UTF8to16(bytes);
+            if (wcode.length() != 1) continue;
+            wchar_t code = wcode.at(0);
             // We create a glyph with only the units per em which is the only info we need for
             // the bounding boxes; path and codeStr will remain [unset]
             Glyph glyph(unitsPerEm);
@@ -224,10 +375,11 @@ bool Resources::InitTextFont()
             if (current.attribute("h")) height = atof(current.attribute("h").value());
             glyph.SetBoundingBox(x, y, width, height);
             if (current.attribute("h-a-x")) glyph.SetHorizAdvX(atof(current.attribute("h-a-x").value()));
-            m_textFont[code] = glyph;
+            font->m_glyphs[code] = glyph;
         }
     }
-    return true;
+    m_loadedFonts[filename] = font;
+    return font;
 }
 
 //----------------------------------------------------------------------------
@@ -240,7 +392,7 @@ struct timeval start;
 bool noLog = false;
 
 #ifdef EMSCRIPTEN
-std::vector<std::string> logBuffer;
+thread_local std::vector<std::string> logBuffer;
 #endif
 
 void LogElapsedTimeStart()
@@ -0,0 +1,278 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bench.cpp
+// Author:      Verovio contributors
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench.h"
+
+//----------------------------------------------------------------------------
+
+#include <iostream>
+#include <string.h>
+
+#ifndef _WIN32
+#include <getopt.h>
+#include <sys/resource.h>
+#else
+#include "win_getopt.h"
+#endif
+
+//----------------------------------------------------------------------------
+
+#include "attcomparison.h"
+#include "doc.h"
+#include "iomei.h"
+#include "vrv.h"
+
+using namespace std;
+using namespace vrv;
+
+//----------------------------------------------------------------------------
+// Measures
+//----------------------------------------------------------------------------
+
+long GetPeakMemory()
+{
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return 0;
+#endif
+}
+
+double GetElapsed(const std::chrono::steady_clock::time_point &start)
+{
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+//----------------------------------------------------------------------------
+// Main
+//----------------------------------------------------------------------------
+
+void display_usage()
+{
+    cerr << "Verovio benchmark " << vrv::GetVersion() << endl << endl;
+    cerr << "Example usage:" << endl << endl;
+    cerr << " verovio-bench [-r resources] [--corpus=DIR] [--measures=M --staves=S --layers=L] [infile]" << endl << endl;
+    cerr << "Synthetic MEI, MusicXML and Humdrum scores of M, 2*M, ... measures are generated (see --steps) and the "
+            "files of the corpus directory (MEI, MusicXML, Humdrum and PAE) and the input files are loaded."
+         << endl;
+    cerr << "The results are written in JSON to the standard output and the times are given in milliseconds." << endl;
+    cerr << "The overlap checks are given per second." << endl << endl;
+    cerr << "Options" << endl;
+    cerr << " --beams=D                  Density of the beams per layer between 0.0 and 1.0 (default is 1.0)" << endl;
+    cerr << " --corpus=DIR               Directory with the files of the corpus (default is none)" << endl;
+    cerr << " -i, --iterations=N         Number of tree traversals and bounding box passes for the synthetic scores "
+            "(default is 20)"
+         << endl;
+    cerr << " --layout-cache=DIR         Directory for timing the loading of the files from a layout snapshot" << endl;
+    cerr << " --layers=L                 Number of layers per staff of the synthetic scores (default is 1)" << endl;
+    cerr << " --lyrics=D                 Density of the lyrics per note between 0.0 and 1.0 (default is 0.5)" << endl;
+    cerr << " --measures=M               Number of measures of the smallest synthetic score (default is 50)" << endl;
+    cerr << " --parts=P                  Number of parts of the synthetic MusicXML scores (default is 8)" << endl;
+    cerr << " -r, --resources=PATH       Path to SVG resources (default is " << vrv::Resources::GetPath() << ")"
+         << endl;
+    cerr << " --slurs=D                  Density of the slurs per layer between 0.0 and 1.0 (default is 0.25)" << endl;
+    cerr << " --spines=N                 Number of **kern spines of the synthetic Humdrum scores (default is 16)" << endl;
+    cerr << " --staves=S                 Number of staves of the synthetic scores (default is 4)" << endl;
+    cerr << " --steps=N                  Number of synthetic scores, doubling the measures each time (default is 3)"
+         << endl;
+}
+
+int main(int argc, char **argv)
+{
+    int iterations = 20;
+    int measures = 50;
+    int staves = 4;
+    int layers = 1;
+    int steps = 3;
+    int spines = 16;
+    int parts = 8;
+    double beams = 1.0;
+    double slurs = 0.25;
+    double lyrics = 0.5;
+    std::string corpus;
+    std::string layoutCache;
+    int show_help = 0;
+
+    static struct option long_options[] = { { "beams", required_argument, 0, 0 },
+        { "corpus", required_argument, 0, 0 }, { "help", no_argument, &show_help, 1 },
+        { "iterations", required_argument, 0, 'i' }, { "layers", required_argument, 0, 0 },
+        { "layout-cache", required_argument, 0, 0 }, { "lyrics", required_argument, 0, 0 },
+        { "measures", required_argument, 0, 0 }, { "parts", required_argument, 0, 0 },
+        { "resources", required_argument, 0, 'r' }, { "slurs", required_argument, 0, 0 },
+        { "spines", required_argument, 0, 0 }, { "staves", required_argument, 0, 0 },
+        { "steps", required_argument, 0, 0 }, { 0, 0, 0, 0 } };
+
+    int c;
+    int option_index = 0;
+    while ((c = getopt_long(argc, argv, "i:r:", long_options, &option_index)) != -1) {
+        switch (c) {
+            case 0:
+                if (long_options[option_index].flag != 0)
+                    break;
+                else if (strcmp(long_options[option_index].name, "beams") == 0)
+                    beams = atof(optarg);
+                else if (strcmp(long_options[option_index].name, "corpus") == 0)
+                    corpus = string(optarg);
+                else if (strcmp(long_options[option_index].name, "layers") == 0)
+                    layers = atoi(optarg);
+                else if (strcmp(long_options[option_index].name, "layout-cache") == 0)
+                    layoutCache = string(optarg);
+                else if (strcmp(long_options[option_index].name, "lyrics") == 0)
+                    lyrics = atof(optarg);
+                else if (strcmp(long_options[option_index].name, "measures") == 0)
+                    measures = atoi(optarg);
+                else if (strcmp(long_options[option_index].name, "parts") == 0)
+                    parts = atoi(optarg);
+                else if (strcmp(long_options[option_index].name, "slurs") == 0)
+                    slurs = atof(optarg);
+                else if (strcmp(long_options[option_index].name, "spines") == 0)
+                    spines = atoi(optarg);
+                else if (strcmp(long_options[option_index].name, "staves") == 0)
+                    staves = atoi(optarg);
+                else if (strcmp(long_options[option_index].name, "steps") == 0)
+                    steps = atoi(optarg);
+                break;
+            case 'i': iterations = atoi(optarg); break;
+            case 'r': vrv::Resources::SetPath(optarg); break;
+            case '?':
+                display_usage();
+                exit(1);
+                break;
+            default: break;
+        }
+    }
+
+    if (show_help) {
+        display_usage();
+        exit(0);
+    }
+
+    if (!Resources::InitFonts()) {
+        cerr << "The resources path " << vrv::Resources::GetPath() << " could not be found; please use -r option."
+             << endl;
+        exit(1);
+    }
+    DisableLog();
+
+    std::stringstream json;
+    json << "{\n";
+    json << "    \"version\": \"" << vrv::GetVersion() << "\",\n";
+
+    // Synthetic scores by increasing size
+    json << "    \"synthetic\": [";
+    for (int step = 0; step < steps; step++) {
+        int stepMeasures = measures << step;
+        std::string mei = GenerateMei(stepMeasures, staves, layers, beams, slurs, lyrics);
+
+        Doc doc;
+        MeiInput input(&doc, "");
+        input.ImportString(mei);
+        ArrayOfObjects notes;
+        AttComparison matchNote(NOTE);
+        doc.FindAllChildByAttComparison(&notes, &matchNote);
+        AttCommonNComparison matchStaff(STAFF, 1);
+        ArrayOfAttComparisons filters;
+        filters.push_back(&matchStaff);
+
+        json << ((step > 0) ? "," : "") << "\n        {\n";
+        json << "            \"measures\": " << stepMeasures << ",\n";
+        json << "            \"staves\": " << staves << ",\n";
+        json << "            \"layers\": " << layers << ",\n";
+        json << "            \"beams\": " << beams << ",\n";
+        json << "            \"slurs\": " << slurs << ",\n";
+        json << "            \"lyrics\": " << lyrics << ",\n";
+        json << "            \"notes\": " << notes.size() << ",\n";
+        json << "            \"traversal-forward\": " << BenchTraversal(&doc, iterations, FORWARD, NULL) << ",\n";
+        json << "            \"traversal-backward\": " << BenchTraversal(&doc, iterations, BACKWARD, NULL) << ",\n";
+        json << "            \"traversal-filtered\": " << BenchTraversal(&doc, iterations, FORWARD, &filters) << ",\n";
+        json << "            \"render-all-reuse-layout\": " << BenchReuseLayout(mei) << ",\n";
+        json << "            \"redo-layout\": " << BenchRedoLayout(mei) << ",\n";
+        json << "            \"layout-breaks\": " << BenchLayoutBreaks(mei) << ",\n";
+        json << "            \"export-mei\": " << BenchExportMei(mei) << ",\n";
+        json << "            \"bbox-render\": " << BenchBBoxRender(mei, iterations) << ",\n";
+        int overlaps = 0;
+        json << "            \"overlap-checks-boxes\": " << BenchOverlapChecks(mei, iterations, false, overlaps)
+             << ",\n";
+        json << "            \"overlap-checks-extents\": " << BenchOverlapChecks(mei, iterations, true, overlaps)
+             << ",\n";
+        json << "            \"overlaps\": " << overlaps << ",\n";
+        BenchToolkit(mei, "", json);
+        json << "\n        }";
+    }
+    json << "\n    ],\n";
+
+    // Synthetic MusicXML scores by increasing size, with many parts for the import of the part measures
+    json << "    \"musicxml\": [";
+    for (int step = 0; step < steps; step++) {
+        int stepMeasures = measures << step;
+        json << ((step > 0) ? "," : "") << "\n        {\n";
+        json << "            \"measures\": " << stepMeasures << ",\n";
+        json << "            \"parts\": " << parts << ",\n";
+        json << "            \"beams\": " << beams << ",\n";
+        json << "            \"slurs\": " << slurs << ",\n";
+        BenchToolkit(GenerateMusicXml(stepMeasures, parts, beams, slurs), "", json);
+        json << "\n        }";
+    }
+    json << "\n    ],\n";
+
+    // Synthetic Humdrum scores by increasing size, with many spines for the token parameters
+    json << "    \"humdrum\": [";
+    for (int step = 0; step < steps; step++) {
+        int stepMeasures = measures << step;
+        json << ((step > 0) ? "," : "") << "\n        {\n";
+        json << "            \"measures\": " << stepMeasures << ",\n";
+        json << "            \"spines\": " << spines << ",\n";
+        json << "            \"beams\": " << beams << ",\n";
+        json << "            \"slurs\": " << slurs << ",\n";
+        BenchToolkit(GenerateHumdrum(stepMeasures, spines, beams, slurs), "humdrum", json);
+        json << "\n        }";
+    }
+    json << "\n    ],\n";
+
+    // Corpus and input files
+    std::vector<std::string> files;
+    if (!corpus.empty()) {
+        ListCorpus(corpus, files);
+        if (files.empty()) {
+            cerr << "The corpus directory " << corpus << " could not be read or is empty." << endl;
+            exit(1);
+        }
+    }
+    for (int i = optind; i < argc; i++) files.push_back(argv[i]);
+
+    json << "    \"files\": [";
+    for (auto &filename : files) {
+        std::string data;
+        if (!ReadFile(filename, data)) {
+            cerr << "The file " << filename << " could not be read." << endl;
+            exit(1);
+        }
+        bool supported;
+        std::string format = GetCorpusFormat(filename, supported);
+        json << ((&filename != &files.front()) ? "," : "") << "\n        {\n";
+        json << "            \"file\": \"" << filename << "\",\n";
+        json << "            \"load-file\": " << BenchLoadFile(filename, format) << ",\n";
+        if (!layoutCache.empty()) {
+            json << "            \"load-snapshot\": " << BenchLoadSnapshot(data, format, layoutCache) << ",\n";
+        }
+        BenchToolkit(data, format, json);
+        json << "\n        }";
+    }
+    json << "\n    ]\n";
+    json << "}\n";
+
+    cout << json.str();
+
+    return 0;
+}
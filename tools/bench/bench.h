@@ -0,0 +1,171 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bench.h
+// Author:      Verovio contributors
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VRV_BENCH_H__
+#define __VRV_BENCH_H__
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------------
+
+#include "vrvdef.h"
+
+namespace vrv {
+class Doc;
+} // namespace vrv
+
+//----------------------------------------------------------------------------
+// Measures (bench.cpp)
+//----------------------------------------------------------------------------
+
+/**
+ * Return the peak resident memory of the process in kilobytes (0 when not available).
+ * This is a high-water mark for the whole process, which is why the cases are run by increasing size.
+ */
+long GetPeakMemory();
+
+/**
+ * Return the elapsed time since start in milliseconds.
+ */
+double GetElapsed(const std::chrono::steady_clock::time_point &start);
+
+//----------------------------------------------------------------------------
+// Synthetic score generation (bench_generate.cpp)
+//----------------------------------------------------------------------------
+
+/**
+ * Return true for an evenly distributed proportion (density) of the successive indexes.
+ * This is deterministic so that the generated scores are identical from one run to another.
+ */
+bool Pick(double density, int index);
+
+/**
+ * Generate an MEI score with the given number of measures, staves and layers.
+ * Each layer of each measure contains four eighth notes, a quarter note and a half note.
+ * The density of beams and slurs (per layer) and of lyrics (per note) is between 0.0 and 1.0.
+ */
+std::string GenerateMei(int measures, int staves, int layers, double beams, double slurs, double lyrics);
+
+/**
+ * Return a Humdrum line with the same token in all the spines.
+ */
+std::string GetHumdrumLine(const std::string &token, int spines);
+
+/**
+ * Generate a Humdrum score with the given number of measures and **kern spines.
+ * Each measure of each spine contains two eighth notes and three quarter notes, the last two of which can be slurred.
+ * The density of beams and slurs (per measure and spine) is between 0.0 and 1.0.
+ */
+std::string GenerateHumdrum(int measures, int spines, double beams, double slurs);
+
+/**
+ * Generate a MusicXML score with the given number of measures and single-staff parts.
+ * The measures contain the same notes as in GenerateHumdrum, with a tempo direction in the first measure.
+ * The density of beams and slurs (per measure and part) is between 0.0 and 1.0.
+ */
+std::string GenerateMusicXml(int measures, int parts, double beams, double slurs);
+
+//----------------------------------------------------------------------------
+// Tree traversal (bench_traversal.cpp)
+//----------------------------------------------------------------------------
+
+/**
+ * Run full-tree traversals of the document and return the number of traversals per second.
+ * A uuid that does not exist is looked for, so that every object of the tree is visited.
+ */
+double BenchTraversal(vrv::Doc *doc, int iterations, bool direction, vrv::ArrayOfAttComparisons *filters);
+
+//----------------------------------------------------------------------------
+// Loading and rendering with the toolkit (bench_toolkit.cpp)
+//----------------------------------------------------------------------------
+
+/**
+ * Load the data with the toolkit, render all the pages and the MIDI, and write the results as JSON members.
+ * The format is given for PAE and Humdrum since it cannot be always identified from the content.
+ */
+void BenchToolkit(const std::string &data, const std::string &format, std::stringstream &json);
+
+//----------------------------------------------------------------------------
+// Layout (bench_layout.cpp)
+//----------------------------------------------------------------------------
+
+/**
+ * Load the data with the cast-off layout reused for the pages and return the time for rendering all the pages.
+ */
+double BenchReuseLayout(const std::string &data);
+
+/**
+ * Load the data, render the first page and return the time for redoing the layout for a narrower page.
+ */
+double BenchRedoLayout(const std::string &data);
+
+/**
+ * Load the data, render the first page and return the time for laying it out for several page widths.
+ * This is what Toolkit::GetLayoutBreaks does, which is available only with the JSON bindings.
+ */
+double BenchLayoutBreaks(const std::string &data);
+
+//----------------------------------------------------------------------------
+// Bounding boxes and overlaps (bench_render.cpp)
+//----------------------------------------------------------------------------
+
+/**
+ * Lay out the first page of the MEI data and return the average time of the bounding box rendering pass of it.
+ * This is the pass done by Page::LayOutVertically for filling the bounding boxes.
+ */
+double BenchBBoxRender(const std::string &data, int iterations);
+
+/**
+ * Load the data, lay out the first page and return the number of horizontal overlap checks per second when looking
+ * for all the notes overlapping each note, either through the BoundingBox of each of them or with the contiguous
+ * HorizontalContentExtents. The number of overlaps found is returned in found.
+ */
+double BenchOverlapChecks(const std::string &data, int iterations, bool extents, int &found);
+
+//----------------------------------------------------------------------------
+// Input and output (bench_io.cpp)
+//----------------------------------------------------------------------------
+
+/**
+ * Load the data and return the time for writing it as score-based MEI.
+ */
+double BenchExportMei(const std::string &data);
+
+/**
+ * Return the time for loading the file with Toolkit::LoadFile, which parses XML files in place.
+ */
+double BenchLoadFile(const std::string &filename, const std::string &format);
+
+/**
+ * Load the data with the layout cache in the directory and return the time for loading it again from the snapshot.
+ */
+double BenchLoadSnapshot(const std::string &data, const std::string &format, const std::string &layoutCache);
+
+//----------------------------------------------------------------------------
+// Corpus (bench_corpus.cpp)
+//----------------------------------------------------------------------------
+
+/**
+ * Return the format to be given to the toolkit for a file extension, or an empty string for others.
+ * Set supported to false for files that are not part of the corpus.
+ */
+std::string GetCorpusFormat(const std::string &filename, bool &supported);
+
+/**
+ * Recursively list the files of the corpus directory, sorted so that the results can be compared between runs.
+ */
+void ListCorpus(const std::string &dirname, std::vector<std::string> &files);
+
+/**
+ * Read the content of a file, returning false if it cannot be opened.
+ */
+bool ReadFile(const std::string &filename, std::string &content);
+
+#endif
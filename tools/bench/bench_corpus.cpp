@@ -0,0 +1,73 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bench_corpus.cpp
+// Author:      Verovio contributors
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench.h"
+
+//----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <dirent.h>
+#else
+#include "win_dirent.h"
+#endif
+
+//----------------------------------------------------------------------------
+// Corpus
+//----------------------------------------------------------------------------
+
+std::string GetCorpusFormat(const std::string &filename, bool &supported)
+{
+    supported = true;
+    size_t dot = filename.rfind('.');
+    std::string extension = (dot == std::string::npos) ? "" : filename.substr(dot + 1);
+    if (extension == "pae") return "pae";
+    if (extension == "krn") return "humdrum";
+    if ((extension == "mei") || (extension == "xml") || (extension == "musicxml")) return "";
+    supported = false;
+    return "";
+}
+
+void ListCorpus(const std::string &dirname, std::vector<std::string> &files)
+{
+    ::DIR *dir = opendir(dirname.c_str());
+    if (!dir) return;
+
+    std::vector<std::string> entries;
+    dirent *pdir;
+    while ((pdir = readdir(dir))) {
+        if (pdir->d_name[0] == '.') continue;
+        entries.push_back(pdir->d_name);
+    }
+    closedir(dir);
+    std::sort(entries.begin(), entries.end());
+
+    for (auto &entry : entries) {
+        std::string path = dirname + "/" + entry;
+        bool supported;
+        GetCorpusFormat(entry, supported);
+        if (supported)
+            files.push_back(path);
+        else
+            ListCorpus(path, files);
+    }
+}
+
+bool ReadFile(const std::string &filename, std::string &content)
+{
+    std::ifstream in(filename.c_str());
+    if (!in.is_open()) return false;
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    content = buffer.str();
+    return true;
+}
@@ -0,0 +1,159 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bench_generate.cpp
+// Author:      Verovio contributors
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench.h"
+
+//----------------------------------------------------------------------------
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------------
+// Synthetic score generation
+//----------------------------------------------------------------------------
+
+bool Pick(double density, int index)
+{
+    return ((int)((index + 1) * density) > (int)(index * density));
+}
+
+std::string GenerateMei(int measures, int staves, int layers, double beams, double slurs, double lyrics)
+{
+    const char *pnames[] = { "c", "d", "e", "f", "g", "a", "b" };
+    const char *syllables[] = { "la", "li", "lo", "lu" };
+    std::stringstream mei;
+    mei << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    mei << "<mei xmlns=\"http://www.music-encoding.org/ns/mei\" meiversion=\"3.0.0\">";
+    mei << "<meiHead><fileDesc><titleStmt><title/></titleStmt><pubStmt/></fileDesc></meiHead>";
+    mei << "<music><body><mdiv><score><scoreDef meter.count=\"4\" meter.unit=\"4\"><staffGrp>";
+    for (int s = 1; s <= staves; s++) {
+        mei << "<staffDef n=\"" << s << "\" lines=\"5\" clef.shape=\"G\" clef.line=\"2\"/>";
+    }
+    mei << "</staffGrp></scoreDef><section>";
+    int pitch = 0;
+    int note = 0;
+    int layerCount = 0;
+    for (int m = 1; m <= measures; m++) {
+        std::stringstream slurElements;
+        mei << "<measure n=\"" << m << "\">";
+        for (int s = 1; s <= staves; s++) {
+            mei << "<staff n=\"" << s << "\">";
+            for (int l = 1; l <= layers; l++, layerCount++) {
+                int oct = (l % 2) ? 5 : 4;
+                bool beam = Pick(beams, layerCount);
+                mei << "<layer n=\"" << l << "\">";
+                if (beam) mei << "<beam>";
+                if (Pick(slurs, layerCount)) {
+                    slurElements << "<slur staff=\"" << s << "\" startid=\"#n" << note << "\" endid=\"#n" << note + 3
+                                 << "\"/>";
+                }
+                for (int n = 0; n < 6; n++, note++) {
+                    const char *dur = (n < 4) ? "8" : ((n == 4) ? "4" : "2");
+                    mei << "<note xml:id=\"n" << note << "\" dur=\"" << dur << "\" pname=\"" << pnames[pitch++ % 7]
+                        << "\" oct=\"" << oct << "\">";
+                    if (Pick(lyrics, note)) {
+                        mei << "<verse n=\"1\"><syl>" << syllables[note % 4] << "</syl></verse>";
+                    }
+                    mei << "</note>";
+                    if (beam && (n == 3)) mei << "</beam>";
+                }
+                mei << "</layer>";
+            }
+            mei << "</staff>";
+        }
+        mei << slurElements.str();
+        mei << "</measure>";
+    }
+    mei << "</section></score></mdiv></body></music></mei>\n";
+    return mei.str();
+}
+
+std::string GetHumdrumLine(const std::string &token, int spines)
+{
+    std::string line = token;
+    for (int s = 1; s < spines; s++) line += "\t" + token;
+    return line + "\n";
+}
+
+std::string GenerateHumdrum(int measures, int spines, double beams, double slurs)
+{
+    const char *pnames[] = { "c", "d", "e", "f", "g", "a", "b" };
+    std::stringstream hum;
+    hum << GetHumdrumLine("**kern", spines);
+    for (int s = 0; s < spines; s++) hum << ((s > 0) ? "\t" : "") << "*staff" << (spines - s);
+    hum << "\n";
+    hum << GetHumdrumLine("*clefG2", spines);
+    hum << GetHumdrumLine("*M4/4", spines);
+    int pitch = 0;
+    int count = 0;
+    for (int m = 1; m <= measures; m++) {
+        std::vector<bool> beam(spines);
+        std::vector<bool> slur(spines);
+        for (int s = 0; s < spines; s++, count++) {
+            beam[s] = Pick(beams, count);
+            slur[s] = Pick(slurs, count);
+        }
+        hum << GetHumdrumLine("=" + std::to_string(m), spines);
+        for (int n = 0; n < 5; n++) {
+            for (int s = 0; s < spines; s++) {
+                if (s > 0) hum << "\t";
+                if ((n == 3) && slur[s]) hum << "(";
+                hum << ((n < 2) ? "8" : "4") << pnames[pitch++ % 7];
+                if ((n == 4) && slur[s]) hum << ")";
+                if ((n == 0) && beam[s]) hum << "L";
+                if ((n == 1) && beam[s]) hum << "J";
+            }
+            hum << "\n";
+        }
+    }
+    hum << GetHumdrumLine("==", spines);
+    hum << GetHumdrumLine("*-", spines);
+    return hum.str();
+}
+
+std::string GenerateMusicXml(int measures, int parts, double beams, double slurs)
+{
+    const char *steps[] = { "C", "D", "E", "F", "G", "A", "B" };
+    std::stringstream xml;
+    xml << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    xml << "<score-partwise version=\"3.0\"><movement-title>Benchmark</movement-title><part-list>";
+    for (int p = 1; p <= parts; p++) {
+        xml << "<score-part id=\"P" << p << "\"><part-name>Part " << p << "</part-name></score-part>";
+    }
+    xml << "</part-list>";
+    int pitch = 0;
+    for (int p = 1; p <= parts; p++) {
+        xml << "<part id=\"P" << p << "\">";
+        for (int m = 1; m <= measures; m++) {
+            int count = (m - 1) * parts + p - 1;
+            bool beam = Pick(beams, count);
+            bool slur = Pick(slurs, count);
+            xml << "<measure number=\"" << m << "\">";
+            if (m == 1) {
+                xml << "<attributes><divisions>2</divisions><key><fifths>0</fifths></key>"
+                       "<time><beats>4</beats><beat-type>4</beat-type></time>"
+                       "<clef><sign>G</sign><line>2</line></clef></attributes>";
+                xml << "<direction placement=\"above\"><direction-type><words>Allegro</words></direction-type>"
+                       "<sound tempo=\"120\"/></direction>";
+            }
+            for (int n = 0; n < 5; n++) {
+                xml << "<note><pitch><step>" << steps[pitch++ % 7] << "</step><octave>4</octave></pitch>";
+                xml << "<duration>" << ((n < 2) ? 1 : 2) << "</duration><voice>1</voice>";
+                xml << "<type>" << ((n < 2) ? "eighth" : "quarter") << "</type>";
+                if ((n < 2) && beam) xml << "<beam number=\"1\">" << ((n == 0) ? "begin" : "end") << "</beam>";
+                if ((n == 3) && slur) xml << "<notations><slur type=\"start\" number=\"1\"/></notations>";
+                if ((n == 4) && slur) xml << "<notations><slur type=\"stop\" number=\"1\"/></notations>";
+                xml << "</note>";
+            }
+            xml << "</measure>";
+        }
+        xml << "</part>";
+    }
+    xml << "</score-partwise>\n";
+    return xml.str();
+}
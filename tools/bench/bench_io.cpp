@@ -0,0 +1,58 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bench_io.cpp
+// Author:      Verovio contributors
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench.h"
+
+//----------------------------------------------------------------------------
+
+#include <chrono>
+#include <string>
+
+//----------------------------------------------------------------------------
+
+#include "toolkit.h"
+
+using namespace vrv;
+
+//----------------------------------------------------------------------------
+// Input and output
+//----------------------------------------------------------------------------
+
+double BenchExportMei(const std::string &data)
+{
+    Toolkit toolkit(false);
+    if (!toolkit.LoadData(data)) return 0.0;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    toolkit.GetMEI(0, true);
+    return GetElapsed(start);
+}
+
+double BenchLoadFile(const std::string &filename, const std::string &format)
+{
+    Toolkit toolkit(false);
+    if (!format.empty()) toolkit.SetFormat(format);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    toolkit.LoadFile(filename);
+    return GetElapsed(start);
+}
+
+double BenchLoadSnapshot(const std::string &data, const std::string &format, const std::string &layoutCache)
+{
+    Toolkit toolkit(false);
+    if (!format.empty()) toolkit.SetFormat(format);
+    toolkit.SetLayoutCache(layoutCache);
+    if (!toolkit.LoadData(data)) return 0.0;
+
+    Toolkit cachedToolkit(false);
+    if (!format.empty()) cachedToolkit.SetFormat(format);
+    cachedToolkit.SetLayoutCache(layoutCache);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    cachedToolkit.LoadData(data);
+    return GetElapsed(start);
+}
@@ -0,0 +1,62 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bench_layout.cpp
+// Author:      Verovio contributors
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench.h"
+
+//----------------------------------------------------------------------------
+
+#include <chrono>
+#include <string>
+
+//----------------------------------------------------------------------------
+
+#include "toolkit.h"
+
+using namespace vrv;
+
+//----------------------------------------------------------------------------
+// Layout
+//----------------------------------------------------------------------------
+
+double BenchReuseLayout(const std::string &data)
+{
+    Toolkit toolkit(false);
+    toolkit.SetReuseLayout(true);
+    if (!toolkit.LoadData(data)) return 0.0;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int page = 1; page <= toolkit.GetPageCount(); page++) {
+        toolkit.RenderToSvg(page);
+    }
+    return GetElapsed(start);
+}
+
+double BenchRedoLayout(const std::string &data)
+{
+    Toolkit toolkit(false);
+    if (!toolkit.LoadData(data)) return 0.0;
+    toolkit.RenderToSvg(1);
+
+    toolkit.SetPageWidth(toolkit.GetPageWidth() * 3 / 4);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    toolkit.RedoLayout();
+    return GetElapsed(start);
+}
+
+double BenchLayoutBreaks(const std::string &data)
+{
+    Toolkit toolkit(false);
+    if (!toolkit.LoadData(data)) return 0.0;
+    toolkit.RenderToSvg(1);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int width = 1200; width <= 2400; width += 300) {
+        toolkit.SetPageWidth(width);
+        toolkit.RedoLayout();
+    }
+    return GetElapsed(start);
+}
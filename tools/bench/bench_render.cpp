@@ -0,0 +1,94 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bench_render.cpp
+// Author:      Verovio contributors
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench.h"
+
+//----------------------------------------------------------------------------
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------------
+
+#include "attcomparison.h"
+#include "bboxdevicecontext.h"
+#include "doc.h"
+#include "iomei.h"
+#include "page.h"
+#include "view.h"
+
+using namespace vrv;
+
+//----------------------------------------------------------------------------
+// Bounding boxes and overlaps
+//----------------------------------------------------------------------------
+
+double BenchBBoxRender(const std::string &data, int iterations)
+{
+    Doc doc;
+    MeiInput input(&doc, "");
+    if (!input.ImportString(data)) return 0.0;
+    doc.PrepareDrawing();
+    doc.CastOffDoc();
+
+    View view;
+    view.SetDoc(&doc);
+    view.SetPage(0);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        BBoxDeviceContext bBoxDC(&view, 0, 0);
+        view.SetPage(0, false);
+        view.DrawCurrentPage(&bBoxDC, false);
+    }
+    return (iterations > 0) ? GetElapsed(start) / iterations : 0.0;
+}
+
+double BenchOverlapChecks(const std::string &data, int iterations, bool extents, int &found)
+{
+    found = 0;
+    Doc doc;
+    MeiInput input(&doc, "");
+    if (!input.ImportString(data)) return 0.0;
+    doc.PrepareDrawing();
+    doc.CastOffDoc();
+
+    View view;
+    view.SetDoc(&doc);
+    view.SetPage(0);
+    BBoxDeviceContext bBoxDC(&view, 0, 0);
+    view.DrawCurrentPage(&bBoxDC, false);
+
+    ArrayOfObjects notes;
+    AttComparison matchNote(NOTE);
+    doc.GetDrawingPage()->FindAllChildByAttComparison(&notes, &matchNote);
+    std::vector<BoundingBox *> boxes(notes.begin(), notes.end());
+    HorizontalContentExtents boxExtents;
+    boxExtents.Add(boxes);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        for (auto box : boxes) {
+            if (extents) {
+                int j = boxExtents.FindHorizontalContentOverlap(box);
+                while (j < boxExtents.GetCount()) {
+                    found++;
+                    j = boxExtents.FindHorizontalContentOverlap(box, j + 1);
+                }
+            }
+            else {
+                for (auto other : boxes) {
+                    if (box->HorizontalContentOverlap(other)) found++;
+                }
+            }
+        }
+    }
+    double elapsed = GetElapsed(start);
+    double checks = (double)iterations * boxes.size() * boxes.size();
+    return (elapsed > 0.0) ? checks * 1000.0 / elapsed : 0.0;
+}
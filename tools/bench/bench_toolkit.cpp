@@ -0,0 +1,66 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bench_toolkit.cpp
+// Author:      Verovio contributors
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench.h"
+
+//----------------------------------------------------------------------------
+
+#include <chrono>
+#include <sstream>
+#include <string>
+
+//----------------------------------------------------------------------------
+
+#include "profiler.h"
+#include "toolkit.h"
+
+using namespace vrv;
+
+//----------------------------------------------------------------------------
+// Loading and rendering with the toolkit
+//----------------------------------------------------------------------------
+
+void BenchToolkit(const std::string &data, const std::string &format, std::stringstream &json)
+{
+    Toolkit toolkit(false);
+    if (!format.empty()) toolkit.SetFormat(format);
+
+    toolkit.SetProfile(true);
+    Profiler *profiler = toolkit.GetProfiler();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    bool success = toolkit.LoadData(data);
+    double load = GetElapsed(start);
+
+    json << "            \"success\": " << (success ? "true" : "false") << ",\n";
+    json << "            \"load\": " << load << ",\n";
+    json << "            \"import\": " << profiler->GetTime("Import") << ",\n";
+    json << "            \"prepare-drawing\": " << profiler->GetTime("PrepareDrawing") << ",\n";
+    json << "            \"cast-off\": " << profiler->GetTime("CastOffDoc") + profiler->GetTime("CastOffEncodingDoc")
+         << ",\n";
+
+    json << "            \"render-svg\": [";
+    double renderAll = 0.0;
+    int pageCount = (success) ? toolkit.GetPageCount() : 0;
+    for (int page = 1; page <= pageCount; page++) {
+        start = std::chrono::steady_clock::now();
+        toolkit.RenderToSvg(page);
+        double render = GetElapsed(start);
+        renderAll += render;
+        json << ((page > 1) ? ", " : "") << render;
+    }
+    json << "],\n";
+    json << "            \"render-all\": " << renderAll << ",\n";
+
+    double midi = 0.0;
+    if (success) {
+        start = std::chrono::steady_clock::now();
+        toolkit.RenderToMidi();
+        midi = GetElapsed(start);
+    }
+    json << "            \"render-midi\": " << midi << ",\n";
+    json << "            \"peak-memory\": " << GetPeakMemory();
+}
@@ -0,0 +1,36 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bench_traversal.cpp
+// Author:      Verovio contributors
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench.h"
+
+//----------------------------------------------------------------------------
+
+#include <chrono>
+
+//----------------------------------------------------------------------------
+
+#include "doc.h"
+#include "functorparams.h"
+
+using namespace vrv;
+
+//----------------------------------------------------------------------------
+// Tree traversal
+//----------------------------------------------------------------------------
+
+double BenchTraversal(Doc *doc, int iterations, bool direction, ArrayOfAttComparisons *filters)
+{
+    Functor findByUuid(&Object::FindByUuid);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        FindByUuidParams findByUuidParams;
+        findByUuidParams.m_uuid = "[unspecified]";
+        doc->Process(&findByUuid, &findByUuidParams, NULL, filters, UNLIMITED_DEPTH, direction);
+    }
+    double elapsed = GetElapsed(start);
+    return (elapsed > 0.0) ? iterations * 1000.0 / elapsed : 0.0;
+}
@@ -0,0 +1,214 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bezier_test.cpp
+// Author:      Verovio contributors
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <iostream>
+#include <stdlib.h>
+
+//----------------------------------------------------------------------------
+
+#include "boundingbox.h"
+#include "devicecontextbase.h"
+#include "vrv.h"
+
+using namespace vrv;
+
+//----------------------------------------------------------------------------
+// Reference implementations
+//----------------------------------------------------------------------------
+
+/**
+ * The evaluation of the bezier done before CalcBezierAtPosition stopped using a static table.
+ * The De Casteljau table is of int, so each level is truncated. The new implementation has to give the same results
+ * because the slurs and the ties are positioned with it.
+ */
+int RefCalcBezierAtPosition(const Point bezier[4], int x)
+{
+    int deCasteljau[4][4];
+    double t = 0.0;
+    // avoid division by 0
+    if (bezier[3].x != bezier[0].x) t = (double)(x - bezier[0].x) / (double)(bezier[3].x - bezier[0].x);
+    t = std::min(1.0, std::max(0.0, t));
+
+    for (int i = 0; i < 4; i++) deCasteljau[0][i] = bezier[i].y;
+    for (int j = 1; j < 4; j++) {
+        for (int i = 0; i < 4 - j; i++) {
+            deCasteljau[j][i] = deCasteljau[j - 1][i] * (1 - t) + deCasteljau[j - 1][i + 1] * t;
+        }
+    }
+    return deCasteljau[3][0];
+}
+
+/**
+ * The bounding box of the bezier calculated before ApproximateBezierBoundingBox used the exact extrema.
+ * The curve is sampled at 51 positions.
+ */
+void RefApproximateBezierBoundingBox(
+    const Point bezier[4], Point &pos, int &width, int &height, int &minYPos, int &maxYPos)
+{
+    int minx, miny, maxx, maxy;
+    minx = miny = -VRV_UNSET;
+    maxx = maxy = VRV_UNSET;
+
+    for (int i = 0; i <= 50; i++) {
+        double d = i / 50.0;
+        double px = bezier[0].x + d * (bezier[1].x - bezier[0].x);
+        double py = bezier[0].y + d * (bezier[1].y - bezier[0].y);
+        double qx = bezier[1].x + d * (bezier[2].x - bezier[1].x);
+        double qy = bezier[1].y + d * (bezier[2].y - bezier[1].y);
+        double rx = bezier[2].x + d * (bezier[3].x - bezier[2].x);
+        double ry = bezier[2].y + d * (bezier[3].y - bezier[2].y);
+        double sx = px + d * (qx - px);
+        double sy = py + d * (qy - py);
+        double tx = qx + d * (rx - qx);
+        double ty = qy + d * (ry - qy);
+        int x = sx + d * (tx - sx);
+        int y = sy + d * (ty - sy);
+        minx = std::min(minx, x);
+        if (miny > y) {
+            miny = y;
+            minYPos = (bezier[3].x - bezier[0].x) * d;
+        }
+        maxx = std::max(maxx, x);
+        if (maxy < y) {
+            maxy = y;
+            maxYPos = (bezier[3].x - bezier[0].x) * d;
+        }
+    }
+    pos.x = minx;
+    pos.y = miny;
+    width = maxx - minx;
+    height = maxy - miny;
+}
+
+/**
+ * Return the y of the bezier at the parameter t (not truncated).
+ */
+double RefBezierY(const Point bezier[4], double t)
+{
+    double mt = 1.0 - t;
+    return mt * mt * mt * bezier[0].y + 3.0 * mt * mt * t * bezier[1].y + 3.0 * mt * t * t * bezier[2].y
+        + t * t * t * bezier[3].y;
+}
+
+//----------------------------------------------------------------------------
+// Curves
+//----------------------------------------------------------------------------
+
+/**
+ * A linear congruential generator, so that the curves are the same on all platforms.
+ */
+int Random(unsigned int &seed, int range)
+{
+    seed = seed * 1103515245 + 12345;
+    return (int)((seed >> 16) % (unsigned int)range);
+}
+
+/**
+ * Generate a curve with the proportions of a slur or a tie (in MEI units, with a unit of 90).
+ */
+void GenerateBezier(unsigned int &seed, Point bezier[4])
+{
+    int x0 = Random(seed, 20000);
+    int y0 = Random(seed, 10000) - 5000;
+    int width = Random(seed, 5000);
+    int height = Random(seed, 1200) - 600;
+    bezier[0] = Point(x0, y0);
+    bezier[1] = Point(x0 + Random(seed, width + 1), y0 + height);
+    bezier[2] = Point(x0 + Random(seed, width + 1), y0 + height + Random(seed, 200) - 100);
+    bezier[3] = Point(x0 + width, y0 + Random(seed, 800) - 400);
+}
+
+//----------------------------------------------------------------------------
+// Tests
+//----------------------------------------------------------------------------
+
+/**
+ * CalcBezierAtPosition and CalcBezierAtPositions have to give exactly the results of the reference, including for
+ * positions before and after the curve.
+ */
+int TestCalcBezierAtPositions(int curves)
+{
+    const int count = 16;
+    int errors = 0;
+    unsigned int seed = 1;
+    for (int i = 0; i < curves; i++) {
+        Point bezier[4];
+        GenerateBezier(seed, bezier);
+        int width = bezier[3].x - bezier[0].x;
+        int xs[count];
+        int ys[count];
+        for (int j = 0; j < count; j++) xs[j] = bezier[0].x - 100 + Random(seed, width + 201);
+        BoundingBox::CalcBezierAtPositions(bezier, xs, ys, count);
+        for (int j = 0; j < count; j++) {
+            int expected = RefCalcBezierAtPosition(bezier, xs[j]);
+            if ((ys[j] != expected) || (BoundingBox::CalcBezierAtPosition(bezier, xs[j]) != expected)) {
+                if (errors++ < 10) {
+                    std::cerr << "CalcBezierAtPositions: curve " << i << " at " << xs[j] << " gives " << ys[j]
+                              << " instead of " << expected << std::endl;
+                }
+            }
+        }
+    }
+    return errors;
+}
+
+/**
+ * ApproximateBezierBoundingBox uses the exact extrema of the curve (the roots of its derivative) instead of the 51
+ * samples of the reference. The extrema of the samples are at most 1 unit away from the exact ones: the sampled
+ * positions are 1/50 apart, which keeps the gap between the sampled and the exact extremum of curves of this size
+ * below 0.5, and both are truncated to int, which can add 1 on each side. The layout can therefore change by 1 unit
+ * where a slur bounding box is the limiting one.
+ * The positions of the extrema in y can be further away from the sampled ones because the curve is flat around them
+ * and the first sample of the truncated extremum is taken. The curve at the new positions (not truncated) has to reach
+ * the sampled extrema (truncated) within 2 units.
+ */
+int TestApproximateBezierBoundingBox(int curves)
+{
+    int errors = 0;
+    unsigned int seed = 2;
+    for (int i = 0; i < curves; i++) {
+        Point bezier[4];
+        GenerateBezier(seed, bezier);
+        Point pos, refPos;
+        int width, height, minYPos, maxYPos;
+        int refWidth, refHeight, refMinYPos, refMaxYPos;
+        BoundingBox::ApproximateBezierBoundingBox(bezier, pos, width, height, minYPos, maxYPos);
+        RefApproximateBezierBoundingBox(bezier, refPos, refWidth, refHeight, refMinYPos, refMaxYPos);
+        int diff = std::max(abs(pos.x - refPos.x), abs(pos.y - refPos.y));
+        diff = std::max(diff, abs((pos.x + width) - (refPos.x + refWidth)));
+        diff = std::max(diff, abs((pos.y + height) - (refPos.y + refHeight)));
+        // The positions are truncated to int and are checked only for curves wide enough for it not to matter
+        double curveWidth = bezier[3].x - bezier[0].x;
+        double minY = (curveWidth < 100) ? refPos.y : RefBezierY(bezier, minYPos / curveWidth);
+        double maxY = (curveWidth < 100) ? refPos.y + refHeight : RefBezierY(bezier, maxYPos / curveWidth);
+        if ((diff > 1) || (minY > refPos.y + 2) || (maxY < refPos.y + refHeight - 2)) {
+            if (errors++ < 10) {
+                std::cerr << "ApproximateBezierBoundingBox: curve " << i << " differs by " << diff << " (min "
+                          << minY << " at " << minYPos << " instead of " << refPos.y << ", max " << maxY << " at "
+                          << maxYPos << " instead of " << refPos.y + refHeight << ")" << std::endl;
+            }
+        }
+    }
+    return errors;
+}
+
+//----------------------------------------------------------------------------
+// Main
+//----------------------------------------------------------------------------
+
+int main(int argc, char **argv)
+{
+    int curves = (argc > 1) ? atoi(argv[1]) : 100000;
+
+    int errors = TestCalcBezierAtPositions(curves);
+    std::cout << "CalcBezierAtPositions: " << errors << " error(s)" << std::endl;
+    int bboxErrors = TestApproximateBezierBoundingBox(curves);
+    std::cout << "ApproximateBezierBoundingBox: " << bboxErrors << " error(s)" << std::endl;
+
+    return ((errors + bboxErrors) > 0) ? 1 : 0;
+}
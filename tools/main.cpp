@@ -19,6 +19,7 @@
 
 //----------------------------------------------------------------------------
 
+#include "c_wrapper.h"
 #include "style.h"
 #include "toolkit.h"
 #include "vrv.h"
@@ -122,14 +123,25 @@ void display_usage()
     cerr << " --ignore-layout            Ignore all encoded layout information (if any)" << endl;
     cerr << "                            and fully recalculate the layout" << endl;
 
+    cerr << " --layout-cache=DIR         Cache the layout of the documents in the directory and reuse it" << endl;
+    cerr << "                            when the same data is loaded with the same options" << endl;
+
     cerr << " --mdiv-xpath-query=QR      Set the xPath query for selecting the <mdiv> to be rendered;" << endl;
     cerr << "                            only one <mdiv> can be rendered" << endl;
 
+    cerr << " --measure-range=N1-N2      Load and lay out only the measures with @n from N1 to N2 (MEI only)" << endl;
+
     cerr << " --no-layout                Ignore all encoded layout information (if any)" << endl;
     cerr << "                            and output one single page with one single system" << endl;
 
     cerr << " --page=PAGE                Select the page to engrave (default is 1)" << endl;
 
+    cerr << " --profile                  Write a JSON report of the time spent in each processing phase" << endl;
+    cerr << "                            to the standard error" << endl;
+
+    cerr << " --reuse-layout             Reuse the horizontal layout of the measures calculated for" << endl;
+    cerr << "                            the page breaks when rendering the pages" << endl;
+
     cerr << " --spacing-linear=SP        Specify the linear spacing factor (default is " << DEFAULT_SPACING_LINEAR
          << ")" << endl;
 
@@ -140,6 +152,8 @@ void display_usage()
 
     cerr << " --spacing-system=SP        Specify the spacing above each system (in MEI vu)" << endl;
 
+    cerr << " --staff-selection=N,N      Load and lay out only the staves with the given @n (MEI only)" << endl;
+
     cerr << " --xml-id-seed=INT          Seed the random number generator for XML IDs" << endl;
 
     // Debugging options
@@ -172,6 +186,8 @@ int main(int argc, char **argv)
     int even_note_spacing = 0;
     int show_bounding_boxes = 0;
     int page = 1;
+    int profile = 0;
+    int reuse_layout = 0;
     int show_help = 0;
     int show_version = 0;
 
@@ -193,15 +209,19 @@ int main(int argc, char **argv)
         { "even-note-spacing", no_argument, &even_note_spacing, 1 }, { "font", required_argument, 0, 0 },
         { "format", required_argument, 0, 'f' }, { "help", no_argument, &show_help, 1 },
         { "hum-type", no_argument, &hum_type, 1 }, { "ignore-layout", no_argument, &ignore_layout, 1 },
-        { "mdiv-xpath-query", required_argument, 0, 0 }, { "no-layout", no_argument, &no_layout, 1 },
-        { "no-mei-hdr", no_argument, &no_mei_hdr, 1 }, { "no-justification", no_argument, &no_justification, 1 },
-        { "outfile", required_argument, 0, 'o' }, { "page", required_argument, 0, 0 },
-        { "page-height", required_argument, 0, 'h' }, { "page-width", required_argument, 0, 'w' },
-        { "resources", required_argument, 0, 'r' }, { "scale", required_argument, 0, 's' },
-        { "show-bounding-boxes", no_argument, &show_bounding_boxes, 1 }, { "spacing-linear", required_argument, 0, 0 },
-        { "spacing-non-linear", required_argument, 0, 0 }, { "spacing-staff", required_argument, 0, 0 },
-        { "spacing-system", required_argument, 0, 0 }, { "type", required_argument, 0, 't' },
-        { "version", no_argument, &show_version, 1 }, { "xml-id-seed", required_argument, 0, 0 }, { 0, 0, 0, 0 } };
+        { "layout-cache", required_argument, 0, 0 }, { "mdiv-xpath-query", required_argument, 0, 0 },
+        { "measure-range", required_argument, 0, 0 },
+        { "no-layout", no_argument, &no_layout, 1 }, { "no-mei-hdr", no_argument, &no_mei_hdr, 1 },
+        { "no-justification", no_argument, &no_justification, 1 }, { "outfile", required_argument, 0, 'o' },
+        { "page", required_argument, 0, 0 }, { "page-height", required_argument, 0, 'h' },
+        { "page-width", required_argument, 0, 'w' }, { "profile", no_argument, &profile, 1 },
+        { "resources", required_argument, 0, 'r' }, { "reuse-layout", no_argument, &reuse_layout, 1 },
+        { "scale", required_argument, 0, 's' }, { "show-bounding-boxes", no_argument, &show_bounding_boxes, 1 },
+        { "spacing-linear", required_argument, 0, 0 }, { "spacing-non-linear", required_argument, 0, 0 },
+        { "spacing-staff", required_argument, 0, 0 }, { "spacing-system", required_argument, 0, 0 },
+        { "staff-selection", required_argument, 0, 0 },
+        { "type", required_argument, 0, 't' }, { "version", no_argument, &show_version, 1 },
+        { "xml-id-seed", required_argument, 0, 0 }, { 0, 0, 0, 0 } };
 
     int option_index = 0;
     while ((c = getopt_long(argc, argv, "b:f:h:o:p:r:s:t:w:v", long_options, &option_index)) != -1) {
@@ -220,10 +240,18 @@ int main(int argc, char **argv)
                 if (strcmp(long_options[option_index].name, "font") == 0) {
                     font = string(optarg);
                 }
+                else if (strcmp(long_options[option_index].name, "layout-cache") == 0) {
+                    toolkit.SetLayoutCache(string(optarg));
+                }
                 else if (strcmp(long_options[option_index].name, "mdiv-xpath-query") == 0) {
                     cout << string(optarg) << endl;
                     toolkit.SetMdivXPathQuery(string(optarg));
                 }
+                else if (strcmp(long_options[option_index].name, "measure-range") == 0) {
+                    if (!toolkit.SetMeasureRange(string(optarg))) {
+                        exit(1);
+                    }
+                }
                 else if (strcmp(long_options[option_index].name, "page") == 0) {
                     page = atoi(optarg);
                 }
@@ -247,6 +275,11 @@ int main(int argc, char **argv)
                         exit(1);
                     }
                 }
+                else if (strcmp(long_options[option_index].name, "staff-selection") == 0) {
+                    if (!toolkit.SetStaffSelection(string(optarg))) {
+                        exit(1);
+                    }
+                }
                 else if (strcmp(long_options[option_index].name, "xml-id-seed") == 0) {
                     Object::SeedUuid(atoi(optarg));
                 }
@@ -326,7 +359,9 @@ int main(int argc, char **argv)
     toolkit.SetIgnoreLayout(ignore_layout);
     toolkit.SetNoJustification(no_justification);
     toolkit.SetEvenNoteSpacing(even_note_spacing);
+    toolkit.SetReuseLayout(reuse_layout);
     toolkit.SetShowBoundingBoxes(show_bounding_boxes);
+    toolkit.SetProfile(profile);
 
     if (optind <= argc - 1) {
         infile = string(argv[optind]);
@@ -420,6 +455,9 @@ int main(int argc, char **argv)
         to = toolkit.GetPageCount() + 1;
     }
 
+    // The standard output is written through the C interface, with one buffer reused for all the pages
+    vrvBuffer buffer = { NULL, 0, 0 };
+
     if (outformat == "svg") {
         int p;
         for (p = from; p < to; p++) {
@@ -429,7 +467,11 @@ int main(int argc, char **argv)
             }
             cur_outfile += ".svg";
             if (std_output) {
-                cout << toolkit.RenderToSvg(p);
+                if (!vrvToolkit_renderPageToBuffer(&toolkit, p, NULL, &buffer)) {
+                    cerr << "Unable to render page " << p << "." << endl;
+                    exit(1);
+                }
+                cout.write(buffer.data, buffer.length);
             }
             else if (!toolkit.RenderToSvgFile(cur_outfile, p)) {
                 cerr << "Unable to write SVG to " << cur_outfile << "." << endl;
@@ -443,8 +485,12 @@ int main(int argc, char **argv)
     else if (outformat == "midi") {
         outfile += ".mid";
         if (std_output) {
-            cerr << "Midi cannot write to standard output." << endl;
-            exit(1);
+            // The binary MIDI file, which can contain null bytes
+            if (!vrvToolkit_renderToMidiDataToBuffer(&toolkit, NULL, &buffer)) {
+                cerr << "Unable to render the MIDI." << endl;
+                exit(1);
+            }
+            cout.write(buffer.data, buffer.length);
         }
         else if (!toolkit.RenderToMidiFile(outfile)) {
             cerr << "Unable to write MIDI to " << outfile << "." << endl;
@@ -487,7 +533,11 @@ int main(int argc, char **argv)
         }
         else {
             if (std_output) {
-                cout << toolkit.GetMEI(page);
+                if (!vrvToolkit_getMEIToBuffer(&toolkit, page, false, &buffer)) {
+                    cerr << "Unable to write the MEI of page " << page << "." << endl;
+                    exit(1);
+                }
+                cout.write(buffer.data, buffer.length);
             }
             else {
                 cerr << "MEI output of one page is available only to standard output." << endl;
@@ -496,5 +546,11 @@ int main(int argc, char **argv)
         }
     }
 
+    vrvBuffer_free(&buffer);
+
+    if (profile) {
+        cerr << toolkit.GetProfileReport();
+    }
+
     return 0;
 }
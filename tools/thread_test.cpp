@@ -0,0 +1,186 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        thread_test.cpp
+// Author:      Verovio contributors
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <ctype.h>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <getopt.h>
+#else
+#include "win_getopt.h"
+#endif
+
+//----------------------------------------------------------------------------
+
+#include "toolkit.h"
+#include "vrv.h"
+
+using namespace vrv;
+
+//----------------------------------------------------------------------------
+// Jobs
+//----------------------------------------------------------------------------
+
+/**
+ * Remove the ids from the SVG since they are generated randomly and are not the same from one load to the other.
+ * The ids are in the id attributes and in the class of some elements (e.g., "boundaryEnd section-0000001990956839").
+ */
+std::string StripIds(const std::string &svg)
+{
+    std::string output;
+    output.reserve(svg.size());
+    size_t pos = 0;
+    size_t start;
+    while ((start = svg.find(" id=\"", pos)) != std::string::npos) {
+        size_t end = svg.find('"', start + 5);
+        if (end == std::string::npos) break;
+        output.append(svg, pos, start - pos);
+        pos = end + 1;
+    }
+    output.append(svg, pos, std::string::npos);
+
+    // The generated ids end with 10 digits
+    std::string stripped;
+    stripped.reserve(output.size());
+    for (size_t i = 0; i < output.size(); i++) {
+        stripped.push_back(output[i]);
+        if (output[i] != '-') continue;
+        size_t digits = i + 1;
+        while ((digits < output.size()) && isdigit(output[digits])) digits++;
+        if (digits - i > 10) i = digits - 1;
+    }
+    return stripped;
+}
+
+/**
+ * Load the data with a new toolkit and render all its pages.
+ * The toolkit is created within the job so that the fonts are initialized concurrently by the threads.
+ */
+std::string RunJob(const std::string &data)
+{
+    Toolkit toolkit;
+    if (!toolkit.LoadData(data)) return "";
+    std::string svg;
+    for (int i = 1; i <= toolkit.GetPageCount(); i++) {
+        svg += toolkit.RenderToSvg(i);
+    }
+    return StripIds(svg);
+}
+
+/**
+ * Run every job with the given step, i.e., the share of the jobs of one thread.
+ */
+void RunJobs(const std::vector<std::string> *data, std::vector<std::string> *outputs, int first, int step)
+{
+    for (int i = first; i < (int)data->size(); i += step) {
+        (*outputs)[i] = RunJob((*data)[i]);
+    }
+}
+
+double GetElapsed(const std::chrono::steady_clock::time_point &start)
+{
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+//----------------------------------------------------------------------------
+// Main
+//----------------------------------------------------------------------------
+
+void display_usage()
+{
+    std::cerr << "Usage: verovio-thread-test [-r PATH] [-t THREADS] [-n REPEAT] file..." << std::endl << std::endl;
+    std::cerr << "Load and render the files with one toolkit per job, first in one thread and then in several threads"
+              << std::endl;
+    std::cerr << "in parallel. The output has to be the same and the speedup is given." << std::endl << std::endl;
+    std::cerr << " -r, --resources=PATH       Path to SVG resources (default is " << Resources::GetPath() << ")"
+              << std::endl;
+    std::cerr << " -t, --threads=INTEGER      Number of threads (default is the number of cores, at least 2)"
+              << std::endl;
+    std::cerr << " -n, --repeat=INTEGER       Number of times each file is loaded and rendered (default is 8)"
+              << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    int threads = std::max(2, (int)std::thread::hardware_concurrency());
+    int repeat = 8;
+
+    static struct option long_options[] = { { "resources", required_argument, 0, 'r' },
+        { "threads", required_argument, 0, 't' }, { "repeat", required_argument, 0, 'n' }, { 0, 0, 0, 0 } };
+
+    int c;
+    int option_index = 0;
+    while ((c = getopt_long(argc, argv, "r:t:n:", long_options, &option_index)) != -1) {
+        switch (c) {
+            case 'r': Resources::SetPath(optarg); break;
+            case 't': threads = std::max(1, atoi(optarg)); break;
+            case 'n': repeat = std::max(1, atoi(optarg)); break;
+            default: display_usage(); return 1;
+        }
+    }
+
+    if (optind >= argc) {
+        display_usage();
+        return 1;
+    }
+
+    std::vector<std::string> data;
+    for (int i = optind; i < argc; i++) {
+        std::ifstream file(argv[i], std::ios::in | std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "File " << argv[i] << " could not be read" << std::endl;
+            return 1;
+        }
+        std::stringstream content;
+        content << file.rdbuf();
+        for (int j = 0; j < repeat; j++) data.push_back(content.str());
+    }
+
+    // The warnings of the files would be repeated by each job
+    DisableLog();
+
+    std::vector<std::string> expected(data.size());
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    RunJobs(&data, &expected, 0, 1);
+    double sequential = GetElapsed(start);
+
+    std::vector<std::string> outputs(data.size());
+    std::vector<std::thread> workers;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < threads; i++) {
+        workers.push_back(std::thread(RunJobs, &data, &outputs, i, threads));
+    }
+    for (auto &worker : workers) worker.join();
+    double parallel = GetElapsed(start);
+
+    int errors = 0;
+    for (int i = 0; i < (int)data.size(); i++) {
+        if (expected[i].empty()) {
+            std::cerr << "Job " << i << " (" << argv[optind + i / repeat] << ") has no output" << std::endl;
+            errors++;
+        }
+        else if (outputs[i] != expected[i]) {
+            std::cerr << "Job " << i << " (" << argv[optind + i / repeat] << ") differs in parallel" << std::endl;
+            errors++;
+        }
+    }
+
+    std::cout << data.size() << " jobs: " << sequential << "s in 1 thread, " << parallel << "s in " << threads
+              << " threads (speedup " << sequential / parallel << ")" << std::endl;
+    std::cout << errors << " error(s)" << std::endl;
+
+    return (errors > 0) ? 1 : 0;
+}
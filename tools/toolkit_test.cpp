@@ -0,0 +1,520 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        toolkit_test.cpp
+// Author:      Verovio contributors
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <ctype.h>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <getopt.h>
+#else
+#include "win_dirent.h"
+#include "win_getopt.h"
+#endif
+
+//----------------------------------------------------------------------------
+
+#include "profiler.h"
+#include "toolkit.h"
+#include "vrv.h"
+
+using namespace vrv;
+
+//----------------------------------------------------------------------------
+// Helpers
+//----------------------------------------------------------------------------
+
+/**
+ * Remove the ids from the SVG since the ones of the pages and of the systems change every time the layout is redone.
+ * The ids are in the id attributes and in the class of some elements (e.g., "boundaryEnd section-0000001990956839").
+ */
+std::string StripIds(const std::string &svg)
+{
+    std::string output;
+    output.reserve(svg.size());
+    size_t pos = 0;
+    size_t start;
+    while ((start = svg.find(" id=\"", pos)) != std::string::npos) {
+        size_t end = svg.find('"', start + 5);
+        if (end == std::string::npos) break;
+        output.append(svg, pos, start - pos);
+        pos = end + 1;
+    }
+    output.append(svg, pos, std::string::npos);
+
+    // The generated ids end with 10 digits
+    std::string stripped;
+    stripped.reserve(output.size());
+    for (size_t i = 0; i < output.size(); i++) {
+        stripped.push_back(output[i]);
+        if (output[i] != '-') continue;
+        size_t digits = i + 1;
+        while ((digits < output.size()) && isdigit(output[digits])) digits++;
+        if (digits - i > 10) i = digits - 1;
+    }
+    return stripped;
+}
+
+std::string RenderAllPages(Toolkit &toolkit)
+{
+    std::string svg;
+    for (int i = 1; i <= toolkit.GetPageCount(); i++) {
+        svg += toolkit.RenderToSvg(i);
+    }
+    return StripIds(svg);
+}
+
+std::string ReadFile(const std::string &filename)
+{
+    std::ifstream in(filename.c_str(), std::ios::in | std::ios::binary);
+    std::stringstream content;
+    content << in.rdbuf();
+    return content.str();
+}
+
+void WriteFile(const std::string &filename, const std::string &content)
+{
+    std::ofstream out(filename.c_str(), std::ios::out | std::ios::binary);
+    out << content;
+}
+
+/**
+ * Return the layout snapshots in the directory, i.e., the files ending with .mei.
+ */
+std::vector<std::string> GetSnapshots(const std::string &layoutCache)
+{
+    std::vector<std::string> snapshots;
+    ::DIR *dir = opendir(layoutCache.c_str());
+    if (!dir) return snapshots;
+    dirent *entry;
+    while ((entry = readdir(dir))) {
+        std::string name = entry->d_name;
+        if ((name.size() > 4) && (name.compare(name.size() - 4, 4, ".mei") == 0)) {
+            snapshots.push_back(layoutCache + "/" + name);
+        }
+    }
+    closedir(dir);
+    return snapshots;
+}
+
+//----------------------------------------------------------------------------
+// Tests
+//----------------------------------------------------------------------------
+
+/**
+ * Render the first page, redo the layout with another page width and check that the measure widths of the cast-off
+ * were reused, i.e., that fewer measures were aligned again than when loading. The result has to be the same as
+ * loading the file with that page width.
+ */
+int TestRedoLayout(const std::string &file)
+{
+    Toolkit toolkit;
+    toolkit.SetPageWidth(1000);
+    toolkit.SetProfile(true);
+    if (!toolkit.LoadFile(file)) return 1;
+    long loadNodes = toolkit.GetProfiler()->GetNodes("AlignHorizontally");
+    toolkit.RenderToSvg(1);
+
+    toolkit.GetProfiler()->Reset();
+    toolkit.SetPageWidth(1700);
+    toolkit.RedoLayout();
+    long redoNodes = toolkit.GetProfiler()->GetNodes("AlignHorizontally");
+
+    int errors = 0;
+    if (redoNodes >= loadNodes) {
+        std::cerr << "The cast-off widths were not reused (" << redoNodes << " nodes aligned again, " << loadNodes
+                  << " when loading)" << std::endl;
+        errors++;
+    }
+
+    Toolkit expected;
+    expected.SetPageWidth(1700);
+    if (!expected.LoadFile(file)) return errors + 1;
+    if (RenderAllPages(toolkit) != RenderAllPages(expected)) {
+        std::cerr << "The layout differs from the one of the file loaded with the same page width" << std::endl;
+        errors++;
+    }
+    return errors;
+}
+
+/**
+ * Render the first page and redo the layout for several page widths, as Toolkit::GetLayoutBreaks does. Only the first
+ * width has to align measures again and the layout restored for the initial width has to be the same as loading the
+ * file with it.
+ */
+int TestLayoutBreaks(const std::string &file)
+{
+    Toolkit toolkit;
+    toolkit.SetProfile(true);
+    if (!toolkit.LoadFile(file)) return 1;
+    toolkit.RenderToSvg(1);
+
+    int errors = 0;
+    int pageWidth = toolkit.GetPageWidth();
+    for (int width = 1200; width <= 2400; width += 300) {
+        toolkit.GetProfiler()->Reset();
+        toolkit.SetPageWidth(width);
+        toolkit.RedoLayout();
+        if ((width > 1200) && (toolkit.GetProfiler()->GetNodes("AlignHorizontally") > 0)) {
+            std::cerr << "The measures were aligned again for the page width " << width << std::endl;
+            errors++;
+        }
+    }
+    toolkit.SetPageWidth(pageWidth);
+    toolkit.RedoLayout();
+
+    Toolkit expected;
+    if (!expected.LoadFile(file)) return errors + 1;
+    if (RenderAllPages(toolkit) != RenderAllPages(expected)) {
+        std::cerr << "The layout differs from the one of the file loaded with the same page width" << std::endl;
+        errors++;
+    }
+    return errors;
+}
+
+/**
+ * Load the file with a layout cache and corrupt the snapshot written in several ways. Loading the file again has to
+ * discard the snapshot and give the same result as without it. The snapshot written again has to be used by the next
+ * load.
+ */
+int TestSnapshot(const std::string &file, const std::string &layoutCache)
+{
+    std::vector<std::string> snapshots = GetSnapshots(layoutCache);
+    for (auto const &snapshot : snapshots) std::remove(snapshot.c_str());
+
+    Toolkit toolkit;
+    toolkit.SetLayoutCache(layoutCache);
+    if (!toolkit.LoadFile(file)) return 1;
+    std::string expected = RenderAllPages(toolkit);
+    snapshots = GetSnapshots(layoutCache);
+    if (snapshots.size() != 1) {
+        std::cerr << "The layout snapshot was not written in '" << layoutCache << "'" << std::endl;
+        return 1;
+    }
+    std::string snapshot = ReadFile(snapshots.at(0));
+
+    // The header has three lines: the version and the key, the system sizes and the length of the Humdrum buffer
+    size_t sizesLine = snapshot.find('\n') + 1;
+    size_t humdrumLine = snapshot.find('\n', sizesLine) + 1;
+    size_t content = snapshot.find('\n', humdrumLine) + 1;
+    std::vector<std::string> corrupted;
+    corrupted.push_back(snapshot.substr(0, humdrumLine) + "2000000000\n" + snapshot.substr(content));
+    corrupted.push_back(snapshot.substr(0, humdrumLine) + "12x\n" + snapshot.substr(content));
+    corrupted.push_back(snapshot.substr(0, humdrumLine) + "-1\n" + snapshot.substr(content));
+    corrupted.push_back(snapshot.substr(0, sizesLine) + "2000000000 ; 3\n" + snapshot.substr(humdrumLine));
+    corrupted.push_back(snapshot.substr(0, sizesLine) + "3x 4\n" + snapshot.substr(humdrumLine));
+    corrupted.push_back(snapshot.substr(0, sizesLine + 1));
+    corrupted.push_back(snapshot.substr(0, snapshot.size() / 2));
+
+    int errors = 0;
+    for (int i = 0; i < (int)corrupted.size(); i++) {
+        WriteFile(snapshots.at(0), corrupted.at(i));
+        Toolkit corruptedToolkit;
+        corruptedToolkit.SetLayoutCache(layoutCache);
+        if (!corruptedToolkit.LoadFile(file) || (RenderAllPages(corruptedToolkit) != expected)) {
+            std::cerr << "The corrupted snapshot " << i << " was not discarded" << std::endl;
+            errors++;
+            continue;
+        }
+
+        Toolkit snapshotToolkit;
+        snapshotToolkit.SetLayoutCache(layoutCache);
+        snapshotToolkit.SetProfile(true);
+        if (!snapshotToolkit.LoadFile(file) || (snapshotToolkit.GetProfiler()->GetNodes("LoadSnapshot") == 0)
+            || (RenderAllPages(snapshotToolkit) != expected)) {
+            std::cerr << "The snapshot was not written again after the corrupted snapshot " << i << std::endl;
+            errors++;
+        }
+    }
+
+    std::remove(snapshots.at(0).c_str());
+    return errors;
+}
+
+/**
+ * An excerpt with two staves. The tie of the first staff has no @staff and ends after the second measure.
+ */
+const char *excerptData
+    = "<mei xmlns=\"http://www.music-encoding.org/ns/mei\" meiversion=\"3.0.0\"><music><body><mdiv><score>"
+      "<scoreDef><staffGrp>"
+      "<staffDef n=\"1\" lines=\"5\" clef.shape=\"G\" clef.line=\"2\" meter.count=\"4\" meter.unit=\"4\"/>"
+      "<staffDef n=\"2\" lines=\"5\" clef.shape=\"F\" clef.line=\"4\" meter.count=\"4\" meter.unit=\"4\"/>"
+      "</staffGrp></scoreDef><section>"
+      "<measure n=\"1\">"
+      "<staff n=\"1\"><layer n=\"1\"><note xml:id=\"n1a\" pname=\"c\" oct=\"5\" dur=\"1\"/></layer></staff>"
+      "<staff n=\"2\"><layer n=\"1\"><note xml:id=\"n1b\" pname=\"c\" oct=\"3\" dur=\"1\"/></layer></staff>"
+      "</measure>"
+      "<measure n=\"2\">"
+      "<staff n=\"1\"><layer n=\"1\"><note xml:id=\"n2a\" pname=\"e\" oct=\"5\" dur=\"2\"/>"
+      "<note xml:id=\"n2b\" pname=\"d\" oct=\"5\" dur=\"2\"/></layer></staff>"
+      "<staff n=\"2\"><layer n=\"1\"><note xml:id=\"n2c\" pname=\"e\" oct=\"3\" dur=\"2\"/>"
+      "<note xml:id=\"n2d\" pname=\"e\" oct=\"3\" dur=\"2\"/></layer></staff>"
+      "<slur xml:id=\"slur1\" staff=\"1\" startid=\"#n2a\" endid=\"#n2b\"/>"
+      "<tie xml:id=\"tie1\" startid=\"#n2b\" endid=\"#n3a\"/>"
+      "<tie xml:id=\"tie2\" startid=\"#n2c\" endid=\"#n2d\"/>"
+      "</measure>"
+      "<measure n=\"3\" right=\"end\">"
+      "<staff n=\"1\"><layer n=\"1\"><note xml:id=\"n3a\" pname=\"d\" oct=\"5\" dur=\"1\"/></layer></staff>"
+      "<staff n=\"2\"><layer n=\"1\"><note xml:id=\"n3b\" pname=\"c\" oct=\"3\" dur=\"1\"/></layer></staff>"
+      "</measure>"
+      "</section></score></mdiv></body></music></mei>";
+
+/**
+ * Check that only 'N' and 'N-M' are accepted as a measure range, that a staff selection with a staff not in the data
+ * fails and that the control elements are dropped with the staff they start in.
+ */
+int TestExcerpt()
+{
+    int errors = 0;
+    Toolkit toolkit;
+    const char *validRanges[] = { "3", "2-4", "12-12" };
+    for (auto range : validRanges) {
+        if (!toolkit.SetMeasureRange(range)) {
+            std::cerr << "The measure range '" << range << "' was refused" << std::endl;
+            errors++;
+        }
+    }
+    const char *invalidRanges[] = { "3x", "5-", "-5", "0", "4-2", "3-4-5", "3--4", " 3", "+3", "3-+4", "x",
+        "99999999999" };
+    for (auto range : invalidRanges) {
+        if (toolkit.SetMeasureRange(range)) {
+            std::cerr << "The measure range '" << range << "' was accepted" << std::endl;
+            errors++;
+        }
+    }
+
+    const char *invalidSelections[] = { "9", "1,9" };
+    for (auto selection : invalidSelections) {
+        Toolkit selectionToolkit;
+        selectionToolkit.SetStaffSelection(selection);
+        if (selectionToolkit.LoadData(excerptData)) {
+            std::cerr << "The staff selection '" << selection << "' was loaded" << std::endl;
+            errors++;
+        }
+    }
+
+    Toolkit excerptToolkit;
+    excerptToolkit.SetStaffSelection("2");
+    excerptToolkit.SetMeasureRange("2-2");
+    if (!excerptToolkit.LoadData(excerptData)) return errors + 1;
+    std::string mei = excerptToolkit.GetMEI(0, true);
+    if ((mei.find("\"slur1\"") != std::string::npos) || (mei.find("\"tie1\"") != std::string::npos)) {
+        std::cerr << "The control elements of the first staff were not dropped" << std::endl;
+        errors++;
+    }
+    if ((mei.find("\"n2c\"") == std::string::npos) || (mei.find("\"tie2\"") == std::string::npos)) {
+        std::cerr << "The content of the second staff was dropped" << std::endl;
+        errors++;
+    }
+    return errors;
+}
+
+/**
+ * Perform a batch of editor actions with one failing after some were performed and check that the document is the
+ * same as before the batch, and that it can still be edited. A batch without failure has to be performed.
+ */
+int TestEditBatch()
+{
+    Toolkit toolkit;
+    if (!toolkit.LoadData(excerptData)) return 1;
+    toolkit.RenderToSvg(1);
+    std::string mei = toolkit.GetMEI(0, true);
+    std::string svg = RenderAllPages(toolkit);
+
+    int errors = 0;
+    toolkit.BeginEditBatch();
+    bool performed = toolkit.Set("n1a", "pname", "g") && toolkit.Insert("slur", "n1a", "n2a")
+        && toolkit.Set("n1b", "stem.dir", "down");
+    if (!performed) {
+        std::cerr << "The editor actions before the failing one were not performed" << std::endl;
+        errors++;
+    }
+    if (toolkit.Set("n3a", "unknown", "1")) {
+        std::cerr << "The editor action with an unknown attribute was performed" << std::endl;
+        errors++;
+    }
+    toolkit.EndEditBatch(true);
+    if (toolkit.GetMEI(0, true) != mei) {
+        std::cerr << "The MEI differs from the one before the failed batch" << std::endl;
+        errors++;
+    }
+    if (RenderAllPages(toolkit) != svg) {
+        std::cerr << "The rendering differs from the one before the failed batch" << std::endl;
+        errors++;
+    }
+
+    toolkit.BeginEditBatch();
+    performed = toolkit.Set("n1a", "pname", "g") && toolkit.Set("n1b", "stem.dir", "down");
+    toolkit.EndEditBatch(!performed);
+    mei = toolkit.GetMEI(0, true);
+    if (!performed || (mei.find("pname=\"g\"") == std::string::npos)
+        || (mei.find("stem.dir=\"down\"") == std::string::npos)) {
+        std::cerr << "The batch was not performed after the failed one" << std::endl;
+        errors++;
+    }
+    return errors;
+}
+
+/**
+ * Four measures with lyrics. The word of the first measure continues in the second one, so its connector crosses the
+ * beginning of a range starting with the second measure.
+ */
+const char *lyricsData
+    = "<mei xmlns=\"http://www.music-encoding.org/ns/mei\" meiversion=\"3.0.0\"><music><body><mdiv><score>"
+      "<scoreDef><staffGrp>"
+      "<staffDef n=\"1\" lines=\"5\" clef.shape=\"G\" clef.line=\"2\" meter.count=\"4\" meter.unit=\"4\"/>"
+      "</staffGrp></scoreDef><section>"
+      "<measure xml:id=\"m1\" n=\"1\"><staff n=\"1\"><layer n=\"1\">"
+      "<note xml:id=\"n1a\" pname=\"c\" oct=\"5\" dur=\"2\"><verse n=\"1\"><syl>Lo</syl></verse></note>"
+      "<note xml:id=\"n1b\" pname=\"d\" oct=\"5\" dur=\"2\">"
+      "<verse n=\"1\"><syl xml:id=\"s1b\" wordpos=\"i\" con=\"d\">rem</syl></verse></note>"
+      "</layer></staff></measure>"
+      "<measure xml:id=\"m2\" n=\"2\"><staff n=\"1\"><layer n=\"1\">"
+      "<note xml:id=\"n2a\" pname=\"e\" oct=\"5\" dur=\"1\"><verse n=\"1\"><syl wordpos=\"t\">ip</syl></verse></note>"
+      "</layer></staff></measure>"
+      "<measure xml:id=\"m3\" n=\"3\"><staff n=\"1\"><layer n=\"1\">"
+      "<note xml:id=\"n3a\" pname=\"f\" oct=\"5\" dur=\"1\"><verse n=\"1\"><syl>sum</syl></verse></note>"
+      "</layer></staff></measure>"
+      "<measure xml:id=\"m4\" n=\"4\" right=\"end\"><staff n=\"1\"><layer n=\"1\">"
+      "<note xml:id=\"n4a\" pname=\"g\" oct=\"5\" dur=\"1\"/>"
+      "</layer></staff></measure>"
+      "</section></score></mdiv></body></music></mei>";
+
+/**
+ * Render the second and the third measures and check that only they are drawn, with the connector of the word
+ * continuing from the first measure, and that the scoreDefs are not collected again.
+ */
+int TestRenderMeasures()
+{
+    Toolkit toolkit;
+    toolkit.SetProfile(true);
+    if (!toolkit.LoadData(lyricsData)) return 1;
+    toolkit.GetProfiler()->Reset();
+    std::string svg = toolkit.RenderMeasuresToSvg("m2", "m3");
+
+    int errors = 0;
+    const char *drawn[] = { "m2", "n2a", "m3", "n3a", "s1b" };
+    for (auto id : drawn) {
+        if (svg.find(std::string(" id=\"") + id + "\"") == std::string::npos) {
+            std::cerr << "The element '" << id << "' in the range was not drawn" << std::endl;
+            errors++;
+        }
+    }
+    const char *skipped[] = { "m1", "n1a", "n1b", "m4", "n4a" };
+    for (auto id : skipped) {
+        if (svg.find(std::string(" id=\"") + id + "\"") != std::string::npos) {
+            std::cerr << "The element '" << id << "' out of the range was drawn" << std::endl;
+            errors++;
+        }
+    }
+    if (svg.find("<rect", svg.find(" id=\"s1b\"")) > svg.find(" id=\"m2\"")) {
+        std::cerr << "The connector of the word crossing into the range was not drawn" << std::endl;
+        errors++;
+    }
+    if (toolkit.GetProfiler()->GetNodes("CollectScoreDefs") > 0) {
+        std::cerr << "The scoreDefs were collected again for rendering the measures" << std::endl;
+        errors++;
+    }
+    return errors;
+}
+
+//----------------------------------------------------------------------------
+// Main
+//----------------------------------------------------------------------------
+
+void display_usage()
+{
+    std::cerr << "Usage: verovio-toolkit-test [-r PATH] [--layout-cache=DIR] test [file]" << std::endl << std::endl;
+    std::cerr << "Run a test of the toolkit, with the file for the layout-breaks, redo-layout and snapshot ones."
+              << std::endl;
+    std::cerr << "The tests are:" << std::endl;
+    std::cerr << " edit-batch                 Check that a batch of editor actions failing is undone" << std::endl;
+    std::cerr << " excerpt                    Check the measure range and the staff selection of an excerpt"
+              << std::endl;
+    std::cerr << " layout-breaks              Redo the layout for several page widths and check the reuse"
+              << std::endl;
+    std::cerr << " redo-layout                Render a page, redo the layout and check the cast-off was reused"
+              << std::endl;
+    std::cerr << " render-measures            Render a range of measures and check the elements drawn" << std::endl;
+    std::cerr << " snapshot                   Corrupt the layout snapshot and check it is discarded (needs a cache)"
+              << std::endl
+              << std::endl;
+    std::cerr << " --layout-cache=DIR         Directory for the layout snapshots, emptied by the test" << std::endl;
+    std::cerr << " -r, --resources=PATH       Path to SVG resources (default is " << Resources::GetPath() << ")"
+              << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    std::string layoutCache;
+
+    static struct option long_options[] = { { "layout-cache", required_argument, 0, 0 },
+        { "resources", required_argument, 0, 'r' }, { 0, 0, 0, 0 } };
+
+    int c;
+    int option_index = 0;
+    while ((c = getopt_long(argc, argv, "r:", long_options, &option_index)) != -1) {
+        switch (c) {
+            case 0: layoutCache = optarg; break;
+            case 'r': Resources::SetPath(optarg); break;
+            default: display_usage(); return 1;
+        }
+    }
+
+    if ((optind >= argc) || (optind + 2 < argc)) {
+        display_usage();
+        return 1;
+    }
+
+    std::string test = argv[optind];
+    std::string file = (optind + 1 < argc) ? argv[optind + 1] : "";
+    if (file.empty() && (test != "edit-batch") && (test != "excerpt") && (test != "render-measures")) {
+        display_usage();
+        return 1;
+    }
+
+    // The warnings of the file would be repeated by each toolkit
+    DisableLog();
+
+    int errors = 0;
+    if (test == "edit-batch") {
+        errors = TestEditBatch();
+    }
+    else if (test == "excerpt") {
+        errors = TestExcerpt();
+    }
+    else if (test == "layout-breaks") {
+        errors = TestLayoutBreaks(file);
+    }
+    else if (test == "redo-layout") {
+        errors = TestRedoLayout(file);
+    }
+    else if (test == "render-measures") {
+        errors = TestRenderMeasures();
+    }
+    else if (test == "snapshot") {
+        if (layoutCache.empty()) {
+            display_usage();
+            return 1;
+        }
+        errors = TestSnapshot(file, layoutCache);
+    }
+    else {
+        std::cerr << "Unknown test '" << test << "'" << std::endl;
+        display_usage();
+        return 1;
+    }
+
+    std::cout << test << ": " << errors << " error(s)" << std::endl;
+    return (errors > 0) ? 1 : 0;
+}